@@ -0,0 +1,12 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792328751455057121');
+
+-- World snapshots compare the live checksums of the spawn source tables
+ALTER TABLE `creature` CHECKSUM=1;
+ALTER TABLE `creature_template` CHECKSUM=1;
+ALTER TABLE `creature_equip_template` CHECKSUM=1;
+ALTER TABLE `game_event_creature` CHECKSUM=1;
+ALTER TABLE `pool_creature` CHECKSUM=1;
+ALTER TABLE `gameobject` CHECKSUM=1;
+ALTER TABLE `gameobject_template` CHECKSUM=1;
+ALTER TABLE `game_event_gameobject` CHECKSUM=1;
+ALTER TABLE `pool_gameobject` CHECKSUM=1;
@@ -78,6 +78,31 @@ namespace acore
             }
         }
 
+        /* Keeps a random subset of the requested size, preserving the order of the kept elements */
+        template<class T>
+        void RandomResizeList(std::vector<T>& list, uint32 size)
+        {
+            if (list.size() <= size)
+                return;
+
+            auto keepItr = list.begin();
+            uint32 elementsToKeep = size;
+            uint32 elementsToProcess = list.size();
+            for (auto itr = list.begin(); itr != list.end(); ++itr, --elementsToProcess)
+            {
+                // this element has a chance of elementsToKeep / elementsToProcess to be kept
+                if (urand(1, elementsToProcess) <= elementsToKeep)
+                {
+                    if (keepItr != itr)
+                        *keepItr = std::move(*itr);
+                    ++keepItr;
+                    --elementsToKeep;
+                }
+            }
+
+            list.erase(keepItr, list.end());
+        }
+
         template<class T, class Predicate>
         void RandomResizeList(std::list<T>& list, Predicate& predicate, uint32 size)
         {
@@ -109,6 +134,36 @@ namespace acore
             return *it;
         }
 
+        /*
+         * Stable in-place insertion sort for random access containers.
+         * Runs in linear time when only a few elements are out of place,
+         * which makes it a cheap way to restore the order of a container that was sorted before.
+         */
+        template <class C, class Predicate>
+        void InsertionSort(C& container, Predicate pred)
+        {
+            auto const first = container.begin();
+            auto const last = container.end();
+            if (first == last)
+                return;
+
+            for (auto itr = std::next(first); itr != last; ++itr)
+            {
+                if (!pred(*itr, *std::prev(itr)))
+                    continue;
+
+                auto value = std::move(*itr);
+                auto hole = itr;
+                do
+                {
+                    *hole = std::move(*std::prev(hole));
+                    --hole;
+                } while (hole != first && pred(value, *std::prev(hole)));
+
+                *hole = std::move(value);
+            }
+        }
+
         template <typename Container, typename Predicate>
         std::enable_if_t<std::is_move_assignable_v<decltype(*std::declval<Container>().begin())>, void> EraseIf(Container& c, Predicate p)
         {
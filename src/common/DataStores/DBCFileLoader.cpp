@@ -7,70 +7,154 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
-DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-bool DBCFileLoader::Load(char const* filename, char const* fmt)
+namespace
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
+    constexpr uint32 DBC_HEADER_SIZE = 5 * sizeof(uint32);
+}
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
+DBCFileData::~DBCFileData()
+{
+    if (!_data)
+        return;
 
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
-        return false;
-    }
+    if (!_mapped)
+        delete[] _data;
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+    else
+        UnmapViewOfFile(_data);
+#else
+    else
+        munmap(_data, _size);
+#endif
+}
 
-    EndianConvert(header);
+std::unique_ptr<DBCFileData> DBCFileData::Open(char const* filename)
+{
+    std::unique_ptr<DBCFileData> file(new DBCFileData());
+
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+    HANDLE fileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return nullptr;
 
-    if (header != 0x43424457)                                //'WDBC'
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0)
     {
-        fclose(f);
-        return false;
+        // the view keeps the mapping alive, both handles can be closed right away
+        if (HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr))
+        {
+            file->_data = static_cast<unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0));
+            file->_size = size_t(fileSize.QuadPart);
+            file->_mapped = file->_data != nullptr;
+            CloseHandle(mappingHandle);
+        }
     }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
+    CloseHandle(fileHandle);
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
     {
-        fclose(f);
-        return false;
+        void* mapping = mmap(nullptr, size_t(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            file->_data = static_cast<unsigned char*>(mapping);
+            file->_size = size_t(fileStat.st_size);
+            file->_mapped = true;
+        }
     }
 
-    EndianConvert(recordCount);
+    close(fd);
+#endif
+
+    if (file->_mapped)
+        return file;
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
+    // mapping not possible (empty file, special file system...), fall back to reading it
+    FILE* f = fopen(filename, "rb");
+    if (!f)
+        return nullptr;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0)
     {
         fclose(f);
-        return false;
+        return nullptr;
     }
 
-    EndianConvert(fieldCount);
+    file->_size = size_t(size);
+    file->_data = new unsigned char[file->_size];
+    bool read = fread(file->_data, file->_size, 1, f) == 1;
+    fclose(f);
+
+    return read ? std::move(file) : nullptr;
+}
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
+void DBCFileData::Discard(size_t offset, size_t size)
+{
+#if AC_PLATFORM != AC_PLATFORM_WINDOWS
+    if (!_mapped || offset >= _size)
+        return;
+
+    size_t const pageSize = size_t(sysconf(_SC_PAGESIZE));
+    size_t begin = (offset + pageSize - 1) / pageSize * pageSize;
+    size_t end = std::min(offset + size, _size) / pageSize * pageSize;
+    if (begin < end)
+        madvise(_data + begin, end - begin, MADV_DONTNEED);
+#else
+    (void)offset;
+    (void)size;
+#endif
+}
+
+DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
+
+bool DBCFileLoader::Load(char const* filename, char const* fmt)
+{
+    file.reset();
+    data = nullptr;
+    stringTable = nullptr;
+
+    file = DBCFileData::Open(filename);
+    if (!file || file->GetSize() < DBC_HEADER_SIZE)
         return false;
-    }
 
-    EndianConvert(recordSize);
+    uint32 header[5];
+    memcpy(header, file->GetData(), DBC_HEADER_SIZE);
+    for (uint32& value : header)
+        EndianConvert(value);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
+    if (header[0] != 0x43424457)                             //'WDBC'
         return false;
-    }
 
-    EndianConvert(stringSize);
+    recordCount = header[1];                                 // Number of records
+    fieldCount = header[2];                                  // Number of fields
+    recordSize = header[3];                                  // Size of a record
+    stringSize = header[4];                                  // String size
 
+    if (file->GetSize() < DBC_HEADER_SIZE + size_t(recordSize) * recordCount + stringSize)
+        return false;
+
+    delete[] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
 
@@ -83,25 +167,46 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = file->GetData() + DBC_HEADER_SIZE;
     stringTable = data + recordSize * recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
+    return true;
+}
+
+DBCFileLoader::~DBCFileLoader()
+{
+    delete[] fieldsOffset;
+}
+
+bool DBCFileLoader::CanUseRecordsInPlace(char const* fmt) const
+{
+#if ACORE_ENDIAN == ACORE_BIGENDIAN
+    (void)fmt;
+    return false;
+#else
+    // only 4 byte fields that all end up in the structure, in file order and without padding
+    if (strlen(fmt) != fieldCount || recordSize != fieldCount * sizeof(uint32))
         return false;
-    }
 
-    fclose(f);
+    for (char const* field = fmt; *field; ++field)
+        if (*field != FT_IND && *field != FT_INT && *field != FT_FLOAT)
+            return false;
 
     return true;
+#endif
 }
 
-DBCFileLoader::~DBCFileLoader()
+void DBCFileLoader::DiscardRecords()
 {
-    delete[] data;
+    if (file && data)
+        file->Discard(data - file->GetData(), recordSize * recordCount);
+}
 
-    delete[] fieldsOffset;
+std::unique_ptr<DBCFileData> DBCFileLoader::ReleaseFile()
+{
+    data = nullptr;
+    stringTable = nullptr;
+    return std::move(file);
 }
 
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
@@ -199,6 +304,20 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    if (CanUseRecordsInPlace(format))
+    {
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = reinterpret_cast<char*>(data + y * recordSize);
+            if (i >= 0)
+                indexTable[getRecord(y).getUInt(i)] = record;
+            else
+                indexTable[y] = record;
+        }
+
+        return nullptr;
+    }
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
@@ -248,13 +367,14 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
+bool DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
-        return nullptr;
+        return false;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    // records used in place have no string field
+    if (!dataTable)
+        return true;
 
     uint32 offset = 0;
 
@@ -279,10 +399,7 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     // fill only not filled entries
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !** slot)
-                    {
-                        const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
-                    }
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     offset += sizeof(char*);
                     break;
                 }
@@ -300,5 +417,5 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return true;
 }
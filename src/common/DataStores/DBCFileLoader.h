@@ -10,6 +10,7 @@
 #include "Define.h"
 #include "Errors.h"
 #include "Utilities/ByteConverter.h"
+#include <memory>
 
 enum DbcFieldFormat
 {
@@ -24,6 +25,31 @@ enum DbcFieldFormat
     FT_LOGIC = 'l'                                           //Logical (boolean)
 };
 
+/// Contents of a .dbc file, mapped copy-on-write so records used in place can still be patched by the core
+class DBCFileData
+{
+public:
+    ~DBCFileData();
+
+    static std::unique_ptr<DBCFileData> Open(char const* filename);
+
+    [[nodiscard]] unsigned char* GetData() const { return _data; }
+    [[nodiscard]] size_t GetSize() const { return _size; }
+
+    /// Gives the pages of a range that will not be read anymore back to the system
+    void Discard(size_t offset, size_t size);
+
+private:
+    DBCFileData() = default;
+
+    unsigned char* _data = nullptr;
+    size_t _size = 0;
+    bool _mapped = false;
+
+    DBCFileData(DBCFileData const& right) = delete;
+    DBCFileData& operator=(DBCFileData const& right) = delete;
+};
+
 class DBCFileLoader
 {
 public:
@@ -81,8 +107,16 @@ public:
     [[nodiscard]] uint32 GetCols() const { return fieldCount; }
     [[nodiscard]] uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
     [[nodiscard]] bool IsLoaded() const { return data != nullptr; }
+    /// True when the format describes the file records field for field, they can then be used without any copy
+    [[nodiscard]] bool CanUseRecordsInPlace(char const* fmt) const;
+    /// Returns the transformed records, or nullptr when the index table points directly into the file
     char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
-    char* AutoProduceStrings(char const* fmt, char* dataTable);
+    /// Points the string fields to the string block of the file, which must then be kept with ReleaseFile
+    bool AutoProduceStrings(char const* fmt, char* dataTable);
+    /// Releases the pages holding the records, once they were copied by AutoProduceData
+    void DiscardRecords();
+    /// Hands over the file contents that the pointers produced above refer to
+    std::unique_ptr<DBCFileData> ReleaseFile();
     static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
 
 private:
@@ -91,6 +125,7 @@ private:
     uint32 fieldCount;
     uint32 stringSize;
     uint32* fieldsOffset;
+    std::unique_ptr<DBCFileData> file;
     unsigned char* data;
     unsigned char* stringTable;
 
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef AZEROTHCORE_SHAREDWORLDPACKET_H
+#define AZEROTHCORE_SHAREDWORLDPACKET_H
+
+#include "WorldPacket.h"
+#include <memory>
+
+/*
+ * A packet sent to many sessions (channel, guild, group, nearby players, world announcements).
+ * Sockets queue a reference to one immutable copy of the payload and only encrypt their own header,
+ * the header and the payload are sent in the same write. The copy is made on the first socket that
+ * needs it, so a broadcast reaching nobody costs nothing. Use it from one thread, like the WorldPacket it wraps.
+ */
+class SharedWorldPacket
+{
+public:
+    explicit SharedWorldPacket(WorldPacket const& packet) : _packet(&packet) { }
+
+    [[nodiscard]] WorldPacket const& GetPacket() const { return *_packet; }
+
+    [[nodiscard]] std::shared_ptr<WorldPacket const> const& GetPayload() const
+    {
+        if (!_payload)
+            _payload = std::make_shared<WorldPacket const>(*_packet);
+        return _payload;
+    }
+
+private:
+    WorldPacket const* _packet;
+    mutable std::shared_ptr<WorldPacket const> _payload;
+};
+
+#endif
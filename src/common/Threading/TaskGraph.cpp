@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace acore;
+
+void TaskGraph::AddTask(std::string const& name, std::vector<std::string> const& dependencies, Task task)
+{
+    ASSERT(FindTask(name) == _nodes.size(), "TaskGraph: task added twice");
+
+    Node node;
+    node.Name = name;
+    node.Function = std::move(task);
+
+    uint32 index = _nodes.size();
+    for (std::string const& dependency : dependencies)
+    {
+        uint32 dependencyIndex = FindTask(dependency);
+        ASSERT(dependencyIndex < index, "TaskGraph: dependency must be added before its dependents");
+        node.Dependencies.push_back(dependencyIndex);
+        _nodes[dependencyIndex].Dependents.push_back(index);
+    }
+
+    _nodes.push_back(std::move(node));
+}
+
+void TaskGraph::Run(uint32 threadCount)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point const runStart = Clock::now();
+    auto elapsed = [runStart]() { return uint32(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - runStart).count()); };
+
+    auto runNode = [&elapsed](Node& node)
+    {
+        node.StartTime = elapsed();
+        node.Function();
+        node.Duration = elapsed() - node.StartTime;
+    };
+
+    if (threadCount <= 1)
+    {
+        for (Node& node : _nodes)
+            runNode(node);
+
+        _totalTime = elapsed();
+        return;
+    }
+
+    std::mutex lock;
+    std::condition_variable condition;
+    std::set<uint32> ready;     // ordered, so earlier declared tasks start first
+    std::vector<uint32> pendingDependencies(_nodes.size());
+    uint32 finished = 0;
+
+    for (uint32 i = 0; i < _nodes.size(); ++i)
+    {
+        pendingDependencies[i] = _nodes[i].Dependencies.size();
+        if (!pendingDependencies[i])
+            ready.insert(i);
+    }
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            condition.wait(guard, [&]() { return !ready.empty() || finished == _nodes.size(); });
+            if (ready.empty())
+                return;
+
+            uint32 index = *ready.begin();
+            ready.erase(ready.begin());
+
+            guard.unlock();
+            runNode(_nodes[index]);
+            guard.lock();
+
+            ++finished;
+            for (uint32 dependent : _nodes[index].Dependents)
+                if (!--pendingDependencies[dependent])
+                    ready.insert(dependent);
+
+            condition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    _totalTime = elapsed();
+}
+
+uint32 TaskGraph::GetSerialTime() const
+{
+    uint32 total = 0;
+    for (Node const& node : _nodes)
+        total += node.Duration;
+    return total;
+}
+
+std::vector<TaskGraph::TaskTiming> TaskGraph::GetCriticalPath() const
+{
+    std::vector<TaskTiming> path;
+    if (_nodes.empty())
+        return path;
+
+    // insertion order is topological, so one forward pass finds the longest chain ending at each task
+    std::vector<uint32> chainTime(_nodes.size());
+    std::vector<uint32> previous(_nodes.size(), _nodes.size());
+    uint32 last = 0;
+    for (uint32 i = 0; i < _nodes.size(); ++i)
+    {
+        uint32 longestDependency = 0;
+        for (uint32 dependency : _nodes[i].Dependencies)
+        {
+            if (previous[i] == _nodes.size() || chainTime[dependency] > longestDependency)
+            {
+                longestDependency = chainTime[dependency];
+                previous[i] = dependency;
+            }
+        }
+
+        chainTime[i] = longestDependency + _nodes[i].Duration;
+        if (chainTime[i] > chainTime[last])
+            last = i;
+    }
+
+    for (uint32 i = last; i != _nodes.size(); i = previous[i])
+        path.push_back({ _nodes[i].Name, _nodes[i].StartTime, _nodes[i].Duration });
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+uint32 TaskGraph::FindTask(std::string const& name) const
+{
+    for (uint32 i = 0; i < _nodes.size(); ++i)
+        if (_nodes[i].Name == name)
+            return i;
+
+    return _nodes.size();
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include "Define.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace acore
+{
+    /*
+     * Runs a set of tasks, each one started as soon as all the tasks it depends on are finished.
+     * Dependencies must be added before their dependents, so the insertion order is always a valid
+     * execution order; with a single thread the tasks run exactly in that order.
+     */
+    class TaskGraph
+    {
+    public:
+        typedef std::function<void()> Task;
+
+        struct TaskTiming
+        {
+            std::string Name;
+            uint32 StartTime;   // ms since Run() began
+            uint32 Duration;    // ms
+        };
+
+        void AddTask(std::string const& name, std::vector<std::string> const& dependencies, Task task);
+
+        // Blocks until every task is done
+        void Run(uint32 threadCount);
+
+        uint32 GetTotalTime() const { return _totalTime; }
+        // Sum of all task durations, what a serial run would have cost
+        uint32 GetSerialTime() const;
+        // Longest chain of dependent tasks, the lower bound of the run time whatever the thread count
+        std::vector<TaskTiming> GetCriticalPath() const;
+
+    private:
+        struct Node
+        {
+            std::string Name;
+            Task Function;
+            std::vector<uint32> Dependencies;
+            std::vector<uint32> Dependents;
+            uint32 StartTime = 0;
+            uint32 Duration = 0;
+        };
+
+        uint32 FindTask(std::string const& name) const;
+
+        std::vector<Node> _nodes;
+        uint32 _totalTime = 0;
+    };
+}
+
+#endif
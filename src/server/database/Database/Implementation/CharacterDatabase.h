@@ -116,9 +116,12 @@ enum CharacterDatabaseStatements
     CHAR_DEL_INVALID_MAIL_ITEM,
     CHAR_SEL_EXPIRED_MAIL,
     CHAR_SEL_EXPIRED_MAIL_ITEMS,
+    CHAR_SEL_EXPIRED_MAIL_PAGE,
     CHAR_UPD_MAIL_RETURNED,
     CHAR_UPD_MAIL_ITEM_RECEIVER,
     CHAR_UPD_ITEM_OWNER,
+    CHAR_UPD_MAIL_ITEM_INSTANCE_OWNER,
+    CHAR_DEL_MAIL_ITEM_INSTANCE,
     CHAR_SEL_ITEM_REFUNDS,
     CHAR_SEL_ITEM_BOP_TRADE,
     CHAR_DEL_ITEM_BOP_TRADE,
@@ -159,10 +162,12 @@ enum CharacterDatabaseStatements
     CHAR_DEL_GUILD_BANK_RIGHTS,
     CHAR_DEL_GUILD_BANK_RIGHTS_FOR_RANK,
     CHAR_INS_GUILD_BANK_EVENTLOG,
-    CHAR_DEL_GUILD_BANK_EVENTLOG,
+    CHAR_DEL_GUILD_BANK_EVENTLOG_OLDER,
+    CHAR_SEL_GUILD_BANK_EVENTLOG,
     CHAR_DEL_GUILD_BANK_EVENTLOGS,
     CHAR_INS_GUILD_EVENTLOG,
-    CHAR_DEL_GUILD_EVENTLOG,
+    CHAR_DEL_GUILD_EVENTLOG_OLDER,
+    CHAR_SEL_GUILD_EVENTLOG,
     CHAR_DEL_GUILD_EVENTLOGS,
     CHAR_UPD_GUILD_MEMBER_PNOTE,
     CHAR_UPD_GUILD_MEMBER_OFFNOTE,
@@ -359,9 +364,12 @@ enum CharacterDatabaseStatements
     CHAR_SEL_GUILD_BANK_ITEM_BY_ENTRY,
     CHAR_DEL_CHAR_ACHIEVEMENT,
     CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS,
-    CHAR_INS_CHAR_ACHIEVEMENT,
     CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA,
-    CHAR_INS_CHAR_ACHIEVEMENT_PROGRESS,
+    CHAR_REP_CHAR_ACHIEVEMENT,
+    CHAR_REP_CHAR_ACHIEVEMENT_PROGRESS,
+    CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA_BATCH,
+    CHAR_REP_CHAR_ACHIEVEMENT_BATCH,
+    CHAR_REP_CHAR_ACHIEVEMENT_PROGRESS_BATCH,
     CHAR_DEL_CHAR_REPUTATION_BY_FACTION,
     CHAR_INS_CHAR_REPUTATION_BY_FACTION,
     CHAR_UPD_CHAR_ARENA_POINTS,
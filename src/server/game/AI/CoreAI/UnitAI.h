@@ -197,7 +197,8 @@ public:
         if (position >= threatlist.size())
             return nullptr;
 
-        std::list<Unit*> targetList;
+        std::vector<Unit*> targetList;
+        targetList.reserve(threatlist.size());
         for (ThreatContainer::StorageType::const_iterator itr = threatlist.begin(); itr != threatlist.end(); ++itr)
             if (predicate((*itr)->getTarget()))
                 targetList.push_back((*itr)->getTarget());
@@ -205,31 +206,22 @@ public:
         if (position >= targetList.size())
             return nullptr;
 
-        if (targetType == SELECT_TARGET_NEAREST || targetType == SELECT_TARGET_FARTHEST)
-            targetList.sort(acore::ObjectDistanceOrderPred(me));
-
         switch (targetType)
         {
             case SELECT_TARGET_NEAREST:
-            case SELECT_TARGET_TOPAGGRO:
-                {
-                    std::list<Unit*>::iterator itr = targetList.begin();
-                    std::advance(itr, position);
-                    return *itr;
-                }
             case SELECT_TARGET_FARTHEST:
+                // only the element at position has to be in place
+                if (targetType == SELECT_TARGET_NEAREST)
+                    std::nth_element(targetList.begin(), targetList.begin() + position, targetList.end(), acore::ObjectDistanceOrderPred(me));
+                else
+                    std::nth_element(targetList.begin(), targetList.begin() + position, targetList.end(), [this](Unit const* left, Unit const* right) { return me->GetDistanceOrder(right, left); });
+                return targetList[position];
+            case SELECT_TARGET_TOPAGGRO:
+                return targetList[position];
             case SELECT_TARGET_BOTTOMAGGRO:
-                {
-                    std::list<Unit*>::reverse_iterator ritr = targetList.rbegin();
-                    std::advance(ritr, position);
-                    return *ritr;
-                }
+                return targetList[targetList.size() - 1 - position];
             case SELECT_TARGET_RANDOM:
-                {
-                    std::list<Unit*>::iterator itr = targetList.begin();
-                    std::advance(itr, urand(position, targetList.size() - 1));
-                    return *itr;
-                }
+                return targetList[urand(position, targetList.size() - 1)];
             default:
                 break;
         }
@@ -247,23 +239,39 @@ public:
         if (threatlist.empty())
             return;
 
+        std::vector<Unit*> candidates(targetList.begin(), targetList.end());
+        candidates.reserve(candidates.size() + threatlist.size());
         for (ThreatContainer::StorageType::const_iterator itr = threatlist.begin(); itr != threatlist.end(); ++itr)
             if (predicate((*itr)->getTarget()))
-                targetList.push_back((*itr)->getTarget());
+                candidates.push_back((*itr)->getTarget());
 
-        if (targetList.size() < maxTargets)
+        if (candidates.size() < maxTargets)
+        {
+            targetList.assign(candidates.begin(), candidates.end());
             return;
+        }
 
-        if (targetType == SELECT_TARGET_NEAREST || targetType == SELECT_TARGET_FARTHEST)
-            targetList.sort(acore::ObjectDistanceOrderPred(me));
-
-        if (targetType == SELECT_TARGET_FARTHEST || targetType == SELECT_TARGET_BOTTOMAGGRO)
-            targetList.reverse();
+        switch (targetType)
+        {
+            case SELECT_TARGET_NEAREST:
+            case SELECT_TARGET_FARTHEST:
+                // only the selected targets need to be ordered
+                if (targetType == SELECT_TARGET_NEAREST)
+                    std::partial_sort(candidates.begin(), candidates.begin() + maxTargets, candidates.end(), acore::ObjectDistanceOrderPred(me));
+                else
+                    std::partial_sort(candidates.begin(), candidates.begin() + maxTargets, candidates.end(), [this](Unit const* left, Unit const* right) { return me->GetDistanceOrder(right, left); });
+                break;
+            case SELECT_TARGET_BOTTOMAGGRO:
+                std::reverse(candidates.begin(), candidates.end());
+                break;
+            case SELECT_TARGET_RANDOM:
+                acore::Containers::RandomResizeList(candidates, maxTargets);
+                break;
+            default:
+                break;
+        }
 
-        if (targetType == SELECT_TARGET_RANDOM)
-            acore::Containers::RandomResizeList(targetList, maxTargets);
-        else
-            targetList.resize(maxTargets);
+        targetList.assign(candidates.begin(), candidates.begin() + maxTargets);
     }
 
     // Called at any Damage to any victim (before damage apply)
@@ -14,7 +14,7 @@
 
 #define CAST_AI(a, b)   (dynamic_cast<a*>(b))
 
-typedef std::list<WorldObject*> ObjectList;
+typedef std::vector<WorldObject*> ObjectList;
 
 class InstanceScript;
 
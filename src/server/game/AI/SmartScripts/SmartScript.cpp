@@ -113,20 +113,24 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    SmartEventDispatchTable::Group const* group = mEventDispatch.GetGroup(e);
+    if (!group)
+        return;
+
+    // none of the events of this type can fire in the current phase
+    if (!group->CanFireInPhase(mEventPhase))
+        return;
+
+    uint16 const* events = mEventDispatch.GetEvents(*group);
+    for (uint32 i = 0; i < group->count; ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        SmartScriptHolder& holder = mEvents[events[i]];
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
-        {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent((*i).entryOrGuid, (*i).event_id, (*i).source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
+        ConditionList const& conds = sConditionMgr->GetConditionsForSmartEvent(holder.entryOrGuid, holder.event_id, holder.source_type);
+        ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
+        if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
     }
 }
 
@@ -181,7 +185,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
 
                 if (!talkTarget)
@@ -226,7 +230,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 #endif
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -247,7 +251,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -268,7 +272,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -296,7 +300,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 if (count == 0)
                 {
-                    delete targets;
+                    ReleaseTargetList(targets);
                     break;
                 }
 
@@ -313,7 +317,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_MUSIC:
@@ -325,7 +329,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (me && me->FindMap())
                     {
                         Map::PlayerList const& players = me->GetMap()->GetPlayers();
-                        targets = new ObjectList();
+                        targets = AcquireTargetList();
 
                         if (!players.isEmpty())
                         {
@@ -363,7 +367,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -376,7 +380,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (me && me->FindMap())
                     {
                         Map::PlayerList const& players = me->GetMap()->GetPlayers();
-                        targets = new ObjectList();
+                        targets = AcquireTargetList();
 
                         if (!players.isEmpty())
                         {
@@ -421,7 +425,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 if (count == 0)
                 {
-                    delete targets;
+                    ReleaseTargetList(targets);
                     break;
                 }
 
@@ -438,7 +442,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_FACTION:
@@ -475,7 +479,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -525,7 +529,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_FAIL_QUEST:
@@ -546,7 +550,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_OFFER_QUEST:
@@ -586,7 +590,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_REACT_STATE:
@@ -603,7 +607,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToCreature()->SetReactState(ReactStates(e.action.react.state));
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_RANDOM_EMOTE:
@@ -632,7 +636,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 if (count == 0)
                 {
-                    delete targets;
+                    ReleaseTargetList(targets);
                     break;
                 }
 
@@ -649,7 +653,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_THREAT_ALL_PCT:
@@ -692,7 +696,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CALL_AREAEXPLOREDOREVENTHAPPENS:
@@ -722,7 +726,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CAST:
@@ -782,7 +786,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_INVOKER_CAST:
@@ -812,7 +816,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ADD_AURA:
@@ -833,7 +837,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ACTIVATE_GOBJECT:
@@ -857,7 +861,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_RESET_GOBJECT:
@@ -878,7 +882,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_EMOTE_STATE:
@@ -899,7 +903,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_UNIT_FLAG:
@@ -927,7 +931,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_UNIT_FLAG:
@@ -955,7 +959,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_AUTO_ATTACK:
@@ -1029,7 +1033,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if ((*itr)->ToCreature()->IsAIEnabled)
                             (*itr)->ToCreature()->AI()->EnterEvadeMode();
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_FLEE_FOR_ASSIST:
@@ -1079,7 +1083,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVEAURASFROMSPELL:
@@ -1112,7 +1116,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 #endif
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_FOLLOW:
@@ -1141,7 +1145,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_RANDOM_PHASE:
@@ -1235,7 +1239,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 #endif
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -1287,7 +1291,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 LOG_DEBUG("sql.sql", "SmartScript::ProcessAction: SMART_ACTION_SET_INST_DATA64: Field: %u, data: %lu",
                                e.action.setInstanceData64.field, targets->front()->GetGUID());
 #endif
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_UPDATE_TEMPLATE:
@@ -1300,7 +1304,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToCreature()->UpdateEntry(e.action.updateTemplate.creature, nullptr, e.action.updateTemplate.updateLevel != 0);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_DIE:
@@ -1331,6 +1335,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                                 (*itr)->ToPlayer()->SetInCombatWith(me);
                                 me->AddThreat((*itr)->ToPlayer(), 0.0f);
                             }
+                    ReleaseTargetList(units);
                 }
                 else
                 {
@@ -1339,7 +1344,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             (*itr)->ToCreature()->SetInCombatWithZone();
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CALL_FOR_HELP:
@@ -1359,7 +1364,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_SHEATH:
@@ -1388,7 +1393,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToGameObject()->Delete();
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_INGAME_PHASE_MASK:
@@ -1405,7 +1410,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToGameObject()->SetPhaseMask(e.action.ingamePhaseMask.mask, true);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_MOUNT_TO_ENTRY_OR_MODEL:
@@ -1433,7 +1438,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToUnit()->Dismount();
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_INVINCIBILITY_HP_LEVEL:
@@ -1457,7 +1462,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_DATA:
@@ -1474,7 +1479,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToGameObject()->AI()->SetData(e.action.setData.field, e.action.setData.data);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_MOVE_FORWARD:
@@ -1505,7 +1510,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetVisible(!!e.action.visibility.state);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_ACTIVE:
@@ -1517,7 +1522,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                     (*itr)->setActive(!!e.action.setActive.state);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ATTACK_START:
@@ -1533,7 +1538,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (Unit* target = acore::Containers::SelectRandomContainerElement(*targets)->ToUnit())
                     me->AI()->AttackStart(target);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SUMMON_CREATURE:
@@ -1586,7 +1591,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
 
                 if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1627,7 +1632,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             (*itr)->SummonGameObject(e.action.summonGO.entry, GetBaseObject()->GetPositionX(), GetBaseObject()->GetPositionY(), GetBaseObject()->GetPositionZ(), GetBaseObject()->GetOrientation(), 0, 0, 0, 0, e.action.summonGO.despawnTime);
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
 
                 if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1650,7 +1655,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     Unit::Kill((*itr)->ToUnit(), (*itr)->ToUnit());
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_INSTALL_AI_TEMPLATE:
@@ -1672,7 +1677,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToPlayer()->AddItem(e.action.item.entry, e.action.item.count);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_ITEM:
@@ -1689,7 +1694,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToPlayer()->DestroyItemCount(e.action.item.entry, e.action.item.count, true);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_STORE_TARGET_LIST:
@@ -1712,7 +1717,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToUnit()->NearTeleportTo(e.target.x, e.target.y, e.target.z, e.target.o);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_FLY:
@@ -1746,7 +1751,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_SWIM:
@@ -1779,7 +1784,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 else
                     StoreCounter(e.action.setCounter.counterId, e.action.setCounter.value, e.action.setCounter.reset);
@@ -1810,7 +1815,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
                     if (!stored)
-                        delete targets;
+                        ReleaseTargetList(targets);
                 }
 
                 me->SetReactState((ReactStates)e.action.wpStart.reactState);
@@ -1885,7 +1890,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             me->SetInFront(*targets->begin());
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
 
                 break;
@@ -1904,7 +1909,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToPlayer()->SendMovieStart(e.action.movie.entry);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_MOVE_TO_POS:
@@ -1948,7 +1953,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     {
                         // xinef: we want to move to random element
                         target = acore::Containers::SelectRandomContainerElement(*targets);
-                        delete targets;
+                        ReleaseTargetList(targets);
                     }
                 }
 
@@ -1986,7 +1991,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_RESPAWN_TARGET:
@@ -2009,7 +2014,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CLOSE_GOSSIP:
@@ -2022,7 +2027,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsPlayer(*itr))
                         (*itr)->ToPlayer()->PlayerTalkClass->SendCloseGossip();
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_EQUIP:
@@ -2065,7 +2070,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CREATE_TIMED_EVENT:
@@ -2137,7 +2142,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_RESET_SCRIPT_BASE_OBJECT:
@@ -2163,7 +2168,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                                 if (CAST_AI(SmartAI, target->AI())->CanCombatMove())
                                     target->GetMotionMaster()->MoveChase(target->GetVictim(), attackDistance, attackAngle);
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -2191,7 +2196,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -2205,7 +2210,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToUnit()->SetUInt32Value(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ADD_NPC_FLAG:
@@ -2218,7 +2223,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToUnit()->SetFlag(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_NPC_FLAG:
@@ -2231,7 +2236,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToUnit()->RemoveFlag(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CROSS_CAST:
@@ -2243,7 +2248,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 ObjectList* targets = GetTargets(e, unit);
                 if (!targets)
                 {
-                    delete casters; // casters already validated, delete now
+                    ReleaseTargetList(casters); // casters already validated, delete now
                     break;
                 }
 
@@ -2275,8 +2280,8 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
-                delete casters;
+                ReleaseTargetList(targets);
+                ReleaseTargetList(casters);
                 break;
             }
         case SMART_ACTION_CALL_RANDOM_TIMED_ACTIONLIST:
@@ -2326,7 +2331,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -2356,7 +2361,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -2370,7 +2375,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsPlayer(*itr))
                         (*itr)->ToPlayer()->ActivateTaxiPathTo(e.action.taxi.id);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_RANDOM_MOVE:
@@ -2402,7 +2407,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         me->GetMotionMaster()->MoveIdle();
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_UNIT_FIELD_BYTES_1:
@@ -2414,7 +2419,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetByteFlag(UNIT_FIELD_BYTES_1, e.action.setunitByte.type, e.action.setunitByte.byte1);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_UNIT_FIELD_BYTES_1:
@@ -2427,7 +2432,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->RemoveByteFlag(UNIT_FIELD_BYTES_1, e.action.delunitByte.type, e.action.delunitByte.byte1);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_INTERRUPT_SPELL:
@@ -2440,7 +2445,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->InterruptNonMeleeSpells(e.action.interruptSpellCasting.withDelayed, e.action.interruptSpellCasting.spell_id, e.action.interruptSpellCasting.withInstant);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SEND_GO_CUSTOM_ANIM:
@@ -2453,7 +2458,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsGameObject(*itr))
                         (*itr)->ToGameObject()->SendCustomAnim(e.action.sendGoCustomAnim.anim);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_DYNAMIC_FLAG:
@@ -2466,7 +2471,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetUInt32Value(UNIT_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ADD_DYNAMIC_FLAG:
@@ -2479,7 +2484,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetFlag(UNIT_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_DYNAMIC_FLAG:
@@ -2492,7 +2497,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->RemoveFlag(UNIT_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_JUMP_TO_POS:
@@ -2532,7 +2537,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_GO_SET_LOOT_STATE:
@@ -2545,7 +2550,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsGameObject(*itr))
                         (*itr)->ToGameObject()->SetLootState((LootState)e.action.setGoLootState.state);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SEND_TARGET_TO_TARGET:
@@ -2557,7 +2562,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 ObjectList* storedTargets = GetTargetList(e.action.sendTargetToTarget.id);
                 if (!storedTargets)
                 {
-                    delete targets;
+                    ReleaseTargetList(targets);
                     break;
                 }
 
@@ -2579,7 +2584,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SEND_GOSSIP_MENU:
@@ -2606,7 +2611,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         SendGossipMenuFor(player, e.action.sendGossipMenu.gossipNpcTextId, GetBaseObject()->GetGUID());
                     }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_HOME_POS:
@@ -2626,7 +2631,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             else
                                 (*itr)->ToCreature()->SetHomePosition((*itr)->GetPositionX(), (*itr)->GetPositionY(), (*itr)->GetPositionZ(), (*itr)->GetOrientation());
                         }
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 else if (me && e.GetTargetType() == SMART_TARGET_POSITION)
                 {
@@ -2659,7 +2664,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         if (IsCreature(*itr))
         (*itr)->ToCreature()->SetHomePosition(target->GetPositionX(), target->GetPositionY(), target->GetPositionZ(), target->GetOrientation());
 
-        delete targets;
+        ReleaseTargetList(targets);
         }
 
         delete movers;
@@ -2675,7 +2680,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToCreature()->SetRegeneratingHealth(e.action.setHealthRegen.regenHealth);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_ROOT:
@@ -2688,7 +2693,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToCreature()->SetControlled(e.action.setRoot.root, UNIT_STATE_ROOT);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_GO_FLAG:
@@ -2701,7 +2706,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsGameObject(*itr))
                         (*itr)->ToGameObject()->SetUInt32Value(GAMEOBJECT_FLAGS, e.action.goFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ADD_GO_FLAG:
@@ -2714,7 +2719,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsGameObject(*itr))
                         (*itr)->ToGameObject()->SetFlag(GAMEOBJECT_FLAGS, e.action.goFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_GO_FLAG:
@@ -2727,7 +2732,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsGameObject(*itr))
                         (*itr)->ToGameObject()->RemoveFlag(GAMEOBJECT_FLAGS, e.action.goFlag.flag);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SUMMON_CREATURE_GROUP:
@@ -2754,7 +2759,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if (IsUnit(*itr))
                             (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), e.action.power.newPower);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ADD_POWER:
@@ -2766,7 +2771,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if (IsUnit(*itr))
                             (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) + e.action.power.newPower);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_POWER:
@@ -2778,7 +2783,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if (IsUnit(*itr))
                             (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) - e.action.power.newPower);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_GAME_EVENT_STOP:
@@ -2857,7 +2862,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
 
-                    delete targets;
+                    ReleaseTargetList(targets);
                 }
                 break;
             }
@@ -2871,7 +2876,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsGameObject(*itr))
                         (*itr)->ToGameObject()->SetGoState((GOState)e.action.goState.state);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_EXIT_VEHICLE:
@@ -2884,7 +2889,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->ExitVehicle();
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_UNIT_MOVEMENT_FLAGS:
@@ -2900,7 +2905,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToUnit()->SendMovementFlagUpdate();
                     }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_COMBAT_DISTANCE:
@@ -2913,7 +2918,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToCreature()->m_CombatDistance = e.action.combatDistance.dist;
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_CASTER_COMBAT_DIST:
@@ -2937,7 +2942,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToCreature()->m_SightDistance = e.action.sightDistance.dist;
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_FLEE:
@@ -2950,7 +2955,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToCreature()->GetMotionMaster()->MoveFleeing(me, e.action.flee.withEmote);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ADD_THREAT:
@@ -2963,7 +2968,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         me->AddThreat((*itr)->ToUnit(), (float)e.action.threatPCT.threatINC - (float)e.action.threatPCT.threatDEC);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_LOAD_EQUIPMENT:
@@ -2976,7 +2981,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsCreature(*itr))
                         (*itr)->ToCreature()->LoadEquipment(e.action.loadEquipment.id, e.action.loadEquipment.force);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_TRIGGER_RANDOM_TIMED_EVENT:
@@ -2995,7 +3000,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetHover(e.action.setHover.state);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ADD_IMMUNITY:
@@ -3008,7 +3013,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->ApplySpellImmune(e.action.immunity.id, e.action.immunity.type, e.action.immunity.value, true);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_REMOVE_IMMUNITY:
@@ -3021,7 +3026,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->ApplySpellImmune(e.action.immunity.id, e.action.immunity.type, e.action.immunity.value, false);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_FALL:
@@ -3034,7 +3039,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->GetMotionMaster()->MoveFall();
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_SET_EVENT_FLAG_RESET:
@@ -3052,7 +3057,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->RemoveAllGameObjects();
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_STOP_MOTION:
@@ -3070,7 +3075,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             (*itr)->ToUnit()->GetMotionMaster()->MovementExpired();
                     }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_NO_ENVIRONMENT_UPDATE:
@@ -3083,7 +3088,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->AddUnitState(UNIT_STATE_NO_ENVIRONMENT_UPD);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_ZONE_UNDER_ATTACK:
@@ -3100,7 +3105,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             break;
                         }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_LOAD_GRID:
@@ -3119,7 +3124,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if (IsPlayer(*itr))
                             !e.action.playerTalk.flag ? (*itr)->ToPlayer()->Say(text, LANG_UNIVERSAL) : (*itr)->ToPlayer()->Yell(text, LANG_UNIVERSAL);
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CUSTOM_CAST:
@@ -3169,7 +3174,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
                 }
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_VORTEX_SUMMON:
@@ -3215,7 +3220,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     } while (summonRadius <= r_max);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         case SMART_ACTION_CONE_SUMMON:
@@ -3245,7 +3250,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     else if (ObjectList* targets = GetTargets(e, unit))
                     {
                         currentAngle += (me->GetAngle(targets->front()) - me->GetOrientation());
-                        delete targets;
+                        ReleaseTargetList(targets);
                     }
 
                     for (uint32 index = 0; index < count; ++index)
@@ -3278,7 +3283,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         default:
@@ -3299,7 +3304,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     // xinef: extended by selfs victim
-    ConditionList const conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
+    ConditionList const& conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
     ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
     if (sConditionMgr->IsObjectMeetToConditions(info, conds))
@@ -3432,7 +3437,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
     WorldObject* baseObject = GetBaseObject();
 
-    ObjectList* l = new ObjectList();
+    ObjectList* l = AcquireTargetList();
     switch (e.GetTargetType())
     {
         case SMART_TARGET_SELF:
@@ -3551,7 +3556,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                         l->push_back(*itr);
                 }
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_CREATURE_DISTANCE:
@@ -3579,7 +3584,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                         l->push_back(*itr);
                 }
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
@@ -3598,7 +3603,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                         l->push_back(*itr);
                 }
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_GAMEOBJECT_RANGE:
@@ -3617,7 +3622,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                         l->push_back(*itr);
                 }
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_CREATURE_GUID:
@@ -3686,7 +3691,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                         acore::Containers::RandomResizeList(*l, e.target.playerRange.maxCount);
                 }
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_PLAYER_DISTANCE:
@@ -3697,7 +3702,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     if (IsPlayer(*itr))
                         l->push_back(*itr);
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_STORED:
@@ -3805,7 +3810,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                 if (e.target.o > 0)
                     acore::Containers::RandomResizeList(*l, e.target.o);
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_ROLE_SELECTION:
@@ -3847,7 +3852,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                 if (e.target.roleSelection.resize > 0)
                     acore::Containers::RandomResizeList(*l, e.target.roleSelection.resize);
 
-                delete units;
+                ReleaseTargetList(units);
                 break;
             }
         case SMART_TARGET_VEHICLE_PASSENGER:
@@ -3869,21 +3874,78 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
     if (l->empty())
     {
-        delete l;
+        ReleaseTargetList(l);
         l = nullptr;
     }
 
     return l;
 }
 
+namespace
+{
+    // Maps are updated by one thread at a time, so a per thread pool works as the scratch arena
+    // of whatever map is currently running its scripts
+    class SmartTargetListPool
+    {
+    public:
+        ~SmartTargetListPool()
+        {
+            for (ObjectList* targets : _freeLists)
+                delete targets;
+        }
+
+        ObjectList* Acquire()
+        {
+            if (_freeLists.empty())
+                return new ObjectList();
+
+            ObjectList* targets = _freeLists.back();
+            _freeLists.pop_back();
+            return targets;
+        }
+
+        void Release(ObjectList* targets)
+        {
+            // don't hoard the storage of the odd huge area search
+            if (_freeLists.size() >= SMART_TARGET_LIST_POOL_SIZE || targets->capacity() > SMART_TARGET_LIST_MAX_CAPACITY)
+            {
+                delete targets;
+                return;
+            }
+
+            targets->clear();
+            _freeLists.push_back(targets);
+        }
+
+    private:
+        static constexpr size_t SMART_TARGET_LIST_POOL_SIZE = 32;
+        static constexpr size_t SMART_TARGET_LIST_MAX_CAPACITY = 512;
+
+        std::vector<ObjectList*> _freeLists;
+    };
+
+    thread_local SmartTargetListPool targetListPool;
+}
+
+ObjectList* SmartScript::AcquireTargetList()
+{
+    return targetListPool.Acquire();
+}
+
+void SmartScript::ReleaseTargetList(ObjectList* targets)
+{
+    if (targets)
+        targetListPool.Release(targets);
+}
+
 ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
 {
-    ObjectList* targets = new ObjectList();
+    ObjectList* targets = AcquireTargetList();
     WorldObject* obj = GetBaseObject();
     if (obj)
     {
         acore::AllWorldObjectsInRange u_check(obj, dist);
-        acore::WorldObjectListSearcher<acore::AllWorldObjectsInRange> searcher(obj, *targets, u_check);
+        acore::WorldObjectListSearcher<acore::AllWorldObjectsInRange, ObjectList> searcher(obj, *targets, u_check);
         obj->VisitNearbyObject(dist, searcher);
     }
     return targets;
@@ -4368,7 +4430,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                     }
                 }
 
-                delete _targets;
+                ReleaseTargetList(_targets);
 
                 if (!target)
                     return;
@@ -4450,11 +4512,12 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 ObjectList* units = GetWorldObjectsInDist(range);
                 if (!units->empty())
                 {
-                    units->remove_if([](WorldObject * unit) { return unit->GetTypeId() != TYPEID_PLAYER; });
+                    units->erase(std::remove_if(units->begin(), units->end(), [](WorldObject * unit) { return unit->GetTypeId() != TYPEID_PLAYER; }), units->end());
 
                     if (units->size() >= e.event.nearPlayer.minCount)
                         ProcessAction(e, unit);
                 }
+                ReleaseTargetList(units);
                 RecalcTimer(e, e.event.nearPlayer.checkTimer, e.event.nearPlayer.checkTimer);
                 break;
             }
@@ -4464,11 +4527,12 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 ObjectList* units = GetWorldObjectsInDist(range);
                 if (!units->empty())
                 {
-                    units->remove_if([](WorldObject * unit) { return unit->GetTypeId() != TYPEID_PLAYER; });
+                    units->erase(std::remove_if(units->begin(), units->end(), [](WorldObject * unit) { return unit->GetTypeId() != TYPEID_PLAYER; }), units->end());
 
                     if (units->size() < e.event.nearPlayerNegation.minCount)
                         ProcessAction(e, unit);
                 }
+                ReleaseTargetList(units);
                 RecalcTimer(e, e.event.nearPlayerNegation.checkTimer, e.event.nearPlayerNegation.checkTimer);
                 break;
             }
@@ -4601,6 +4665,38 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        mEventDispatch.Compile(mEvents);
+    }
+}
+
+void SmartEventDispatchTable::Compile(SmartAIEventList const& events)
+{
+    _groups.clear();
+    _update.clear();
+
+    for (uint32 i = 0; i < events.size(); ++i)
+        if (events[i].GetEventType() != SMART_EVENT_LINK)
+            _update.push_back(uint16(i));
+
+    // group by type, events of the same type keep their script order
+    _byType = _update;
+    std::stable_sort(_byType.begin(), _byType.end(), [&events](uint16 left, uint16 right)
+    {
+        return events[left].GetEventType() < events[right].GetEventType();
+    });
+
+    for (uint32 i = 0; i < _byType.size(); ++i)
+    {
+        SmartScriptHolder const& e = events[_byType[i]];
+        if (_groups.empty() || _groups.back().type != e.GetEventType())
+            _groups.push_back({ uint8(e.GetEventType()), false, 0, uint16(i), 0 });
+
+        Group& group = _groups.back();
+        ++group.count;
+        if (e.event.event_phase_mask)
+            group.phaseMask |= e.event.event_phase_mask;
+        else
+            group.anyPhase = true;
     }
 }
 
@@ -4611,8 +4707,8 @@ void SmartScript::OnUpdate(uint32 const diff)
 
     InstallEvents();//before UpdateTimers
 
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        UpdateTimer(*i, diff);
+    for (uint16 index : mEventDispatch.GetUpdateEvents())
+        UpdateTimer(mEvents[index], diff);
 
     if (!mStoredEvents.empty())
     {
@@ -4725,6 +4821,8 @@ void SmartScript::GetScript()
         e = sSmartScriptMgr->GetScript((int32)trigger->entry, mScriptType);
         FillScript(e, nullptr, trigger);
     }
+
+    mEventDispatch.Compile(mEvents);
 }
 
 void SmartScript::OnInitialize(WorldObject* obj, AreaTrigger const* at)
@@ -15,6 +15,51 @@
 #include "Spell.h"
 #include "Unit.h"
 
+// Events of one script grouped by type, with the union of their phase masks, so that a hook
+// for a type without events, or whose events are all in other phases, returns at once
+class SmartEventDispatchTable
+{
+public:
+    struct Group
+    {
+        uint8 type;
+        bool anyPhase;      // at least one event has no phase mask
+        uint16 phaseMask;
+        uint16 begin;
+        uint16 count;
+
+        bool CanFireInPhase(uint32 eventPhase) const { return anyPhase || IsInPhase(eventPhase, phaseMask); }
+    };
+
+    // Links are left out, they are only reached through their parent event
+    void Compile(SmartAIEventList const& events);
+
+    Group const* GetGroup(SMART_EVENT e) const
+    {
+        for (Group const& group : _groups)
+            if (group.type == e)
+                return &group;
+        return nullptr;
+    }
+
+    // event indexes of the group, in script order
+    uint16 const* GetEvents(Group const& group) const { return _byType.data() + group.begin; }
+    // event indexes in script order
+    std::vector<uint16> const& GetUpdateEvents() const { return _update; }
+
+    static bool IsInPhase(uint32 eventPhase, uint32 phaseMask)
+    {
+        if (eventPhase == 0)
+            return false;
+        return (1 << (eventPhase - 1)) & phaseMask;
+    }
+
+private:
+    std::vector<Group> _groups;
+    std::vector<uint16> _byType;
+    std::vector<uint16> _update;
+};
+
 class SmartScript
 {
 public:
@@ -35,6 +80,9 @@ public:
     void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = nullptr, GameObject* gob = nullptr);
     ObjectList* GetTargets(SmartScriptHolder const& e, Unit* invoker = nullptr);
     ObjectList* GetWorldObjectsInDist(float dist);
+    // Target lists are recycled through a scratch pool, hand them back instead of deleting them
+    static ObjectList* AcquireTargetList();
+    static void ReleaseTargetList(ObjectList* targets);
     void InstallTemplate(SmartScriptHolder const& e);
     SmartScriptHolder CreateSmartEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask);
     void AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask);
@@ -249,15 +297,11 @@ private:
         else
             mEventPhase -= p;
     }
-    bool IsInPhase(uint32 p) const
-    {
-        if (mEventPhase == 0)
-            return false;
-        return (1 << (mEventPhase - 1)) & p;
-    }
+    bool IsInPhase(uint32 p) const { return SmartEventDispatchTable::IsInPhase(mEventPhase, p); }
     void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
     SmartAIEventList mEvents;
+    SmartEventDispatchTable mEventDispatch;     // rebuilt whenever mEvents changes
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
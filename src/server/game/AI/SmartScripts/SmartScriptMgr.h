@@ -1704,7 +1704,7 @@ public:
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
 
-typedef std::list<WorldObject*> ObjectList;
+typedef std::vector<WorldObject*> ObjectList;
 typedef std::list<uint64> GuidList;
 
 class ObjectGuidList
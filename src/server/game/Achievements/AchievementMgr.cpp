@@ -13,6 +13,7 @@
 #include "CellImpl.h"
 #include "Chat.h"
 #include "Common.h"
+#include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DBCEnums.h"
 #include "DisableMgr.h"
@@ -32,6 +33,8 @@
 #include "World.h"
 #include "WorldPacket.h"
 
+AchievementSaveCounters achievementSaveCounters;
+
 namespace acore
 {
     class AchievementChatBuilder
@@ -462,6 +465,8 @@ bool AchievementCriteriaDataSet::Meets(Player const* source, Unit const* target,
 AchievementMgr::AchievementMgr(Player* player)
 {
     m_player = player;
+    m_activeCriteriaLoaded = false;
+    m_criteriaUpdateDepth = 0;
 }
 
 AchievementMgr::~AchievementMgr()
@@ -486,7 +491,10 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_changedAchievements.Clear();
+    m_changedCriteria.Clear();
     DeleteFromDB(m_player->GetGUIDLow());
+    LoadActiveCriteria();
 
     // re-fill data
     CheckAllAchievementCriteria();
@@ -534,60 +542,121 @@ void AchievementMgr::DeleteFromDB(uint32 lowguid)
     CharacterDatabase.CommitTransaction(trans);
 }
 
+/**
+ * only the achievements and criteria recorded in the journals since the last save are written,
+ * ACHIEVEMENT_SAVE_BATCH_SIZE rows per statement and the remainder one row per statement
+ */
 void AchievementMgr::SaveToDB(SQLTransaction& trans)
 {
-    if (!m_completedAchievements.empty())
-    {
-        for (CompletedAchievementMap::iterator iter = m_completedAchievements.begin(); iter != m_completedAchievements.end(); ++iter)
-        {
-            if (!iter->second.changed)
-                continue;
-
-            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACHIEVEMENT_BY_ACHIEVEMENT);
-            stmt->setUInt16(0, iter->first);
-            stmt->setUInt32(1, GetPlayer()->GetGUID());
-            trans->Append(stmt);
+    uint32 const lowGuid = GetPlayer()->GetGUIDLow();
+    uint32 statements = 0;
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_ACHIEVEMENT);
-            stmt->setUInt32(0, GetPlayer()->GetGUID());
-            stmt->setUInt16(1, iter->first);
-            stmt->setUInt32(2, uint32(iter->second.date));
-            trans->Append(stmt);
+    std::vector<uint32> achievements;
+    for (uint32 achievementId : m_changedAchievements.Take())
+    {
+        CompletedAchievementMap::iterator iter = m_completedAchievements.find(achievementId);
+        if (iter == m_completedAchievements.end() || !iter->second.changed)
+            continue;
 
-            iter->second.changed = false;
+        achievements.push_back(achievementId);
+        iter->second.changed = false;
 
-            sScriptMgr->OnAchievementSave(trans, GetPlayer(), iter->first, iter->second);
-        }
+        sScriptMgr->OnAchievementSave(trans, GetPlayer(), iter->first, iter->second);
     }
 
-    if (!m_criteriaProgress.empty())
+    AchievementSaveJournal::ForEachStatement(achievements, [&](uint32 const* ids)
     {
-        for (CriteriaProgressMap::iterator iter = m_criteriaProgress.begin(); iter != m_criteriaProgress.end(); ++iter)
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_ACHIEVEMENT_BATCH);
+        for (uint8 i = 0; i < ACHIEVEMENT_SAVE_BATCH_SIZE; ++i)
         {
-            if (!iter->second.changed)
-                continue;
+            stmt->setUInt32(i * 3, lowGuid);
+            stmt->setUInt16(i * 3 + 1, ids[i]);
+            stmt->setUInt32(i * 3 + 2, uint32(m_completedAchievements[ids[i]].date));
+        }
+        trans->Append(stmt);
+        ++statements;
+    }, [&](uint32 id)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_ACHIEVEMENT);
+        stmt->setUInt32(0, lowGuid);
+        stmt->setUInt16(1, id);
+        stmt->setUInt32(2, uint32(m_completedAchievements[id].date));
+        trans->Append(stmt);
+        ++statements;
+    });
+
+    // the same criteria is journaled again when its progress is removed after a change
+    std::vector<uint32> criteriaToSave, criteriaToDelete;
+    for (uint32 criteriaId : m_changedCriteria.Take())
+    {
+        CriteriaProgressMap::iterator iter = m_criteriaProgress.find(criteriaId);
 
-            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA);
-            stmt->setUInt32(0, GetPlayer()->GetGUID());
-            stmt->setUInt16(1, iter->first);
-            trans->Append(stmt);
+        // pussywizard: insert only for (counter != 0) is very important! this is how criteria of completed achievements gets deleted from db (by setting counter to 0); if conflicted during merge - contact me
+        if (iter == m_criteriaProgress.end() || !iter->second.counter)
+            criteriaToDelete.push_back(criteriaId);
+        else
+            criteriaToSave.push_back(criteriaId);
 
-            // pussywizard: insert only for (counter != 0) is very important! this is how criteria of completed achievements gets deleted from db (by setting counter to 0); if conflicted during merge - contact me
-            if (iter->second.counter)
-            {
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_ACHIEVEMENT_PROGRESS);
-                stmt->setUInt32(0, GetPlayer()->GetGUID());
-                stmt->setUInt16(1, iter->first);
-                stmt->setUInt32(2, iter->second.counter);
-                stmt->setUInt32(3, uint32(iter->second.date));
-                trans->Append(stmt);
-            }
+        if (iter == m_criteriaProgress.end())
+            continue;
 
-            iter->second.changed = false;
+        iter->second.changed = false;
 
-            sScriptMgr->OnCriteriaSave(trans, GetPlayer(), iter->first, iter->second);
-        }
+        sScriptMgr->OnCriteriaSave(trans, GetPlayer(), iter->first, iter->second);
     }
+
+    AchievementSaveJournal::ForEachStatement(criteriaToSave, [&](uint32 const* ids)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_ACHIEVEMENT_PROGRESS_BATCH);
+        for (uint8 i = 0; i < ACHIEVEMENT_SAVE_BATCH_SIZE; ++i)
+        {
+            CriteriaProgress const& progress = m_criteriaProgress[ids[i]];
+            stmt->setUInt32(i * 4, lowGuid);
+            stmt->setUInt16(i * 4 + 1, ids[i]);
+            stmt->setUInt32(i * 4 + 2, progress.counter);
+            stmt->setUInt32(i * 4 + 3, uint32(progress.date));
+        }
+        trans->Append(stmt);
+        ++statements;
+    }, [&](uint32 id)
+    {
+        CriteriaProgress const& progress = m_criteriaProgress[id];
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_ACHIEVEMENT_PROGRESS);
+        stmt->setUInt32(0, lowGuid);
+        stmt->setUInt16(1, id);
+        stmt->setUInt32(2, progress.counter);
+        stmt->setUInt32(3, uint32(progress.date));
+        trans->Append(stmt);
+        ++statements;
+    });
+
+    AchievementSaveJournal::ForEachStatement(criteriaToDelete, [&](uint32 const* ids)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA_BATCH);
+        stmt->setUInt32(0, lowGuid);
+        for (uint8 i = 0; i < ACHIEVEMENT_SAVE_BATCH_SIZE; ++i)
+            stmt->setUInt16(i + 1, ids[i]);
+        trans->Append(stmt);
+        ++statements;
+    }, [&](uint32 id)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA);
+        stmt->setUInt32(0, lowGuid);
+        stmt->setUInt16(1, id);
+        trans->Append(stmt);
+        ++statements;
+    });
+
+    uint32 rows = achievements.size() + criteriaToSave.size() + criteriaToDelete.size();
+    if (!rows)
+        return;
+
+    ++achievementSaveCounters.Flushes;
+    achievementSaveCounters.Rows += rows;
+    achievementSaveCounters.Statements += statements;
+
+    LOG_DEBUG("achievement", "AchievementMgr::SaveToDB: player %u saved %u achievement rows, %u criteria rows and deleted %u criteria rows in %u statements",
+              lowGuid, uint32(achievements.size()), uint32(criteriaToSave.size()), uint32(criteriaToDelete.size()), statements);
 }
 
 void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQueryResult criteriaResult)
@@ -650,6 +719,8 @@ void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQ
             progress.changed = false;
         } while (criteriaResult->NextRow());
     }
+
+    LoadActiveCriteria();
 }
 
 void AchievementMgr::SendAchievementEarned(AchievementEntry const* achievement) const
@@ -753,26 +824,10 @@ static const uint32 achievIdForDungeon[][4] =
 };
 
 /**
- * this function will be called whenever the user might have done a criteria relevant action
+ * criteria of these types are indexed by AchievementGlobalMgr by the value they are updated with (creature entry, spell id, ...)
  */
-void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, uint32 miscValue1 /*= 0*/, uint32 miscValue2 /*= 0*/, Unit* unit /*= nullptr*/)
+static bool IsCriteriaTypeLookedUpByMiscValue(AchievementCriteriaTypes type)
 {
-    // disable for gamemasters with GM-mode enabled
-    if (m_player->IsGameMaster())
-        return;
-
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    if (type >= ACHIEVEMENT_CRITERIA_TYPE_TOTAL)
-    {
-        LOG_DEBUG("achievement", "UpdateAchievementCriteria: Wrong criteria type %u", type);
-        return;
-    }
-
-    LOG_DEBUG("achievement", "AchievementMgr::UpdateAchievementCriteria(%u, %u, %u)", type, miscValue1, miscValue2);
-#endif
-
-    AchievementCriteriaEntryList const* achievementCriteriaList = nullptr;
-
     switch (type)
     {
         case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
@@ -805,34 +860,68 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
         case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
         case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
         case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
-            if (miscValue1)
-            {
-                achievementCriteriaList = sAchievementMgr->GetSpecialAchievementCriteriaByType(type, miscValue1);
-                break;
-            }
-            achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
-            break;
         case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
-            if (miscValue2)
-            {
-                achievementCriteriaList = sAchievementMgr->GetSpecialAchievementCriteriaByType(type, miscValue2);
-                break;
-            }
-            achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
-            break;
+            return true;
         default:
-            achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
-            break;
+            return false;
     }
+}
 
-    if (!achievementCriteriaList)
+/**
+ * this function will be called whenever the user might have done a criteria relevant action
+ */
+void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, uint32 miscValue1 /*= 0*/, uint32 miscValue2 /*= 0*/, Unit* unit /*= nullptr*/)
+{
+    // disable for gamemasters with GM-mode enabled
+    if (m_player->IsGameMaster())
+        return;
+
+#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
+    if (type >= ACHIEVEMENT_CRITERIA_TYPE_TOTAL)
+    {
+        LOG_DEBUG("achievement", "UpdateAchievementCriteria: Wrong criteria type %u", type);
         return;
+    }
 
-    sScriptMgr->OnBeforeCheckCriteria(this, achievementCriteriaList);
+    LOG_DEBUG("achievement", "AchievementMgr::UpdateAchievementCriteria(%u, %u, %u)", type, miscValue1, miscValue2);
+#endif
+
+    if (!m_activeCriteriaLoaded)
+        LoadActiveCriteria();
+
+    AchievementCriteriaEntryList const* achievementCriteriaList = nullptr;
+
+    if (IsCriteriaTypeLookedUpByMiscValue(type))
+    {
+        // without a misc value (e.g. at character creation) all criteria of the type are checked
+        uint32 miscValue = type == ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM ? miscValue2 : miscValue1;
+        if (miscValue)
+            achievementCriteriaList = sAchievementMgr->GetSpecialAchievementCriteriaByType(type, miscValue);
+        else
+            achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
+
+        if (!achievementCriteriaList)
+            return;
+
+        sScriptMgr->OnBeforeCheckCriteria(this, achievementCriteriaList);
+    }
+    else
+    {
+        // scripts still see all criteria of the type
+        sScriptMgr->OnBeforeCheckCriteria(this, sAchievementMgr->GetAchievementCriteriaByType(type));
+        achievementCriteriaList = &m_activeCriteria.GetByType(type);
+    }
+
+    ++m_criteriaUpdateDepth;
 
     for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList->begin(); i != achievementCriteriaList->end(); ++i)
     {
         AchievementCriteriaEntry const* achievementCriteria = (*i);
+
+        // all achievements depending on this criteria are already completed
+        if (m_activeCriteria.IsRetired(achievementCriteria))
+            continue;
+
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
         if (!achievement)
             continue;
@@ -1729,6 +1818,9 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
                 if (IsCompletedAchievement(*itr))
                     CompletedAchievement(*itr);
     }
+
+    if (!--m_criteriaUpdateDepth && m_activeCriteria.HasToPrune())
+        m_activeCriteria.Prune();
 }
 
 bool AchievementMgr::IsCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement)
@@ -2053,7 +2145,7 @@ void AchievementMgr::SetCriteriaProgress(AchievementCriteriaEntry const* entry,
         progress->counter = newValue;
     }
 
-    progress->changed = true;
+    JournalCriteriaProgress(entry->ID, progress);
     progress->date = time(nullptr); // set the date to the latest update.
 
     uint32 timeElapsed = 0;
@@ -2087,6 +2179,9 @@ void AchievementMgr::RemoveCriteriaProgress(const AchievementCriteriaEntry* entr
     m_player->SendDirectMessage(&data);
 
     m_criteriaProgress.erase(criteriaProgress);
+
+    // delete the stored progress with the next save
+    m_changedCriteria.Add(entry->ID);
 }
 
 void AchievementMgr::UpdateTimedAchievements(uint32 timeDiff)
@@ -2176,6 +2271,7 @@ void AchievementMgr::CompletedAchievement(AchievementEntry const* achievement)
     CompletedAchievementData& ca = m_completedAchievements[achievement->ID];
     ca.date = time(nullptr);
     ca.changed = true;
+    m_changedAchievements.Add(achievement->ID);
 
     sScriptMgr->OnAchievementComplete(GetPlayer(), achievement);
 
@@ -2197,11 +2293,24 @@ void AchievementMgr::CompletedAchievement(AchievementEntry const* achievement)
                 for (AchievementCriteriaEntryList::const_iterator itr = cList->begin(); itr != cList->end(); ++itr)
                     if (CriteriaProgress* progress = GetCriteriaProgress(*itr))
                     {
-                        progress->changed = true;
+                        JournalCriteriaProgress((*itr)->ID, progress);
                         progress->counter = 0;
                     }
     }
 
+    // stop updating criteria nothing depends on anymore
+    if (m_activeCriteriaLoaded)
+    {
+        RetireCriteriaOf(achievement);
+
+        if (achievement->refAchievement)
+            if (AchievementEntry const* refAchievement = sAchievementStore.LookupEntry(achievement->refAchievement))
+                RetireCriteriaOf(refAchievement);
+
+        if (m_activeCriteria.HasToPrune() && !m_criteriaUpdateDepth)
+            m_activeCriteria.Prune();
+    }
+
     if (achievement->flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL) && AccountMgr::IsPlayerAccount(m_player->GetSession()->GetSecurity()))
         sAchievementMgr->SetRealmCompleted(achievement);
 
@@ -2359,6 +2468,91 @@ bool AchievementMgr::CanUpdateCriteria(AchievementCriteriaEntry const* criteria,
     return true;
 }
 
+/**
+ * builds the per type lists of criteria that can still progress, skipping the criteria of completed achievements
+ */
+void AchievementMgr::LoadActiveCriteria()
+{
+    m_activeCriteria.Reset(sAchievementCriteriaStore.GetNumRows());
+
+    for (CompletedAchievementMap::const_iterator itr = m_completedAchievements.begin(); itr != m_completedAchievements.end(); ++itr)
+        if (AchievementEntry const* achievement = sAchievementStore.LookupEntry(itr->first))
+        {
+            RetireCriteriaOf(achievement);
+
+            // criteria of a referenced achievement are retired together with the last achievement referencing them
+            if (achievement->refAchievement)
+                if (AchievementEntry const* refAchievement = sAchievementStore.LookupEntry(achievement->refAchievement))
+                    RetireCriteriaOf(refAchievement);
+        }
+
+    for (uint32 type = 0; type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++type)
+        if (!IsCriteriaTypeLookedUpByMiscValue(AchievementCriteriaTypes(type)))
+            m_activeCriteria.Fill(AchievementCriteriaTypes(type), *sAchievementMgr->GetAchievementCriteriaByType(AchievementCriteriaTypes(type)));
+
+    m_activeCriteria.Prune();
+    m_activeCriteriaLoaded = true;
+}
+
+/**
+ * criteria progress is no longer needed once the achievement and all achievements referencing its criteria are completed,
+ * as long as they need all of the criteria (N of M achievements keep updating their remaining criteria, like counters)
+ */
+void AchievementMgr::RetireCriteriaOf(AchievementEntry const* achievement)
+{
+    AchievementCriteriaEntryList const* cList = sAchievementMgr->GetAchievementCriteriaByAchievement(achievement->ID);
+    if (!cList)
+        return;
+
+    if (achievement->flags & ACHIEVEMENT_FLAG_COUNTER || !HasAchieved(achievement->ID) || !AchievementActiveCriteria::NeedsAllCriteria(achievement, cList->size()))
+        return;
+
+    if (AchievementEntryList const* achRefList = sAchievementMgr->GetAchievementByReferencedId(achievement->ID))
+        for (AchievementEntryList::const_iterator itr = achRefList->begin(); itr != achRefList->end(); ++itr)
+            if (!HasAchieved((*itr)->ID) || !AchievementActiveCriteria::NeedsAllCriteria(*itr, cList->size()))
+                return;
+
+    m_activeCriteria.Retire(*cList);
+}
+
+void AchievementActiveCriteria::Reset(uint32 criteriaCount)
+{
+    for (AchievementCriteriaEntryList& criteria : _byType)
+        criteria.clear();
+
+    _retired.assign(criteriaCount, false);
+    _hasToPrune = false;
+}
+
+void AchievementActiveCriteria::Fill(AchievementCriteriaTypes type, AchievementCriteriaEntryList const& criteria)
+{
+    _byType[type] = criteria;
+    _hasToPrune = true;
+}
+
+void AchievementActiveCriteria::Retire(AchievementCriteriaEntryList const& criteria)
+{
+    for (AchievementCriteriaEntry const* entry : criteria)
+    {
+        if (entry->ID >= _retired.size() || _retired[entry->ID])
+            continue;
+
+        _retired[entry->ID] = true;
+        _hasToPrune = true;
+    }
+}
+
+void AchievementActiveCriteria::Prune()
+{
+    for (AchievementCriteriaEntryList& criteria : _byType)
+    {
+        acore::Containers::EraseIf(criteria, [this](AchievementCriteriaEntry const* entry) { return IsRetired(entry); });
+        criteria.shrink_to_fit();
+    }
+
+    _hasToPrune = false;
+}
+
 AchievementGlobalMgr* AchievementGlobalMgr::instance()
 {
     static AchievementGlobalMgr instance;
@@ -6,16 +6,19 @@
 #ifndef __ACORE_ACHIEVEMENTMGR_H
 #define __ACORE_ACHIEVEMENTMGR_H
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <string>
 #include <chrono>
+#include <vector>
 
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "DBCEnums.h"
 #include "DBCStores.h"
 
-typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
+typedef std::vector<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::unordered_map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
@@ -251,6 +254,82 @@ class Unit;
 class Player;
 class WorldPacket;
 
+#define ACHIEVEMENT_SAVE_BATCH_SIZE 8                       // rows of the CHAR_*_ACHIEVEMENT*_BATCH statements
+
+// Write-behind journal of the achievement or criteria ids changed since the last save
+class AchievementSaveJournal
+{
+public:
+    void Add(uint32 id) { _ids.push_back(id); }
+    void Clear() { _ids.clear(); }
+
+    // The journaled ids in ascending order, each once however often it changed, the journal is empty afterwards
+    std::vector<uint32> Take()
+    {
+        std::vector<uint32> ids;
+        ids.swap(_ids);
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    // Calls batch(first id) for every ACHIEVEMENT_SAVE_BATCH_SIZE rows, then row(id) for each remaining row
+    template<class Batch, class Row>
+    static void ForEachStatement(std::vector<uint32> const& rows, Batch batch, Row row)
+    {
+        std::size_t i = 0;
+        for (; i + ACHIEVEMENT_SAVE_BATCH_SIZE <= rows.size(); i += ACHIEVEMENT_SAVE_BATCH_SIZE)
+            batch(&rows[i]);
+
+        for (; i < rows.size(); ++i)
+            row(rows[i]);
+    }
+
+private:
+    std::vector<uint32> _ids;
+};
+
+// Per type lists of the criteria a player can still progress, for the types that are not looked up by misc value.
+// Retired criteria are only marked at first, they leave the lists with Prune() when no update iterates them.
+class AchievementActiveCriteria
+{
+public:
+    AchievementActiveCriteria() : _hasToPrune(false) { }
+
+    // Forgets all lists and retired criteria, criteria ids are below criteriaCount
+    void Reset(uint32 criteriaCount);
+    // Copies the criteria of a type, the retired ones are removed by the next Prune()
+    void Fill(AchievementCriteriaTypes type, AchievementCriteriaEntryList const& criteria);
+    void Retire(AchievementCriteriaEntryList const& criteria);
+    [[nodiscard]] bool IsRetired(AchievementCriteriaEntry const* criteria) const { return criteria->ID < _retired.size() && _retired[criteria->ID]; }
+    [[nodiscard]] bool HasToPrune() const { return _hasToPrune; }
+    void Prune();
+
+    [[nodiscard]] AchievementCriteriaEntryList const& GetByType(AchievementCriteriaTypes type) const { return _byType[type]; }
+
+    // Only the criteria of achievements needing all of them are complete once the achievement is,
+    // the others keep progressing after the completion
+    static bool NeedsAllCriteria(AchievementEntry const* achievement, std::size_t criteriaCount)
+    {
+        return !(achievement->flags & ACHIEVEMENT_FLAG_SUMM) && (!achievement->count || achievement->count >= criteriaCount);
+    }
+
+private:
+    AchievementCriteriaEntryList _byType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+    std::vector<bool> _retired;                             // indexed by criteria id
+    bool _hasToPrune;
+};
+
+// Rows written by AchievementMgr::SaveToDB, shown to developers by .server info
+struct AchievementSaveCounters
+{
+    std::atomic<uint32> Flushes{0};                         // saves that wrote anything
+    std::atomic<uint32> Rows{0};                            // achievement and criteria rows saved or deleted
+    std::atomic<uint32> Statements{0};                      // statements these rows took
+};
+
+extern AchievementSaveCounters achievementSaveCounters;
+
 class AchievementMgr
 {
 public:
@@ -279,6 +358,14 @@ private:
     void SendAchievementEarned(AchievementEntry const* achievement) const;
     void SendCriteriaUpdate(AchievementCriteriaEntry const* entry, CriteriaProgress const* progress, uint32 timeElapsed, bool timedCompleted) const;
     CriteriaProgress* GetCriteriaProgress(AchievementCriteriaEntry const* entry);
+    void JournalCriteriaProgress(uint32 criteriaId, CriteriaProgress* progress)
+    {
+        if (progress->changed)
+            return;
+
+        progress->changed = true;
+        m_changedCriteria.Add(criteriaId);
+    }
     void SetCriteriaProgress(AchievementCriteriaEntry const* entry, uint32 changeValue, ProgressType ptype = PROGRESS_SET);
     void CompletedCriteriaFor(AchievementEntry const* achievement);
     bool IsCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement);
@@ -286,11 +373,21 @@ private:
     bool CanUpdateCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement);
     void BuildAllDataPacket(WorldPacket* data, bool inspect = false) const;
 
+    void LoadActiveCriteria();
+    void RetireCriteriaOf(AchievementEntry const* achievement);
+
     Player* m_player;
     CriteriaProgressMap m_criteriaProgress;
     CompletedAchievementMap m_completedAchievements;
+    // write-behind journals, each criteria progress is written once per save
+    AchievementSaveJournal m_changedAchievements;
+    AchievementSaveJournal m_changedCriteria;
     typedef std::map<uint32, uint32> TimedAchievementMap;
     TimedAchievementMap m_timedAchievements;      // Criteria id/time left in MS
+
+    AchievementActiveCriteria m_activeCriteria;
+    bool m_activeCriteriaLoaded;
+    uint32 m_criteriaUpdateDepth;                 // retired criteria are only removed from the lists when no update is iterating them
 };
 
 class AchievementGlobalMgr
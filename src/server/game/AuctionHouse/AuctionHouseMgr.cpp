@@ -27,7 +27,7 @@ enum eAuctionHouse
     AH_MINIMUM_DEPOSIT = 100,
 };
 
-AuctionHouseMgr::AuctionHouseMgr()
+AuctionHouseMgr::AuctionHouseMgr() : _nextScriptUpdate(0)
 {
 }
 
@@ -385,10 +385,24 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id, bool deleteFromDB)
 
 void AuctionHouseMgr::Update()
 {
-    sScriptMgr->OnBeforeAuctionHouseMgrUpdate();
-    mHordeAuctions.Update();
-    mAllianceAuctions.Update();
-    mNeutralAuctions.Update();
+    // scripts (ie: auction house bots) keep their former once a minute update
+    if (sWorld->GetGameTime() >= _nextScriptUpdate)
+    {
+        sScriptMgr->OnBeforeAuctionHouseMgrUpdate();
+        _nextScriptUpdate = sWorld->GetGameTime() + MINUTE;
+    }
+
+    // a budget per house and update spreads mass expirations (ie: after a restart) over several updates,
+    // a backlog in one house does not hold back the expirations of the others
+    uint32 budget = sWorld->getIntConfig(CONFIG_AUCTION_EXPIRY_BUDGET);
+    uint32 ended = 0;
+
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    for (AuctionHouseObject* auctionHouse : { &mHordeAuctions, &mAllianceAuctions, &mNeutralAuctions })
+        ended += auctionHouse->Update(trans, budget);
+
+    if (ended)
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTemplateId)
@@ -451,17 +465,83 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTem
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+// Name suffix of a random property (ie: of the Monkey), from ItemRandomSuffix.dbc or ItemRandomProperties.dbc
+// DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+//  that matches the search but it may not equal item->GetItemRandomPropertyId()
+//  used in BuildAuctionInfo() which then causes wrong items to be listed
+static char* const* GetItemNameSuffix(int32 propRefID)
+{
+    if (propRefID < 0)
+    {
+        if (ItemRandomSuffixEntry const* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-propRefID))
+            return itemRandEntry->nameSuffix;
+    }
+    else if (propRefID > 0)
+    {
+        if (ItemRandomPropertiesEntry const* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(propRefID))
+            return itemRandEntry->nameSuffix;
+    }
+
+    return nullptr;
+}
+
+void AuctionHouseObject::IndexAuction(AuctionEntry* auction)
+{
+    // auctions without their item are never listed
+    Item* item = sAuctionMgr->GetAItem(auction->item_guidlow);
+    if (!item)
+        return;
+
+    ItemTemplate const* proto = item->GetTemplate();
+
+    AuctionSearchEntry entry;
+    entry.AuctionId = auction->Id;
+    entry.Proto = proto;
+    auction->BuildListingInfo(item, entry.Info);
+    entry.ItemClass = proto->Class;
+    entry.ItemSubClass = proto->SubClass;
+    entry.InventoryType = proto->InventoryType;
+    entry.Quality = proto->Quality;
+    entry.RequiredLevel = proto->RequiredLevel;
+
+    // default locale name, searches of other locales check their localized name while listing
+    std::string name = proto->Name1;
+    if (!name.empty())
+    {
+        if (char* const* suffix = GetItemNameSuffix(entry.Info.RandomPropertyId))
+        {
+            name += ' ';
+            name += suffix[LOCALE_enUS];
+        }
+
+        if (Utf8toWStr(name, entry.Name))
+            wstrToLower(entry.Name);
+        else
+            entry.Name.clear();
+    }
+
+    SearchIndex.Insert(entry);
+}
+
 void AuctionHouseObject::AddAuction(AuctionEntry* auction)
 {
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    ExpiryBuckets.Add(auction->Id, auction->expire_time);
+    IndexAuction(auction);
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
+void AuctionHouseObject::UpdateAuction(AuctionEntry* auction)
+{
+    IndexAuction(auction);
+}
+
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = !!AuctionsMap.erase(auction->Id);
+    SearchIndex.Remove(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -472,25 +552,23 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+uint32 AuctionHouseObject::Update(SQLTransaction& trans, uint32 budget)
 {
-    time_t checkTime = sWorld->GetGameTime() + 60;
     ///- Handle expired auctions
+    time_t now = sWorld->GetGameTime();
+    uint32 ended = 0;
+    uint32 auctionId;
 
-    // If storage is empty, no need to update. next == nullptr in this case.
-    if (AuctionsMap.empty())
-        return;
-
-    SQLTransaction trans = CharacterDatabase.BeginTransaction();
-
-    for (AuctionEntryMap::iterator itr, iter = AuctionsMap.begin(); iter != AuctionsMap.end(); )
+    while ((!budget || ended < budget) && ExpiryBuckets.PopDue(now, auctionId))
     {
-        itr = iter++;
-        AuctionEntry* auction = (*itr).second;
+        AuctionEntry* auction = GetAuction(auctionId);
 
-        if (auction->expire_time > checkTime)
+        // already bought out or cancelled
+        if (!auction)
             continue;
 
+        ++ended;
+
         ///- Either cancel the auction if there was no bidder
         if (auction->bidder == 0)
         {
@@ -514,7 +592,11 @@ void AuctionHouseObject::Update()
         sAuctionMgr->RemoveAItem(auction->item_guidlow);
         RemoveAuction(auction);
     }
-    CharacterDatabase.CommitTransaction(trans);
+
+    // the listing threads only publish when somebody searches, the queued changes must not pile up meanwhile
+    SearchIndex.Publish();
+
+    return ended;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -554,20 +636,20 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
 {
     uint32 itrcounter = 0;
 
+    // Listing threads only read a snapshot of the auctions, the world thread keeps changing AuctionsMap meanwhile
+    SearchIndex.Publish();
+    AuctionHouseSearchSnapshots::Snapshot snapshot = SearchIndex.GetSnapshot();
+
     // pussywizard: optimization, this is a simplified case
     if (itemClass == 0xffffffff && itemSubClass == 0xffffffff && inventoryType == 0xffffffff && quality == 0xffffffff && levelmin == 0x00 && levelmax == 0x00 && usable == 0x00 && wsearchedname.empty())
     {
-        totalcount = Getcount();
-        if (listfrom < totalcount)
+        AuctionHouseSearchIndex::EntryList const& entries = snapshot->GetEntries();
+        totalcount = entries.size();
+        for (uint32 i = listfrom; i < entries.size(); ++i)
         {
-            AuctionEntryMap::iterator itr = AuctionsMap.begin();
-            std::advance(itr, listfrom);
-            for (; itr != AuctionsMap.end(); ++itr)
-            {
-                itr->second->BuildAuctionInfo(data);
-                if ((++count) >= 50)
-                    break;
-            }
+            entries[i]->Info.Write(data);
+            if ((++count) >= 50)
+                break;
         }
         return true;
     }
@@ -577,46 +659,37 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
     int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionSearchFilter filter;
+    filter.Name = wsearchedname;
+    // the index holds the default locale names, the other locales are checked below
+    filter.CheckName = loc_idx < 0 && (locdbc_idx < 0 || locdbc_idx == LOCALE_enUS);
+    filter.LevelMin = levelmin;
+    filter.LevelMax = levelmax;
+    filter.InventoryType = inventoryType;
+    filter.ItemClass = itemClass;
+    filter.ItemSubClass = itemSubClass;
+    filter.Quality = quality;
+
+    AuctionHouseSearchIndex::EntryList matches;
+    snapshot->Search(filter, matches);
+
+    for (AuctionSearchEntry const* match : matches)
     {
         if (AsyncAuctionListingMgr::IsAuctionListingAllowed() == false) // pussywizard: World::Update is waiting for us...
             if ((itrcounter++) % 100 == 0) // check condition every 100 iterations
                 if (avgDiffTracker.getAverage() >= 30 || getMSTimeDiff(World::GetGameTimeMS(), getMSTime()) >= 10) // pussywizard: stop immediately if diff is high or waiting too long
                     return false;
 
-        AuctionEntry* Aentry = itr->second;
         // Skip expired auctions
-        if (Aentry->expire_time < curTime)
-            continue;
-
-        Item* item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
-        if (!item)
-            continue;
-
-        ItemTemplate const* proto = item->GetTemplate();
-
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
-
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
-
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-        {
-            // xinef: exception, robes are counted as chests
-            if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                continue;
-        }
-
-        if (quality != 0xffffffff && proto->Quality != quality)
+        if (match->Info.ExpireTime < curTime)
             continue;
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
+        ItemTemplate const* proto = match->Proto;
 
         if (usable != 0x00)
         {
-            if (player->CanUseItem(item) != EQUIP_ERR_OK)
+            // the template checks of CanUseItem(Item*), the item of an auction is never bound
+            if (player->CanUseItem(proto) != EQUIP_ERR_OK || player->CanUseItemProficiencyAndReputation(proto) != EQUIP_ERR_OK)
                 continue;
 
             // xinef: check already learded recipes and pets
@@ -626,7 +699,7 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
 
         // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
         // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
+        if (!filter.CheckName && !wsearchedname.empty())
         {
             std::string name = proto->Name1;
             if (name.empty())
@@ -637,40 +710,13 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
                 if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
                     ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
 
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
+            // dbc local name
+            if (char* const* suffix = GetItemNameSuffix(match->Info.RandomPropertyId))
             {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                //  even though the DBC name seems misleading
-
-                char* const* suffix = nullptr;
-
-                if (propRefID < 0)
-                {
-                    const ItemRandomSuffixEntry* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-item->GetItemRandomPropertyId());
-                    if (itemRandEntry)
-                        suffix = itemRandEntry->nameSuffix;
-                }
-                else
-                {
-                    const ItemRandomPropertiesEntry* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(item->GetItemRandomPropertyId());
-                    if (itemRandEntry)
-                        suffix = itemRandEntry->nameSuffix;
-                }
-
-                // dbc local name
-                if (suffix)
-                {
-                    // Append the suffix (ie: of the Monkey) to the name using localization
-                    // or default enUS if localization is invalid
-                    name += ' ';
-                    name += suffix[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                }
+                // Append the suffix (ie: of the Monkey) to the name using localization
+                // or default enUS if localization is invalid
+                name += ' ';
+                name += suffix[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
             }
 
             // Perform the search (with or without suffix)
@@ -682,7 +728,7 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         if (count < 50 && totalcount >= listfrom)
         {
             ++count;
-            Aentry->BuildAuctionInfo(data);
+            match->Info.Write(data);
         }
         ++totalcount;
     }
@@ -699,30 +745,38 @@ bool AuctionEntry::BuildAuctionInfo(WorldPacket& data) const
         LOG_ERROR("server", "AuctionEntry::BuildAuctionInfo: Auction %u has a non-existent item: %u", Id, item_guidlow);
         return false;
     }
-    data << uint32(Id);
-    data << uint32(item->GetEntry());
+
+    AuctionListingInfo info;
+    BuildListingInfo(item, info);
+    info.Write(data);
+    return true;
+}
+
+void AuctionEntry::BuildListingInfo(Item const* item, AuctionListingInfo& info) const
+{
+    static_assert(MAX_INSPECTED_ENCHANTMENT_SLOT == 7, "AuctionListingInfo::Enchantments must hold every inspected enchantment slot");
+
+    info.AuctionId = Id;
+    info.ItemEntry = item->GetEntry();
 
     for (uint8 i = 0; i < MAX_INSPECTED_ENCHANTMENT_SLOT; ++i)
     {
-        data << uint32(item->GetEnchantmentId(EnchantmentSlot(i)));
-        data << uint32(item->GetEnchantmentDuration(EnchantmentSlot(i)));
-        data << uint32(item->GetEnchantmentCharges(EnchantmentSlot(i)));
+        info.Enchantments[i][0] = item->GetEnchantmentId(EnchantmentSlot(i));
+        info.Enchantments[i][1] = item->GetEnchantmentDuration(EnchantmentSlot(i));
+        info.Enchantments[i][2] = item->GetEnchantmentCharges(EnchantmentSlot(i));
     }
 
-    data << int32(item->GetItemRandomPropertyId());                 // Random item property id
-    data << uint32(item->GetItemSuffixFactor());                    // SuffixFactor
-    data << uint32(item->GetCount());                               // item->count
-    data << uint32(item->GetSpellCharges());                        // item->charge FFFFFFF
-    data << uint32(0);                                              // Unknown
-    data << uint64(owner);                                          // Auction->owner
-    data << uint32(startbid);                                       // Auction->startbid (not sure if useful)
-    data << uint32(bid ? GetAuctionOutBid() : 0);
-    // Minimal outbid
-    data << uint32(buyout);                                         // Auction->buyout
-    data << uint32((expire_time - time(nullptr)) * IN_MILLISECONDS);   // time left
-    data << uint64(bidder);                                         // auction->bidder current
-    data << uint32(bid);                                            // current bid
-    return true;
+    info.RandomPropertyId = item->GetItemRandomPropertyId();
+    info.SuffixFactor = item->GetItemSuffixFactor();
+    info.Count = item->GetCount();
+    info.SpellCharges = item->GetSpellCharges();
+    info.Owner = owner;
+    info.StartBid = startbid;
+    info.OutBid = bid ? GetAuctionOutBid() : 0;
+    info.Buyout = buyout;
+    info.ExpireTime = expire_time;
+    info.Bidder = bidder;
+    info.Bid = bid;
 }
 
 uint32 AuctionEntry::GetAuctionCut() const
@@ -7,6 +7,7 @@
 #ifndef _AUCTION_HOUSE_MGR_H
 #define _AUCTION_HOUSE_MGR_H
 
+#include "AuctionHouseSearch.h"
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
@@ -18,6 +19,7 @@ class Player;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
+#define AUCTION_EXPIRY_BUCKET 10                            // seconds of expire times sharing one bucket of the expiry wheel
 
 enum AuctionError
 {
@@ -73,6 +75,7 @@ struct AuctionEntry
     [[nodiscard]] uint32 GetAuctionCut() const;
     [[nodiscard]] uint32 GetAuctionOutBid() const;
     bool BuildAuctionInfo(WorldPacket& data) const;
+    void BuildListingInfo(Item const* item, AuctionListingInfo& info) const;
     void DeleteFromDB(SQLTransaction& trans) const;
     void SaveToDB(SQLTransaction& trans) const;
     bool LoadFromDB(Field* fields);
@@ -82,6 +85,37 @@ struct AuctionEntry
 };
 
 //this class is used as auctionhouse instance
+// Auction ids by expire time / AUCTION_EXPIRY_BUCKET. A bucket is due once its last second has passed,
+// so no auction ends before its expire time. Removed auctions are dropped when their bucket comes due.
+class AuctionExpiryWheel
+{
+public:
+    void Add(uint32 auctionId, time_t expireTime) { _buckets[expireTime / AUCTION_EXPIRY_BUCKET].push_back(auctionId); }
+
+    // Takes an auction id of the oldest due bucket, false when no bucket is due
+    bool PopDue(time_t now, uint32& auctionId)
+    {
+        while (!_buckets.empty() && (_buckets.begin()->first + 1) * AUCTION_EXPIRY_BUCKET <= now)
+        {
+            std::vector<uint32>& bucket = _buckets.begin()->second;
+            if (bucket.empty())
+            {
+                _buckets.erase(_buckets.begin());
+                continue;
+            }
+
+            auctionId = bucket.back();
+            bucket.pop_back();
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    std::map<time_t, std::vector<uint32>> _buckets;
+};
+
 class AuctionHouseObject
 {
 public:
@@ -110,7 +144,11 @@ public:
 
     bool RemoveAuction(AuctionEntry* auction);
 
-    void Update();
+    // Call after changing the bid of an auction, so the listings show it
+    void UpdateAuction(AuctionEntry* auction);
+
+    // Ends at most budget due auctions (0 for all of them), returns how many it ended
+    uint32 Update(SQLTransaction& trans, uint32 budget);
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -120,7 +158,11 @@ public:
                                uint32& count, uint32& totalcount, uint8 getAll);
 
 private:
+    void IndexAuction(AuctionEntry* auction);
+
     AuctionEntryMap AuctionsMap;
+    AuctionHouseSearchSnapshots SearchIndex;                // what BuildListAuctionItems lists, for the auctions of AuctionsMap
+    AuctionExpiryWheel ExpiryBuckets;
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
@@ -176,6 +218,8 @@ private:
     AuctionHouseObject mNeutralAuctions;
 
     ItemMap mAitems;
+
+    time_t _nextScriptUpdate;
 };
 
 #define sAuctionMgr AuctionHouseMgr::instance()
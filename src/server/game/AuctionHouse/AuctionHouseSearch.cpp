@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "AuctionHouseSearch.h"
+#include "ByteBuffer.h"
+#include "Common.h"
+#include "ItemTemplate.h"
+#include <algorithm>
+
+namespace
+{
+    bool IdLess(AuctionSearchEntry const* left, AuctionSearchEntry const* right)
+    {
+        return left->AuctionId < right->AuctionId;
+    }
+
+    AuctionHouseSearchIndex::EntryList const EmptyList;
+}
+
+void AuctionListingInfo::Write(ByteBuffer& data) const
+{
+    data << uint32(AuctionId);
+    data << uint32(ItemEntry);
+
+    for (uint8 i = 0; i < 7; ++i)
+    {
+        data << uint32(Enchantments[i][0]);
+        data << uint32(Enchantments[i][1]);
+        data << uint32(Enchantments[i][2]);
+    }
+
+    data << int32(RandomPropertyId);                                 // Random item property id
+    data << uint32(SuffixFactor);                                    // SuffixFactor
+    data << uint32(Count);                                           // item->count
+    data << uint32(SpellCharges);                                    // item->charge FFFFFFF
+    data << uint32(0);                                               // Unknown
+    data << uint64(Owner);                                           // Auction->owner
+    data << uint32(StartBid);                                        // Auction->startbid (not sure if useful)
+    data << uint32(OutBid);                                          // Minimal outbid
+    data << uint32(Buyout);                                          // Auction->buyout
+    data << uint32((ExpireTime - time(nullptr)) * IN_MILLISECONDS);  // time left
+    data << uint64(Bidder);                                          // auction->bidder current
+    data << uint32(Bid);                                             // current bid
+}
+
+void AuctionHouseSearchIndex::Insert(AuctionSearchEntry const& entry)
+{
+    Remove(entry.AuctionId);
+
+    AuctionSearchEntry const* indexed = &(_entries[entry.AuctionId] = entry);
+
+    _all.insert(std::upper_bound(_all.begin(), _all.end(), indexed, IdLess), indexed);
+    AddPosting(_byClass, indexed->ItemClass, indexed);
+    AddPosting(_bySubClass, GetClassKey(indexed->ItemClass, indexed->ItemSubClass), indexed);
+    AddPosting(_byInventoryType, indexed->InventoryType, indexed);
+    AddPosting(_byQuality, indexed->Quality, indexed);
+    AddPosting(_byLevel, indexed->RequiredLevel, indexed);
+
+    std::vector<uint64> trigrams;
+    GetTrigrams(indexed->Name, trigrams);
+    for (uint64 trigram : trigrams)
+        AddPosting(_byTrigram, trigram, indexed);
+}
+
+void AuctionHouseSearchIndex::Remove(uint32 auctionId)
+{
+    std::map<uint32, AuctionSearchEntry>::iterator itr = _entries.find(auctionId);
+    if (itr == _entries.end())
+        return;
+
+    AuctionSearchEntry const* indexed = &itr->second;
+
+    _all.erase(std::lower_bound(_all.begin(), _all.end(), indexed, IdLess));
+    RemovePosting(_byClass, indexed->ItemClass, indexed);
+    RemovePosting(_bySubClass, GetClassKey(indexed->ItemClass, indexed->ItemSubClass), indexed);
+    RemovePosting(_byInventoryType, indexed->InventoryType, indexed);
+    RemovePosting(_byQuality, indexed->Quality, indexed);
+    RemovePosting(_byLevel, indexed->RequiredLevel, indexed);
+
+    std::vector<uint64> trigrams;
+    GetTrigrams(indexed->Name, trigrams);
+    for (uint64 trigram : trigrams)
+        RemovePosting(_byTrigram, trigram, indexed);
+
+    _entries.erase(itr);
+}
+
+void AuctionHouseSearchIndex::Clear()
+{
+    _entries.clear();
+    _all.clear();
+    _byClass.clear();
+    _bySubClass.clear();
+    _byInventoryType.clear();
+    _byQuality.clear();
+    _byLevel.clear();
+    _byTrigram.clear();
+}
+
+void AuctionHouseSearchIndex::Search(AuctionSearchFilter const& filter, EntryList& result) const
+{
+    // Every set filter gives the lists holding all its matches, the search walks the filter with the fewest entries
+    std::vector<EntryList const*> candidates;
+    std::size_t candidateCount = 0;
+    bool indexed = false;
+
+    auto consider = [&](std::vector<EntryList const*> const& lists)
+    {
+        std::size_t count = 0;
+        for (EntryList const* list : lists)
+            count += list->size();
+
+        if (!indexed || count < candidateCount)
+        {
+            candidates = lists;
+            candidateCount = count;
+            indexed = true;
+        }
+    };
+
+    if (filter.ItemClass != AUCTION_SEARCH_ANY)
+    {
+        if (filter.ItemSubClass != AUCTION_SEARCH_ANY)
+            consider({ FindPosting(_bySubClass, GetClassKey(filter.ItemClass, filter.ItemSubClass)) });
+        else
+            consider({ FindPosting(_byClass, filter.ItemClass) });
+    }
+
+    if (filter.InventoryType != AUCTION_SEARCH_ANY)
+    {
+        // robes are listed with the chests
+        if (filter.InventoryType == INVTYPE_CHEST)
+            consider({ FindPosting(_byInventoryType, INVTYPE_CHEST), FindPosting(_byInventoryType, INVTYPE_ROBE) });
+        else
+            consider({ FindPosting(_byInventoryType, filter.InventoryType) });
+    }
+
+    if (filter.Quality != AUCTION_SEARCH_ANY)
+        consider({ FindPosting(_byQuality, filter.Quality) });
+
+    // an open level range matches most auctions anyway
+    if (filter.LevelMin && filter.LevelMax && filter.LevelMin <= filter.LevelMax)
+    {
+        std::vector<EntryList const*> levels;
+        for (uint32 level = filter.LevelMin; level <= filter.LevelMax; ++level)
+            if (EntryList const* list = FindPosting(_byLevel, level))
+                if (!list->empty())
+                    levels.push_back(list);
+
+        consider(levels);
+    }
+
+    if (filter.CheckName)
+    {
+        std::vector<uint64> trigrams;
+        GetTrigrams(filter.Name, trigrams);
+        for (uint64 trigram : trigrams)
+            consider({ FindPosting(_byTrigram, trigram) });
+    }
+
+    if (!indexed)
+        candidates.assign(1, &_all);
+    else if (!candidateCount)
+        return;
+
+    std::size_t first = result.size();
+    for (EntryList const* list : candidates)
+        for (AuctionSearchEntry const* entry : *list)
+            if (Matches(*entry, filter))
+                result.push_back(entry);
+
+    // several lists (level range, chests and robes) are merged back into auction id order
+    if (candidates.size() > 1)
+        std::sort(result.begin() + first, result.end(), IdLess);
+}
+
+bool AuctionHouseSearchIndex::Matches(AuctionSearchEntry const& entry, AuctionSearchFilter const& filter)
+{
+    if (filter.ItemClass != AUCTION_SEARCH_ANY && entry.ItemClass != filter.ItemClass)
+        return false;
+
+    if (filter.ItemSubClass != AUCTION_SEARCH_ANY && entry.ItemSubClass != filter.ItemSubClass)
+        return false;
+
+    if (filter.InventoryType != AUCTION_SEARCH_ANY && entry.InventoryType != filter.InventoryType)
+    {
+        // xinef: exception, robes are counted as chests
+        if (filter.InventoryType != INVTYPE_CHEST || entry.InventoryType != INVTYPE_ROBE)
+            return false;
+    }
+
+    if (filter.Quality != AUCTION_SEARCH_ANY && entry.Quality != filter.Quality)
+        return false;
+
+    if (filter.LevelMin != 0x00 && (entry.RequiredLevel < filter.LevelMin || (filter.LevelMax != 0x00 && entry.RequiredLevel > filter.LevelMax)))
+        return false;
+
+    if (filter.CheckName && !filter.Name.empty())
+        if (entry.Name.empty() || entry.Name.find(filter.Name) == std::wstring::npos)
+            return false;
+
+    return true;
+}
+
+// Distinct 3 character sequences of a lower case name, 21 bits per character
+void AuctionHouseSearchIndex::GetTrigrams(std::wstring const& name, std::vector<uint64>& trigrams)
+{
+    trigrams.clear();
+    if (name.size() < 3)
+        return;
+
+    for (std::size_t i = 0; i + 3 <= name.size(); ++i)
+        trigrams.push_back((uint64(name[i] & 0x1FFFFF) << 42) | (uint64(name[i + 1] & 0x1FFFFF) << 21) | uint64(name[i + 2] & 0x1FFFFF));
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+void AuctionHouseSearchIndex::AddPosting(PostingMap& map, uint64 key, AuctionSearchEntry const* entry)
+{
+    // auction ids grow, so this mostly appends
+    EntryList& list = map[key];
+    list.insert(std::upper_bound(list.begin(), list.end(), entry, IdLess), entry);
+}
+
+void AuctionHouseSearchIndex::RemovePosting(PostingMap& map, uint64 key, AuctionSearchEntry const* entry)
+{
+    PostingMap::iterator itr = map.find(key);
+    if (itr == map.end())
+        return;
+
+    EntryList& list = itr->second;
+    EntryList::iterator position = std::lower_bound(list.begin(), list.end(), entry, IdLess);
+    if (position != list.end() && *position == entry)
+        list.erase(position);
+
+    if (list.empty())
+        map.erase(itr);
+}
+
+AuctionHouseSearchIndex::EntryList const* AuctionHouseSearchIndex::FindPosting(PostingMap const& map, uint64 key)
+{
+    PostingMap::const_iterator itr = map.find(key);
+    return itr != map.end() ? &itr->second : &EmptyList;
+}
+
+AuctionHouseSearchSnapshots::Snapshot& AuctionHouseSearchSnapshots::Snapshot::operator=(Snapshot&& right)
+{
+    if (this != &right)
+    {
+        reset();
+        std::swap(_index, right._index);
+        std::swap(_readers, right._readers);
+    }
+
+    return *this;
+}
+
+void AuctionHouseSearchSnapshots::Snapshot::reset()
+{
+    // release: the reads of the search happen before the publisher changes the index
+    if (_readers)
+        _readers->fetch_sub(1, std::memory_order_release);
+
+    _index = nullptr;
+    _readers = nullptr;
+}
+
+AuctionHouseSearchSnapshots::AuctionHouseSearchSnapshots() : _published(0)
+{
+    _readers[0] = 0;
+    _readers[1] = 0;
+}
+
+void AuctionHouseSearchSnapshots::Insert(AuctionSearchEntry const& entry)
+{
+    std::lock_guard<std::mutex> guard(_pendingLock);
+    _pending.push_back({ entry, false });
+}
+
+void AuctionHouseSearchSnapshots::Remove(uint32 auctionId)
+{
+    AuctionSearchEntry entry;
+    entry.AuctionId = auctionId;
+
+    std::lock_guard<std::mutex> guard(_pendingLock);
+    _pending.push_back({ entry, true });
+}
+
+void AuctionHouseSearchSnapshots::Publish()
+{
+    // another listing thread is publishing, its snapshot will do
+    std::unique_lock<std::mutex> publishGuard(_publishLock, std::try_to_lock);
+    if (!publishGuard.owns_lock())
+        return;
+
+    // a search still runs on the former snapshot, publish next time
+    // acquire: pairs with the release of its last snapshot, no new one is given since the index was swapped out
+    uint8 next = 1 - _published;
+    if (_readers[next].load(std::memory_order_acquire))
+        return;
+
+    std::vector<Change> changes;
+    {
+        std::lock_guard<std::mutex> guard(_pendingLock);
+        changes.swap(_pending);
+    }
+
+    if (changes.empty() && _replay.empty())
+        return;
+
+    Apply(_indexes[next], _replay);
+    Apply(_indexes[next], changes);
+    _replay.swap(changes);
+
+    std::lock_guard<std::mutex> guard(_snapshotLock);
+    _published = next;
+}
+
+AuctionHouseSearchSnapshots::Snapshot AuctionHouseSearchSnapshots::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> guard(_snapshotLock);
+    _readers[_published].fetch_add(1, std::memory_order_relaxed);
+    return Snapshot(&_indexes[_published], &_readers[_published]);
+}
+
+void AuctionHouseSearchSnapshots::Apply(AuctionHouseSearchIndex& index, std::vector<Change> const& changes)
+{
+    for (Change const& change : changes)
+    {
+        if (change.Removed)
+            index.Remove(change.Entry.AuctionId);
+        else
+            index.Insert(change.Entry);
+    }
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _AUCTION_HOUSE_SEARCH_H
+#define _AUCTION_HOUSE_SEARCH_H
+
+#include "Define.h"
+#include <atomic>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ByteBuffer;
+struct ItemTemplate;
+
+#define AUCTION_SEARCH_ANY 0xffffffff
+
+// What CMSG_AUCTION_LIST_ITEMS filters on, AUCTION_SEARCH_ANY (or 0 for the levels) when not set
+struct AuctionSearchFilter
+{
+    std::wstring Name;                                      // lower case
+    bool CheckName = true;                                  // false when the caller checks a localized name itself
+    uint8 LevelMin = 0;
+    uint8 LevelMax = 0;
+    uint32 InventoryType = AUCTION_SEARCH_ANY;
+    uint32 ItemClass = AUCTION_SEARCH_ANY;
+    uint32 ItemSubClass = AUCTION_SEARCH_ANY;
+    uint32 Quality = AUCTION_SEARCH_ANY;
+};
+
+// One auction of SMSG_AUCTION_LIST_RESULT, copied from the auction and its item so listing threads never read them
+struct AuctionListingInfo
+{
+    uint32 AuctionId = 0;
+    uint32 ItemEntry = 0;
+    uint32 Enchantments[7][3] = { };                        // id, duration and charges of the MAX_INSPECTED_ENCHANTMENT_SLOT slots
+    int32 RandomPropertyId = 0;
+    uint32 SuffixFactor = 0;
+    uint32 Count = 0;
+    uint32 SpellCharges = 0;
+    uint32 Owner = 0;
+    uint32 StartBid = 0;
+    uint32 OutBid = 0;
+    uint32 Buyout = 0;
+    time_t ExpireTime = 0;
+    uint32 Bidder = 0;
+    uint32 Bid = 0;
+
+    void Write(ByteBuffer& data) const;
+};
+
+struct AuctionSearchEntry
+{
+    uint32 AuctionId;
+    ItemTemplate const* Proto;
+    AuctionListingInfo Info;
+    uint32 ItemClass;
+    uint32 ItemSubClass;
+    uint32 InventoryType;
+    uint32 Quality;
+    uint32 RequiredLevel;
+    std::wstring Name;                                      // lower case default locale name with its random suffix, empty if the item has no name
+};
+
+/*
+ * Indexes of the auctions of one auction house by item class, subclass, inventory type, quality,
+ * required level and name trigrams. A search walks the smallest posting list of the filters it sets,
+ * so it only touches auctions that match at least one of them. Posting lists are kept in auction id
+ * order, the order of AuctionHouseObject::AuctionsMap, so paged results stay the same.
+ */
+class AuctionHouseSearchIndex
+{
+public:
+    typedef std::vector<AuctionSearchEntry const*> EntryList;
+
+    void Insert(AuctionSearchEntry const& entry);
+    void Remove(uint32 auctionId);
+    void Clear();
+
+    [[nodiscard]] uint32 GetSize() const { return _entries.size(); }
+    [[nodiscard]] EntryList const& GetEntries() const { return _all; }
+
+    // Appends the auctions matching every item filter, in auction id order
+    void Search(AuctionSearchFilter const& filter, EntryList& result) const;
+
+    [[nodiscard]] static bool Matches(AuctionSearchEntry const& entry, AuctionSearchFilter const& filter);
+
+private:
+    typedef std::unordered_map<uint64, EntryList> PostingMap;
+
+    static uint64 GetClassKey(uint32 itemClass, uint32 itemSubClass) { return (uint64(itemClass) << 32) | itemSubClass; }
+    static void GetTrigrams(std::wstring const& name, std::vector<uint64>& trigrams);
+
+    static void AddPosting(PostingMap& map, uint64 key, AuctionSearchEntry const* entry);
+    static void RemovePosting(PostingMap& map, uint64 key, AuctionSearchEntry const* entry);
+    static EntryList const* FindPosting(PostingMap const& map, uint64 key);
+
+    std::map<uint32, AuctionSearchEntry> _entries;
+    EntryList _all;                                         // every entry, for searches without any indexed filter
+    PostingMap _byClass;
+    PostingMap _bySubClass;                                 // class and subclass together
+    PostingMap _byInventoryType;
+    PostingMap _byQuality;
+    PostingMap _byLevel;
+    PostingMap _byTrigram;
+};
+
+/*
+ * Copy-on-write publication of an AuctionHouseSearchIndex for the listing threads.
+ *
+ * The world thread only queues its changes. They are published by the listing threads and by the
+ * auction house update: the queue is applied to the index no reader holds any more, which is swapped
+ * with the published one, and the same changes are replayed on the other index at the next publication.
+ * Readers keep the snapshot they got for their whole search, so a search never sees a half applied change
+ * and the world thread never waits for a search.
+ */
+class AuctionHouseSearchSnapshots
+{
+public:
+    // Read access to the published index for one search, it must not outlive the snapshots it comes from
+    class Snapshot
+    {
+    public:
+        Snapshot() : _index(nullptr), _readers(nullptr) { }
+        Snapshot(Snapshot&& right) : _index(right._index), _readers(right._readers) { right._index = nullptr; right._readers = nullptr; }
+        ~Snapshot() { reset(); }
+
+        Snapshot& operator=(Snapshot&& right);
+
+        // the index may be changed again once none of its snapshots is held
+        void reset();
+
+        AuctionHouseSearchIndex const* operator->() const { return _index; }
+        AuctionHouseSearchIndex const& operator*() const { return *_index; }
+
+    private:
+        friend class AuctionHouseSearchSnapshots;
+
+        Snapshot(AuctionHouseSearchIndex const* index, std::atomic<uint32>* readers) : _index(index), _readers(readers) { }
+
+        Snapshot(Snapshot const&) = delete;
+        Snapshot& operator=(Snapshot const&) = delete;
+
+        AuctionHouseSearchIndex const* _index;
+        std::atomic<uint32>* _readers;
+    };
+
+    AuctionHouseSearchSnapshots();
+
+    // world thread
+    void Insert(AuctionSearchEntry const& entry);
+    void Remove(uint32 auctionId);
+
+    // listing threads and auction house update
+    void Publish();
+
+    // listing threads
+    [[nodiscard]] Snapshot GetSnapshot() const;
+
+private:
+    struct Change
+    {
+        AuctionSearchEntry Entry;
+        bool Removed;
+    };
+
+    static void Apply(AuctionHouseSearchIndex& index, std::vector<Change> const& changes);
+
+    std::mutex _pendingLock;
+    std::vector<Change> _pending;
+
+    std::mutex _publishLock;
+    AuctionHouseSearchIndex _indexes[2];
+    std::vector<Change> _replay;                            // applied to the published index, not yet to the other one
+
+    mutable std::mutex _snapshotLock;
+    mutable std::atomic<uint32> _readers[2];                // snapshots held on each index
+    uint8 _published;                                       // index given by GetSnapshot, changed under both locks
+};
+
+#endif
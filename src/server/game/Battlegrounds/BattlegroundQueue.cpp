@@ -43,14 +43,98 @@ BattlegroundQueue::~BattlegroundQueue()
 
     m_QueuedPlayers.clear();
     for (auto& m_QueuedGroup : m_QueuedGroups)
-    {
         for (auto& j : m_QueuedGroup)
-        {
-            for (auto& itr : j)
-                delete itr;
-            j.clear();
-        }
+            j.DeleteAll();
+}
+
+/*********************************************************/
+/***              BATTLEGROUND QUEUE GROUPS            ***/
+/*********************************************************/
+
+void BattlegroundQueue::QueuedGroups::Add(GroupQueueInfo* ginfo, bool front)
+{
+    ginfo->_queueOrder = front ? --m_FrontOrder : m_BackOrder++;
+    ginfo->_queueSize = ginfo->Players.size();
+
+    if (ginfo->IsInvitedToBGInstanceGUID)
+    {
+        m_Invited.insert(ginfo);
+        return;
+    }
+
+    m_Waiting[ginfo->_queueSize][ginfo->_queueOrder] = ginfo;
+    m_WaitingPlayers += ginfo->_queueSize;
+}
+
+void BattlegroundQueue::QueuedGroups::Remove(GroupQueueInfo* ginfo)
+{
+    if (m_Invited.erase(ginfo))
+        return;
+
+    auto itr = m_Waiting.find(ginfo->_queueSize);
+    if (itr == m_Waiting.end() || !itr->second.erase(ginfo->_queueOrder))
+        return;
+
+    if (itr->second.empty())
+        m_Waiting.erase(itr);
+    m_WaitingPlayers -= ginfo->_queueSize;
+}
+
+void BattlegroundQueue::QueuedGroups::SetInvited(GroupQueueInfo* ginfo)
+{
+    if (m_Invited.count(ginfo))
+        return;
+
+    Remove(ginfo);
+    m_Invited.insert(ginfo);
+}
+
+// a player left a group, it keeps its place in queue
+void BattlegroundQueue::QueuedGroups::UpdateSize(GroupQueueInfo* ginfo)
+{
+    if (m_Invited.count(ginfo) || ginfo->_queueSize == ginfo->Players.size())
+        return;
+
+    Remove(ginfo);
+    ginfo->_queueSize = ginfo->Players.size();
+    m_Waiting[ginfo->_queueSize][ginfo->_queueOrder] = ginfo;
+    m_WaitingPlayers += ginfo->_queueSize;
+}
+
+GroupQueueInfo* BattlegroundQueue::QueuedGroups::GetNextWaiting(int64 order, uint32 minSize, uint32 maxSize) const
+{
+    GroupQueueInfo* next = nullptr;
+    for (auto itr = m_Waiting.lower_bound(minSize); itr != m_Waiting.end() && itr->first <= maxSize; ++itr)
+    {
+        auto groupItr = itr->second.lower_bound(order);
+        if (groupItr != itr->second.end() && (!next || groupItr->first < next->_queueOrder))
+            next = groupItr->second;
     }
+    return next;
+}
+
+void BattlegroundQueue::QueuedGroups::GetWaitingGroups(GroupsQueueType& groups) const
+{
+    std::vector<GroupQueueInfo*> waiting;
+    for (auto const& itr : m_Waiting)
+        for (auto const& groupItr : itr.second)
+            waiting.push_back(groupItr.second);
+
+    std::sort(waiting.begin(), waiting.end(), [](GroupQueueInfo const* a, GroupQueueInfo const* b) { return a->_queueOrder < b->_queueOrder; });
+    groups.insert(groups.end(), waiting.begin(), waiting.end());
+}
+
+void BattlegroundQueue::QueuedGroups::DeleteAll()
+{
+    for (auto const& itr : m_Waiting)
+        for (auto const& groupItr : itr.second)
+            delete groupItr.second;
+    for (GroupQueueInfo* ginfo : m_Invited)
+        delete ginfo;
+
+    m_Waiting.clear();
+    m_Invited.clear();
+    m_WaitingPlayers = 0;
 }
 
 /*********************************************************/
@@ -109,6 +193,21 @@ bool BattlegroundQueue::SelectionPool::AddGroup(GroupQueueInfo* ginfo, uint32 de
     return PlayerCount < desiredCount;
 }
 
+// adds the waiting groups from order on while they fit, returns the order to continue the selection from
+int64 BattlegroundQueue::SelectionPool::AddGroups(QueuedGroups const& groups, int64 order, uint32 desiredCount)
+{
+    while (PlayerCount < desiredCount)
+    {
+        GroupQueueInfo* ginfo = groups.GetNextWaiting(order, 1, desiredCount - PlayerCount);
+        if (!ginfo)
+            return QueuedGroups::ORDER_END;
+
+        AddGroup(ginfo, desiredCount);
+        order = ginfo->_queueOrder + 1;
+    }
+    return order;
+}
+
 /*********************************************************/
 /***               BATTLEGROUND QUEUES                 ***/
 /*********************************************************/
@@ -176,7 +275,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, PvPDiffi
     }
 
     //add GroupInfo to m_QueuedGroups
-    m_QueuedGroups[bracketId][index].push_back(ginfo);
+    AddToQueue(ginfo, index, false);
 
     Battleground* bg = sBattlegroundMgr->GetBattlegroundTemplate(ginfo->BgTypeId);
     if (!bg)
@@ -261,31 +360,16 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool sentToBg, uint32 playerQu
 
     GroupQueueInfo* groupInfo = itr->second;
 
-    uint32 _bracketId = groupInfo->_bracketId;
-    uint32 _groupType = groupInfo->_groupType;
-
-    // find iterator
-    auto group_itr = m_QueuedGroups[_bracketId][_groupType].end();
-    for (auto k = m_QueuedGroups[_bracketId][_groupType].begin(); k != m_QueuedGroups[_bracketId][_groupType].end(); ++k)
-        if ((*k) == groupInfo)
-        {
-            group_itr = k;
-            break;
-        }
-
-    //player can't be in queue without group, but just in case
-    if (group_itr == m_QueuedGroups[_bracketId][_groupType].end())
-    {
-        ABORT();
-        return;
-    }
-
     // remove player from group queue info
     auto pitr = groupInfo->Players.find(guid);
     ASSERT(pitr != groupInfo->Players.end());
     if (pitr != groupInfo->Players.end())
         groupInfo->Players.erase(pitr);
 
+    // a smaller group may now fit where it did not before
+    if (!groupInfo->Players.empty())
+        m_QueuedGroups[groupInfo->_bracketId][groupInfo->_groupType].UpdateSize(groupInfo);
+
     // if invited to bg, then always decrease invited count when removed from queue
     // sending player to bg will increase it again
     if (groupInfo->IsInvitedToBGInstanceGUID)
@@ -310,7 +394,7 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool sentToBg, uint32 playerQu
     // remove group queue info no players left
     if (groupInfo->Players.empty())
     {
-        m_QueuedGroups[_bracketId][_groupType].erase(group_itr);
+        RemoveFromQueue(groupInfo);
         delete groupInfo;
         return;
     }
@@ -333,6 +417,51 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool sentToBg, uint32 playerQu
     }
 }
 
+void BattlegroundQueue::AddToQueue(GroupQueueInfo* ginfo, uint8 groupType, bool front)
+{
+    ginfo->_groupType = groupType;
+    m_QueuedGroups[ginfo->_bracketId][groupType].Add(ginfo, front);
+
+    if (ginfo->IsRated && !ginfo->IsInvitedToBGInstanceGUID)
+        m_ArenaTeamsByMMR[ginfo->_bracketId].insert(std::make_pair(ginfo->ArenaMatchmakerRating, ginfo));
+}
+
+static void RemoveArenaTeam(BattlegroundQueue::ArenaTeamsByMMR& teams, GroupQueueInfo* ginfo)
+{
+    auto bounds = teams.equal_range(ginfo->ArenaMatchmakerRating);
+    for (auto itr = bounds.first; itr != bounds.second; ++itr)
+        if (itr->second == ginfo)
+        {
+            teams.erase(itr);
+            return;
+        }
+}
+
+void BattlegroundQueue::RemoveFromQueue(GroupQueueInfo* ginfo)
+{
+    m_QueuedGroups[ginfo->_bracketId][ginfo->_groupType].Remove(ginfo);
+
+    if (ginfo->IsRated)
+        RemoveArenaTeam(m_ArenaTeamsByMMR[ginfo->_bracketId], ginfo);
+}
+
+// moves a group to the front of another queue of the same bracket
+void BattlegroundQueue::MoveInQueue(GroupQueueInfo* ginfo, uint8 groupType)
+{
+    m_QueuedGroups[ginfo->_bracketId][ginfo->_groupType].Remove(ginfo);
+    ginfo->_groupType = groupType;
+    m_QueuedGroups[ginfo->_bracketId][groupType].Add(ginfo, true);
+}
+
+// called by BattlegroundMgr::InviteGroupToBG, invited groups are no longer selected
+void BattlegroundQueue::SetGroupInvited(GroupQueueInfo* ginfo)
+{
+    m_QueuedGroups[ginfo->_bracketId][ginfo->_groupType].SetInvited(ginfo);
+
+    if (ginfo->IsRated)
+        RemoveArenaTeam(m_ArenaTeamsByMMR[ginfo->_bracketId], ginfo);
+}
+
 void BattlegroundQueue::AddEvent(BasicEvent* Event, uint64 e_time)
 {
     m_events.AddEvent(Event, m_events.CalculateTime(e_time));
@@ -370,19 +499,20 @@ void BattlegroundQueue::FillPlayersToBG(Battleground* bg, const int32 aliFree, c
     m_SelectionPools[TEAM_ALLIANCE].Init();
     m_SelectionPools[TEAM_HORDE].Init();
 
+    QueuedGroups const& aliQueue = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE];
+    QueuedGroups const& hordeQueue = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE];
+
     // quick check if nothing we can do:
     if (!sBattlegroundMgr->isTesting())
-        if ((aliFree > hordeFree && m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].empty()) ||
-                (hordeFree > aliFree && m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].empty()))
+        if ((aliFree > hordeFree && aliQueue.IsEmpty()) ||
+                (hordeFree > aliFree && hordeQueue.IsEmpty()))
             return;
 
     // ally: at first fill as much as possible
-    auto Ali_itr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].begin();
-    for (; Ali_itr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].end() && m_SelectionPools[TEAM_ALLIANCE].AddGroup((*Ali_itr), aliFree); ++Ali_itr);
+    int64 aliOrder = m_SelectionPools[TEAM_ALLIANCE].AddGroups(aliQueue, QueuedGroups::ORDER_BEGIN, aliFree);
 
     // horde: at first fill as much as possible
-    auto Horde_itr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].begin();
-    for (; Horde_itr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].end() && m_SelectionPools[TEAM_HORDE].AddGroup((*Horde_itr), hordeFree); ++Horde_itr);
+    int64 hordeOrder = m_SelectionPools[TEAM_HORDE].AddGroups(hordeQueue, QueuedGroups::ORDER_BEGIN, hordeFree);
 
     // calculate free space after adding
     int32 aliDiff = aliFree - int32(m_SelectionPools[TEAM_ALLIANCE].GetPlayerCount());
@@ -417,7 +547,7 @@ void BattlegroundQueue::FillPlayersToBG(Battleground* bg, const int32 aliFree, c
 
             // kick alliance, returns true if kicked more than needed, so then try to fill up
             if (m_SelectionPools[TEAM_ALLIANCE].KickGroup(hordeDiff - aliDiff))
-                for (; Ali_itr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].end() && m_SelectionPools[TEAM_ALLIANCE].AddGroup((*Ali_itr), aliFree >= hordeDiff ? aliFree - hordeDiff : 0); ++Ali_itr);
+                aliOrder = m_SelectionPools[TEAM_ALLIANCE].AddGroups(aliQueue, aliOrder, aliFree >= hordeDiff ? aliFree - hordeDiff : 0);
         }
         // if results in more horde players than alliance:
         else
@@ -428,7 +558,7 @@ void BattlegroundQueue::FillPlayersToBG(Battleground* bg, const int32 aliFree, c
 
             // kick horde, returns true if kicked more than needed, so then try to fill up
             if (m_SelectionPools[TEAM_HORDE].KickGroup(aliDiff - hordeDiff))
-                for (; Horde_itr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].end() && m_SelectionPools[TEAM_HORDE].AddGroup((*Horde_itr), hordeFree >= aliDiff ? hordeFree - aliDiff : 0); ++Horde_itr);
+                hordeOrder = m_SelectionPools[TEAM_HORDE].AddGroups(hordeQueue, hordeOrder, hordeFree >= aliDiff ? hordeFree - aliDiff : 0);
         }
 
         // recalculate free space after adding
@@ -448,16 +578,16 @@ void BattlegroundQueue::FillPlayersToBGWithSpecific(Battleground* bg, const int3
 
     // quick check if nothing we can do:
     if (!sBattlegroundMgr->isTesting())
-        if ((m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_ALLIANCE].empty() && specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_ALLIANCE].empty()) ||
-                (m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_HORDE].empty() && specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_HORDE].empty()))
+        if ((m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_ALLIANCE].IsEmpty() && specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_ALLIANCE].IsEmpty()) ||
+                (m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_HORDE].IsEmpty() && specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_HORDE].IsEmpty()))
             return;
 
-    // copy groups from both queues to new joined container
+    // copy waiting groups from both queues to new joined container
     GroupsQueueType m_QueuedBoth[BG_TEAMS_COUNT];
-    m_QueuedBoth[TEAM_ALLIANCE].insert(m_QueuedBoth[TEAM_ALLIANCE].end(), specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(), specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_ALLIANCE].end());
-    m_QueuedBoth[TEAM_ALLIANCE].insert(m_QueuedBoth[TEAM_ALLIANCE].end(), m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(), m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_ALLIANCE].end());
-    m_QueuedBoth[TEAM_HORDE].insert(m_QueuedBoth[TEAM_HORDE].end(), specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_HORDE].begin(), specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_HORDE].end());
-    m_QueuedBoth[TEAM_HORDE].insert(m_QueuedBoth[TEAM_HORDE].end(), m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_HORDE].begin(), m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_HORDE].end());
+    specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_ALLIANCE].GetWaitingGroups(m_QueuedBoth[TEAM_ALLIANCE]);
+    m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_ALLIANCE].GetWaitingGroups(m_QueuedBoth[TEAM_ALLIANCE]);
+    specificQueue->m_QueuedGroups[specificBracketId][BG_QUEUE_NORMAL_HORDE].GetWaitingGroups(m_QueuedBoth[TEAM_HORDE]);
+    m_QueuedGroups[thisBracketId][BG_QUEUE_NORMAL_HORDE].GetWaitingGroups(m_QueuedBoth[TEAM_HORDE]);
 
     // ally: at first fill as much as possible
     auto Ali_itr = m_QueuedBoth[TEAM_ALLIANCE].begin();
@@ -527,23 +657,18 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
     m_SelectionPools[TEAM_ALLIANCE].Init();
     m_SelectionPools[TEAM_HORDE].Init();
 
-    if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() && !m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty())
+    if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].IsEmpty() && !m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].IsEmpty())
     {
         // find premade group for both factions:
-        GroupsQueueType::const_iterator ali_group, horde_group;
-        for (ali_group = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].begin(); ali_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end(); ++ali_group)
-            if (!(*ali_group)->IsInvitedToBGInstanceGUID && (*ali_group)->Players.size() >= MinPlayersPerTeam)
-                break;
-        for (horde_group = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].begin(); horde_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end(); ++horde_group)
-            if (!(*horde_group)->IsInvitedToBGInstanceGUID && (*horde_group)->Players.size() >= MinPlayersPerTeam)
-                break;
+        GroupQueueInfo* ali_group = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].GetNextWaiting(QueuedGroups::ORDER_BEGIN, MinPlayersPerTeam, std::numeric_limits<uint32>::max());
+        GroupQueueInfo* horde_group = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].GetNextWaiting(QueuedGroups::ORDER_BEGIN, MinPlayersPerTeam, std::numeric_limits<uint32>::max());
 
         // if found both groups
-        if (ali_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end() && horde_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end())
+        if (ali_group && horde_group)
         {
             // add premade groups to selection pools
-            m_SelectionPools[TEAM_ALLIANCE].AddGroup((*ali_group), MaxPlayersPerTeam);
-            m_SelectionPools[TEAM_HORDE].AddGroup((*horde_group), MaxPlayersPerTeam);
+            m_SelectionPools[TEAM_ALLIANCE].AddGroup(ali_group, MaxPlayersPerTeam);
+            m_SelectionPools[TEAM_HORDE].AddGroup(horde_group, MaxPlayersPerTeam);
 
             // battleground will be immediately filled (after calling this function and creating new battleground) with more players from normal queue
 
@@ -558,19 +683,23 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
     uint32 time_before = World::GetGameTimeMS() >= premade_time ? World::GetGameTimeMS() - premade_time : 0;
 
     for (uint32 i = 0; i < BG_TEAMS_COUNT; i++)
-        if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
-            for (auto itr = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].begin(); itr != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].end(); )
+    {
+        std::vector<GroupQueueInfo*> moved;
+        for (auto const& itr : m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].GetWaitingBySize())
+            for (auto const& groupItr : itr.second)
             {
-                if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
-                {
-                    (*itr)->_groupType = BG_QUEUE_NORMAL_ALLIANCE + i; // pussywizard: update GroupQueueInfo internal variable
-                    m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                    m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr++);
-                    continue;
-                }
-                ++itr;
+                // premade groups are only queued at the end, following ones of the same size joined later
+                if (itr.first >= MinPlayersPerTeam && groupItr.second->JoinTime >= time_before)
+                    break;
+                moved.push_back(groupItr.second);
             }
 
+        // in queue order, each one is moved to the front like before
+        std::sort(moved.begin(), moved.end(), [](GroupQueueInfo const* a, GroupQueueInfo const* b) { return a->_queueOrder < b->_queueOrder; });
+        for (GroupQueueInfo* ginfo : moved)
+            MoveInQueue(ginfo, BG_QUEUE_NORMAL_ALLIANCE + i);
+    }
+
     return false;
 }
 
@@ -609,47 +738,43 @@ bool BattlegroundQueue::CheckNormalMatch(Battleground* bgTemplate, BattlegroundB
 bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracket_id, uint32 minPlayersPerTeam)
 {
     for (uint32 i = 0; i < BG_TEAMS_COUNT; i++)
-        if (!m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].empty())
+        if (!m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].IsEmpty())
         {
             // clear selection pools
             m_SelectionPools[TEAM_ALLIANCE].Init();
             m_SelectionPools[TEAM_HORDE].Init();
 
-            // fill one queue to both selection pools
-            for (auto itr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].begin(); itr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++itr)
-                for (uint32 j = 0; j < BG_TEAMS_COUNT; j++) // try to add this group to both pools
-                    if (m_SelectionPools[TEAM_ALLIANCE + j].GetPlayerCount() < minPlayersPerTeam) // if this pool is not full
-                        if (m_SelectionPools[TEAM_ALLIANCE + j].AddGroup((*itr), minPlayersPerTeam)) // successfully added
-                        {
-                            // if both selection pools are full
-                            if (m_SelectionPools[TEAM_ALLIANCE].GetPlayerCount() >= minPlayersPerTeam && m_SelectionPools[TEAM_HORDE].GetPlayerCount() >= minPlayersPerTeam)
-                            {
-                                // need to move groups from one pool to another queue (for another faction)
-                                TeamId wrongTeamId = (i == 0 ? TEAM_HORDE : TEAM_ALLIANCE);
-
-                                for (auto pitr = m_SelectionPools[wrongTeamId].SelectedGroups.begin(); pitr != m_SelectionPools[wrongTeamId].SelectedGroups.end(); ++pitr)
-                                {
-                                    // update internal GroupQueueInfo data
-                                    (*pitr)->teamId = wrongTeamId;
-                                    (*pitr)->_groupType = BG_QUEUE_NORMAL_ALLIANCE + wrongTeamId;
-
-                                    // add GroupQueueInfo to new queue
-                                    m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + wrongTeamId].push_front(*pitr);
-
-                                    // remove GroupQueueInfo from old queue
-                                    for (auto qitr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].begin(); qitr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++qitr)
-                                        if (*qitr == *pitr)
-                                        {
-                                            m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].erase(qitr);
-                                            break;
-                                        }
-                                }
-
-                                return true;
-                            }
-
-                            break; // added to one pool, prevent adding it to the second pool
-                        }
+            // fill one queue to both selection pools, each group is offered to the first pool that is not full yet
+            int64 order = QueuedGroups::ORDER_BEGIN;
+            for (;;)
+            {
+                SelectionPool& pool = m_SelectionPools[m_SelectionPools[TEAM_ALLIANCE].GetPlayerCount() < minPlayersPerTeam ? TEAM_ALLIANCE : TEAM_HORDE];
+                if (pool.GetPlayerCount() >= minPlayersPerTeam)
+                    break;
+
+                GroupQueueInfo* ginfo = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].GetNextWaiting(order, 1, minPlayersPerTeam - pool.GetPlayerCount());
+                if (!ginfo)
+                    break;
+
+                pool.AddGroup(ginfo, minPlayersPerTeam);
+                order = ginfo->_queueOrder + 1;
+
+                // if both selection pools are full
+                if (m_SelectionPools[TEAM_ALLIANCE].GetPlayerCount() >= minPlayersPerTeam && m_SelectionPools[TEAM_HORDE].GetPlayerCount() >= minPlayersPerTeam)
+                {
+                    // need to move groups from one pool to another queue (for another faction)
+                    TeamId wrongTeamId = (i == 0 ? TEAM_HORDE : TEAM_ALLIANCE);
+
+                    for (auto pitr = m_SelectionPools[wrongTeamId].SelectedGroups.begin(); pitr != m_SelectionPools[wrongTeamId].SelectedGroups.end(); ++pitr)
+                    {
+                        // update internal GroupQueueInfo data
+                        (*pitr)->teamId = wrongTeamId;
+                        MoveInQueue(*pitr, BG_QUEUE_NORMAL_ALLIANCE + wrongTeamId);
+                    }
+
+                    return true;
+                }
+            }
         }
 
     return false;
@@ -781,173 +906,149 @@ void BattlegroundQueue::BattlegroundQueueUpdate(BattlegroundBracketId bracket_id
     {
         // pussywizard: everything inside this section is mine, do NOT destroy!
 
-        const uint32 currMSTime = World::GetGameTimeMS();
-        const uint32 discardTime = sBattlegroundMgr->GetRatingDiscardTimer();
         const uint32 maxDefaultRatingDifference = (MaxPlayersPerTeam > 2 ? 300 : 200);
-        const uint32 maxCountedMMR = 2500;
 
         // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[BG_TEAMS_COUNT];
+        GroupQueueInfo* teams[BG_TEAMS_COUNT];
 
-        bool increaseItr = true;
         bool reverse1 = urand(0, 1) != 0;
         for (uint8 ii = BG_QUEUE_PREMADE_ALLIANCE; ii <= BG_QUEUE_PREMADE_HORDE; ii++)
         {
             uint8 i = reverse1 ? (BG_QUEUE_PREMADE_HORDE - ii) : ii;
-            for (auto itr = m_QueuedGroups[bracket_id][i].begin(); itr != m_QueuedGroups[bracket_id][i].end(); (increaseItr ? ++itr : itr))
+            int64 order = QueuedGroups::ORDER_BEGIN;
+            while (GroupQueueInfo* team = m_QueuedGroups[bracket_id][i].GetNextWaiting(order, 0, std::numeric_limits<uint32>::max()))
             {
-                increaseItr = true;
+                order = team->_queueOrder + 1;
 
                 // if arenaRatedTeamId is set - look for oponents only for one team, if not - pair every possible team
-                if (arenaRatedTeamId != 0 && arenaRatedTeamId != (*itr)->ArenaTeamId)
-                    continue;
-                if ((*itr)->IsInvitedToBGInstanceGUID)
+                if (arenaRatedTeamId != 0 && arenaRatedTeamId != team->ArenaTeamId)
                     continue;
 
-                uint32 MMR1 = std::min((*itr)->ArenaMatchmakerRating, maxCountedMMR);
-
-                GroupsQueueType::iterator oponentItr;
-                uint8 oponentQueue = BG_QUEUE_MAX;
-                uint32 minOponentMMRDiff = 0xffffffff;
-                uint8 oponentValid = 0;
-
-                bool reverse2 = urand(0, 1) != 0;
-                for (uint8 jj = BG_QUEUE_PREMADE_ALLIANCE; jj <= BG_QUEUE_PREMADE_HORDE; jj++)
+                GroupQueueInfo* oponent = FindArenaOpponent(team, bracket_id, maxDefaultRatingDifference);
+                if (!oponent)
                 {
-                    uint8 j = reverse2 ? (BG_QUEUE_PREMADE_HORDE - jj) : jj;
-                    bool brk = false;
-                    for (auto itr2 = m_QueuedGroups[bracket_id][j].begin(); itr2 != m_QueuedGroups[bracket_id][j].end(); ++itr2)
-                    {
-                        if ((*itr)->ArenaTeamId == (*itr2)->ArenaTeamId)
-                            continue;
-                        if ((*itr2)->IsInvitedToBGInstanceGUID)
-                            continue;
-                        uint32 MMR2 = std::min((*itr2)->ArenaMatchmakerRating, maxCountedMMR);
-                        uint32 MMRDiff = (MMR2 >= MMR1 ? MMR2 - MMR1 : MMR1 - MMR2);
-
-                        uint32 maxAllowedDiff = maxDefaultRatingDifference;
-                        uint32 shorterWaitTime, longerWaitTime;
-                        if (currMSTime - (*itr)->JoinTime <= currMSTime - (*itr2)->JoinTime)
-                        {
-                            shorterWaitTime = currMSTime - (*itr)->JoinTime;
-                            longerWaitTime = currMSTime - (*itr2)->JoinTime;
-                        }
-                        else
-                        {
-                            shorterWaitTime = currMSTime - (*itr2)->JoinTime;
-                            longerWaitTime = currMSTime - (*itr)->JoinTime;
-                        }
-                        if (longerWaitTime >= discardTime)
-                            maxAllowedDiff += 150;
-                        maxAllowedDiff += shorterWaitTime / 600; // increased by 100 for each minute
-
-                        // now check if this team is more appropriate than previous ones:
-
-                        if (currMSTime - (*itr)->JoinTime >= 20 * MINUTE * IN_MILLISECONDS && (oponentValid < 3 || MMRDiff < minOponentMMRDiff)) // after 20 minutes of waiting, pair with closest mmr, regardless the difference
-                        {
-                            oponentValid = 3;
-                            minOponentMMRDiff = MMRDiff;
-                            oponentItr = itr2;
-                            oponentQueue = j;
-                        }
-                        else if (MMR1 >= 2000 && MMR2 >= 2000 && longerWaitTime >= 2 * discardTime && (oponentValid < 2 || MMRDiff < minOponentMMRDiff)) // after 6 minutes of waiting, pair any 2000+ vs 2000+
-                        {
-                            oponentValid = 2;
-                            minOponentMMRDiff = MMRDiff;
-                            oponentItr = itr2;
-                            oponentQueue = j;
-                        }
-                        else if (oponentValid < 2 && MMRDiff < minOponentMMRDiff)
-                        {
-                            if (!oponentValid)
-                            {
-                                minOponentMMRDiff = MMRDiff;
-                                oponentItr = itr2;
-                                oponentQueue = j;
-                                if (MMRDiff <= maxAllowedDiff)
-                                    oponentValid = 1;
-                            }
-                            if ((MMR1 < 1800 || MMR2 < 1800) && MaxPlayersPerTeam == 2 && MMRDiff <= maxDefaultRatingDifference) // in 2v2 below 1800 mmr - priority for default allowed difference
-                            {
-                                minOponentMMRDiff = MMRDiff;
-                                oponentItr = itr2;
-                                oponentQueue = j;
-                                brk = true;
-                                break;
-                            }
-                        }
-                    }
-                    if (brk)
-                        break;
+                    if (arenaRatedTeamId)
+                        return;
+                    continue;
                 }
 
-                if (oponentQueue != BG_QUEUE_MAX)
+                teams[i] = team;
+                teams[i == 0 ? 1 : 0] = oponent;
+
                 {
-                    if (oponentValid)
-                    {
-                        itr_teams[i] = itr;
-                        itr_teams[i == 0 ? 1 : 0] = oponentItr;
-
-                        {
-                            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-                            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
-                            Battleground* arena = sBattlegroundMgr->CreateNewBattleground(m_bgTypeId, bracketEntry->minLevel, bracketEntry->maxLevel, m_arenaType, true);
-                            if (!arena)
-                                return;
-
-                            aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
-                            hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
-                            aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
-                            hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
-
-                            // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-                            if (aTeam->teamId != TEAM_ALLIANCE)
-                            {
-                                aTeam->_groupType = BG_QUEUE_PREMADE_ALLIANCE;
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-                                increaseItr = false;
-                                itr = m_QueuedGroups[bracket_id][i].begin();
-                            }
-                            if (hTeam->teamId != TEAM_HORDE)
-                            {
-                                hTeam->_groupType = BG_QUEUE_PREMADE_HORDE;
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-                                increaseItr = false;
-                                itr = m_QueuedGroups[bracket_id][i].begin();
-                            }
-
-                            arena->SetArenaMatchmakerRating(TEAM_ALLIANCE, aTeam->ArenaMatchmakerRating);
-                            arena->SetArenaMatchmakerRating(TEAM_HORDE, hTeam->ArenaMatchmakerRating);
-                            BattlegroundMgr::InviteGroupToBG(aTeam, arena, TEAM_ALLIANCE);
-                            BattlegroundMgr::InviteGroupToBG(hTeam, arena, TEAM_HORDE);
-
-                            arena->StartBattleground();
-                        }
-
-                        if (arenaRatedTeamId)
-                            return;
-                        else
-                            continue;
-                    }
-                    else if (arenaRatedTeamId)
+                    GroupQueueInfo* aTeam = teams[TEAM_ALLIANCE];
+                    GroupQueueInfo* hTeam = teams[TEAM_HORDE];
+                    Battleground* arena = sBattlegroundMgr->CreateNewBattleground(m_bgTypeId, bracketEntry->minLevel, bracketEntry->maxLevel, m_arenaType, true);
+                    if (!arena)
                         return;
+
+                    aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
+                    hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
+                    aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
+                    hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
+
+                    // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
+                    if (aTeam->_groupType != BG_QUEUE_PREMADE_ALLIANCE)
+                        MoveInQueue(aTeam, BG_QUEUE_PREMADE_ALLIANCE);
+                    if (hTeam->_groupType != BG_QUEUE_PREMADE_HORDE)
+                        MoveInQueue(hTeam, BG_QUEUE_PREMADE_HORDE);
+
+                    arena->SetArenaMatchmakerRating(TEAM_ALLIANCE, aTeam->ArenaMatchmakerRating);
+                    arena->SetArenaMatchmakerRating(TEAM_HORDE, hTeam->ArenaMatchmakerRating);
+                    BattlegroundMgr::InviteGroupToBG(aTeam, arena, TEAM_ALLIANCE);
+                    BattlegroundMgr::InviteGroupToBG(hTeam, arena, TEAM_HORDE);
+
+                    arena->StartBattleground();
                 }
+
+                if (arenaRatedTeamId)
+                    return;
             }
         }
     }
 }
 
-uint32 BattlegroundQueue::GetPlayersCountInGroupsQueue(BattlegroundBracketId bracketId, BattlegroundQueueGroupTypes bgqueue)
+GroupQueueInfo* BattlegroundQueue::FindArenaOpponent(GroupQueueInfo* team, BattlegroundBracketId bracket_id, uint32 maxDefaultRatingDifference)
+{
+    return FindArenaOpponent(team, m_ArenaTeamsByMMR[bracket_id], maxDefaultRatingDifference, World::GetGameTimeMS(), sBattlegroundMgr->GetRatingDiscardTimer());
+}
+
+// walks the waiting teams from the closest matchmaker rating outwards
+GroupQueueInfo* BattlegroundQueue::FindArenaOpponent(GroupQueueInfo const* team, ArenaTeamsByMMR const& arenaTeams, uint32 maxDefaultRatingDifference, uint32 currMSTime, uint32 discardTime)
 {
-    uint32 playersCount = 0;
+    const uint32 maxCountedMMR = 2500;
+
+    uint32 MMR1 = std::min(team->ArenaMatchmakerRating, maxCountedMMR);
+    uint32 waitTime = currMSTime - team->JoinTime;
 
-    for (auto const& itr : m_QueuedGroups[bracketId][bgqueue])
-        if (!itr->IsInvitedToBGInstanceGUID)
-            playersCount += static_cast<uint32>(itr->Players.size());
+    // no oponent allows a bigger difference than this, only 2000+ teams that waited long enough are looked for further
+    uint32 maxWindow = maxDefaultRatingDifference + 150 + waitTime / 600;
+
+    auto mmrDiff = [&](GroupQueueInfo const* ginfo)
+    {
+        uint32 MMR2 = std::min(ginfo->ArenaMatchmakerRating, maxCountedMMR);
+        return MMR2 >= MMR1 ? MMR2 - MMR1 : MMR1 - MMR2;
+    };
+
+    ArenaTeamsByMMR::const_iterator up = arenaTeams.lower_bound(team->ArenaMatchmakerRating);
+    ArenaTeamsByMMR::const_iterator down = up;
+    bool searchDown = true;
+    GroupQueueInfo* closest = nullptr;
+
+    for (;;)
+    {
+        // take the closer one of the next teams above and below
+        bool hasUp = up != arenaTeams.end();
+        bool hasDown = searchDown && down != arenaTeams.begin();
+        if (!hasUp && !hasDown)
+            break;
 
-    return playersCount;
+        GroupQueueInfo* oponent;
+        bool fromBelow = !hasUp || (hasDown && mmrDiff(std::prev(down)->second) < mmrDiff(up->second));
+        if (fromBelow)
+            oponent = (--down)->second;
+        else
+            oponent = (up++)->second;
+
+        if (oponent->ArenaTeamId == team->ArenaTeamId)
+            continue;
+
+        uint32 MMR2 = std::min(oponent->ArenaMatchmakerRating, maxCountedMMR);
+        uint32 MMRDiff = mmrDiff(oponent);
+        uint32 oponentWaitTime = currMSTime - oponent->JoinTime;
+        uint32 shorterWaitTime = std::min(waitTime, oponentWaitTime);
+        uint32 longerWaitTime = std::max(waitTime, oponentWaitTime);
+
+        if (waitTime >= 20 * MINUTE * IN_MILLISECONDS) // after 20 minutes of waiting, pair with closest mmr, regardless the difference
+            return oponent;
+
+        if (MMR1 >= 2000 && MMR2 >= 2000 && longerWaitTime >= 2 * discardTime) // after 6 minutes of waiting, pair any 2000+ vs 2000+
+            return oponent;
+
+        uint32 maxAllowedDiff = maxDefaultRatingDifference;
+        if (longerWaitTime >= discardTime)
+            maxAllowedDiff += 150;
+        maxAllowedDiff += shorterWaitTime / 600; // increased by 100 for each minute
+
+        if (!closest && MMRDiff <= maxAllowedDiff)
+            closest = oponent;
+
+        // only a 2000+ team waiting long enough can still be preferred
+        if (closest || MMRDiff > maxWindow)
+        {
+            if (MMR1 < 2000)
+                break;
+            if (fromBelow && MMR2 < 2000)
+                searchDown = false;
+        }
+    }
+
+    return closest;
+}
+
+uint32 BattlegroundQueue::GetPlayersCountInGroupsQueue(BattlegroundBracketId bracketId, BattlegroundQueueGroupTypes bgqueue)
+{
+    return m_QueuedGroups[bracketId][bgqueue].GetWaitingPlayersCount();
 }
 
 bool BattlegroundQueue::IsAllQueuesEmpty(BattlegroundBracketId bracket_id)
@@ -955,7 +1056,7 @@ bool BattlegroundQueue::IsAllQueuesEmpty(BattlegroundBracketId bracket_id)
     uint32 queueEmptyCount = 0;
 
     for (uint8 i = 0; i < BG_QUEUE_MAX; i++)
-        if (m_QueuedGroups[bracket_id][i].empty())
+        if (m_QueuedGroups[bracket_id][i].IsEmpty())
             queueEmptyCount++;
 
     return queueEmptyCount == BG_QUEUE_MAX;
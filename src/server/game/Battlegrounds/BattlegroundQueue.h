@@ -12,6 +12,8 @@
 #include "DBCEnums.h"
 #include "EventProcessor.h"
 #include <deque>
+#include <limits>
+#include <unordered_set>
 
 #define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
 
@@ -35,6 +37,8 @@ struct GroupQueueInfo                                       // stores informatio
     // pussywizard: for internal use
     uint8 _bracketId;
     uint8 _groupType;
+    int64 _queueOrder;                                      // position in its queue, lower ones were queued earlier
+    uint32 _queueSize;                                      // players count it is indexed with, 0 when invited
 };
 
 enum BattlegroundQueueGroupTypes
@@ -83,6 +87,44 @@ public:
     //do NOT use deque because deque.erase() invalidates ALL iterators
     typedef std::list<GroupQueueInfo*> GroupsQueueType;
 
+    /*
+    Groups of one bracket and group type, in queue order
+    Groups waiting for an invitation are kept by their size, so selecting groups for free slots only looks at groups that fit.
+    Invited groups stay until their players enter the battleground or leave the queue.
+    */
+    class QueuedGroups
+    {
+    public:
+        typedef std::map<int64, GroupQueueInfo*> OrderedGroups;
+        typedef std::map<uint32, OrderedGroups> GroupsBySize;
+
+        static constexpr int64 ORDER_BEGIN = std::numeric_limits<int64>::min();
+        static constexpr int64 ORDER_END = std::numeric_limits<int64>::max();
+
+        QueuedGroups(): m_FrontOrder(0), m_BackOrder(0), m_WaitingPlayers(0) { }
+
+        void Add(GroupQueueInfo* ginfo, bool front);
+        void Remove(GroupQueueInfo* ginfo);
+        void SetInvited(GroupQueueInfo* ginfo);
+        void UpdateSize(GroupQueueInfo* ginfo);
+
+        // first waiting group with order or later, which has between minSize and maxSize players
+        [[nodiscard]] GroupQueueInfo* GetNextWaiting(int64 order, uint32 minSize, uint32 maxSize) const;
+        void GetWaitingGroups(GroupsQueueType& groups) const;
+        void DeleteAll();
+
+        [[nodiscard]] GroupsBySize const& GetWaitingBySize() const { return m_Waiting; }
+        [[nodiscard]] uint32 GetWaitingPlayersCount() const { return m_WaitingPlayers; }
+        [[nodiscard]] bool IsEmpty() const { return m_Waiting.empty() && m_Invited.empty(); }
+
+    private:
+        GroupsBySize m_Waiting;
+        std::unordered_set<GroupQueueInfo*> m_Invited;
+        int64 m_FrontOrder;
+        int64 m_BackOrder;
+        uint32 m_WaitingPlayers;
+    };
+
     /*
     This two dimensional array is used to store All queued groups
     First dimension specifies the bgTypeId
@@ -92,7 +134,16 @@ public:
          BG_QUEUE_NORMAL_ALLIANCE   is used for normal (or small) alliance groups or non-rated arena matches
          BG_QUEUE_NORMAL_HORDE      is used for normal (or small) horde groups or non-rated arena matches
     */
-    GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_MAX];
+    QueuedGroups m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_MAX];
+
+    // rated arena teams waiting for an opponent, of both factions, by matchmaker rating
+    typedef std::multimap<uint32, GroupQueueInfo*> ArenaTeamsByMMR;
+    ArenaTeamsByMMR m_ArenaTeamsByMMR[MAX_BATTLEGROUND_BRACKETS];
+
+    // finds the opponent for a rated arena team among the waiting ones, nullptr when none is acceptable yet
+    static GroupQueueInfo* FindArenaOpponent(GroupQueueInfo const* team, ArenaTeamsByMMR const& arenaTeams, uint32 maxDefaultRatingDifference, uint32 currMSTime, uint32 discardTime);
+
+    void SetGroupInvited(GroupQueueInfo* ginfo);
 
     // class to select and invite groups to bg
     class SelectionPool
@@ -101,6 +152,7 @@ public:
         SelectionPool(): PlayerCount(0) {};
         void Init();
         bool AddGroup(GroupQueueInfo* ginfo, uint32 desiredCount);
+        int64 AddGroups(QueuedGroups const& groups, int64 order, uint32 desiredCount);
         bool KickGroup(uint32 size);
         [[nodiscard]] uint32 GetPlayerCount() const { return PlayerCount; }
     public:
@@ -115,6 +167,11 @@ public:
     ArenaType GetArenaType() { return m_arenaType; }
     BattlegroundTypeId GetBGTypeID() { return m_bgTypeId; }
 private:
+    void AddToQueue(GroupQueueInfo* ginfo, uint8 groupType, bool front);
+    void RemoveFromQueue(GroupQueueInfo* ginfo);
+    void MoveInQueue(GroupQueueInfo* ginfo, uint8 groupType);
+    GroupQueueInfo* FindArenaOpponent(GroupQueueInfo* team, BattlegroundBracketId bracket_id, uint32 maxDefaultRatingDifference);
+
     BattlegroundTypeId m_bgTypeId;
     ArenaType m_arenaType;
     uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
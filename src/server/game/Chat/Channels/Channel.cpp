@@ -81,6 +81,89 @@ Channel::Channel(std::string const& name, uint32 channelId, uint32 channelDBId,
     }
 }
 
+Channel::PlayerContainer::iterator Channel::PlayerContainer::find(uint64 guid)
+{
+    auto itr = _slots.find(guid);
+    return itr != _slots.end() ? _members.begin() + itr->second : _members.end();
+}
+
+Channel::PlayerContainer::const_iterator Channel::PlayerContainer::find(uint64 guid) const
+{
+    auto itr = _slots.find(guid);
+    return itr != _slots.end() ? _members.begin() + itr->second : _members.end();
+}
+
+Channel::PlayerInfo& Channel::PlayerContainer::operator[](uint64 guid)
+{
+    auto itr = _slots.find(guid);
+    if (itr != _slots.end())
+        return _members[itr->second];
+
+    PlayerInfo pinfo = PlayerInfo();
+    pinfo.player = guid;
+    insert(pinfo);
+    return _members.back();
+}
+
+void Channel::PlayerContainer::insert(PlayerInfo const& pinfo)
+{
+    auto itr = _slots.find(pinfo.player);
+    if (itr != _slots.end())
+    {
+        _members[itr->second] = pinfo;
+        return;
+    }
+
+    _slots[pinfo.player] = _members.size();
+    _members.push_back(pinfo);
+
+    for (auto& ignoreMask : _ignoreMasks)
+        ignoreMask.second.push_back(pinfo.plrPtr && pinfo.plrPtr->GetSocial()->HasIgnore(ignoreMask.first));
+}
+
+void Channel::PlayerContainer::erase(uint64 guid)
+{
+    auto itr = _slots.find(guid);
+    if (itr == _slots.end())
+        return;
+
+    // the last member takes the free slot, in the ignore masks too
+    uint32 slot = itr->second;
+    _slots.erase(itr);
+    if (slot != _members.size() - 1)
+    {
+        _members[slot] = _members.back();
+        _slots[_members[slot].player] = slot;
+        for (auto& ignoreMask : _ignoreMasks)
+            ignoreMask.second[slot] = ignoreMask.second.back();
+    }
+
+    _members.pop_back();
+    for (auto& ignoreMask : _ignoreMasks)
+        ignoreMask.second.pop_back();
+
+    // only members can speak
+    _ignoreMasks.erase(GUID_LOPART(guid));
+}
+
+std::vector<bool> const& Channel::PlayerContainer::GetIgnoreMask(uint64 speaker)
+{
+    auto itr = _ignoreMasks.find(GUID_LOPART(speaker));
+    if (itr != _ignoreMasks.end())
+        return itr->second;
+
+    std::vector<bool>& ignoreMask = _ignoreMasks[GUID_LOPART(speaker)];
+    ignoreMask.reserve(_members.size());
+    for (PlayerInfo const& pinfo : _members)
+        ignoreMask.push_back(pinfo.plrPtr && pinfo.plrPtr->GetSocial()->HasIgnore(GUID_LOPART(speaker)));
+    return ignoreMask;
+}
+
+void Channel::PlayerContainer::InvalidateIgnoreMask(uint64 speaker)
+{
+    _ignoreMasks.erase(GUID_LOPART(speaker));
+}
+
 bool Channel::IsBanned(uint64 guid) const
 {
     BannedContainer::const_iterator itr = bannedStore.find(GUID_LOPART(guid));
@@ -202,7 +285,7 @@ void Channel::JoinChannel(Player* player, std::string const& pass)
     pinfo.lastSpeakTime = 0;
     pinfo.plrPtr = player;
 
-    playersStore[guid] = pinfo;
+    playersStore.insert(pinfo);
 
     if (_channelRights.joinMessage.length())
         ChatHandler(player->GetSession()).PSendSysMessage("%s", _channelRights.joinMessage.c_str());
@@ -291,12 +374,12 @@ void Channel::LeaveChannel(Player* player, bool send)
                 uint64 newowner = 0;
                 for (Channel::PlayerContainer::const_iterator itr = playersStore.begin(); itr != playersStore.end(); ++itr)
                 {
-                    newowner = itr->second.player;
-                    if (AccountMgr::IsGMAccount(itr->second.plrPtr->GetSession()->GetSecurity()))
+                    newowner = itr->player;
+                    if (AccountMgr::IsGMAccount(itr->plrPtr->GetSession()->GetSecurity()))
                         _isOwnerGM = true;
                     else
                         _isOwnerGM = false;
-                    if (!itr->second.plrPtr->GetSession()->GetSecurity())
+                    if (!itr->plrPtr->GetSession()->GetSecurity())
                         break;
                 }
                 SetOwner(newowner);
@@ -452,8 +535,8 @@ void Channel::KickOrBan(Player const* player, std::string const& badname, bool b
             uint64 newowner = 0;
             for (Channel::PlayerContainer::const_iterator itr = playersStore.begin(); itr != playersStore.end(); ++itr)
             {
-                newowner = itr->second.player;
-                if (!itr->second.plrPtr->GetSession()->GetSecurity())
+                newowner = itr->player;
+                if (!itr->plrPtr->GetSession()->GetSecurity())
                     break;
             }
             SetOwner(newowner);
@@ -709,10 +792,10 @@ void Channel::List(Player const* player)
     uint32 count  = 0;
     if (!(_channelRights.flags & CHANNEL_RIGHT_CANT_SPEAK))
         for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-            if (AccountMgr::IsPlayerAccount(i->second.plrPtr->GetSession()->GetSecurity()))
+            if (AccountMgr::IsPlayerAccount(i->plrPtr->GetSession()->GetSecurity()))
             {
-                data << uint64(i->first);
-                data << uint8(i->second.flags); // flags seems to be changed...
+                data << uint64(i->player);
+                data << uint8(i->flags); // flags seems to be changed...
                 ++count;
             }
 
@@ -837,9 +920,9 @@ void Channel::EveryoneSayToSelf(const char* what)
 
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
     {
-        data.put(5, i->first);
-        data.put(17 + _name.size() + 1, i->first);
-        i->second.plrPtr->GetSession()->SendPacket(&data);
+        data.put(5, i->player);
+        data.put(17 + _name.size() + 1, i->player);
+        i->plrPtr->GetSession()->SendPacket(&data);
     }
 }
 
@@ -909,8 +992,8 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
         PlayerContainer::iterator p_itr = playersStore.find(_ownerGUID);
         if (p_itr != playersStore.end())
         {
-            p_itr->second.SetOwner(false);
-            FlagsNotify(p_itr->second.plrPtr);
+            p_itr->SetOwner(false);
+            FlagsNotify(p_itr->plrPtr);
         }
     }
 
@@ -952,16 +1035,28 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, uint64 guid)
 {
+    // sent from the world thread, which owns the sessions: every member socket encrypts its own header
+    // and references the payload, copied once for the whole channel
+    SharedWorldPacket packet(*data);
+    if (!guid)
+    {
+        for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
+            i->plrPtr->GetSession()->SendPacket(packet);
+        return;
+    }
+
+    std::vector<bool> const& ignores = playersStore.GetIgnoreMask(guid);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (!guid || !i->second.plrPtr->GetSocial()->HasIgnore(GUID_LOPART(guid)))
-            i->second.plrPtr->GetSession()->SendPacket(data);
+        if (!ignores[i - playersStore.begin()])
+            i->plrPtr->GetSession()->SendPacket(packet);
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
+    SharedWorldPacket packet(*data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (i->first != who)
-            i->second.plrPtr->GetSession()->SendPacket(data);
+        if (i->player != who)
+            i->plrPtr->GetSession()->SendPacket(packet);
 }
 
 void Channel::SendToOne(WorldPacket* data, uint64 who)
@@ -972,8 +1067,9 @@ void Channel::SendToOne(WorldPacket* data, uint64 who)
 
 void Channel::SendToAllWatching(WorldPacket* data)
 {
+    SharedWorldPacket packet(*data);
     for (PlayersWatchingContainer::const_iterator i = playersWatchingStore.begin(); i != playersWatchingStore.end(); ++i)
-        (*i)->GetSession()->SendPacket(data);
+        (*i)->GetSession()->SendPacket(packet);
 }
 
 void Channel::Voice(uint64 /*guid1*/, uint64 /*guid2*/)
@@ -13,6 +13,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 class Player;
 
@@ -176,6 +177,36 @@ class Channel
         bool _gmStatus = false;
     };
 
+    // members in one array for the fan-out, leaving members are replaced by the last one.
+    // Per speaker, a bit for every member ignoring it, built on its first message and kept in step with joins and leaves
+    class PlayerContainer
+    {
+    public:
+        typedef std::vector<PlayerInfo>::iterator iterator;
+        typedef std::vector<PlayerInfo>::const_iterator const_iterator;
+
+        iterator begin() { return _members.begin(); }
+        iterator end() { return _members.end(); }
+        const_iterator begin() const { return _members.begin(); }
+        const_iterator end() const { return _members.end(); }
+        std::size_t size() const { return _members.size(); }
+        bool empty() const { return _members.empty(); }
+
+        iterator find(uint64 guid);
+        const_iterator find(uint64 guid) const;
+        PlayerInfo& operator[](uint64 guid);                // adds the member if not on the channel
+        void insert(PlayerInfo const& pinfo);
+        void erase(uint64 guid);
+
+        std::vector<bool> const& GetIgnoreMask(uint64 speaker);
+        void InvalidateIgnoreMask(uint64 speaker);
+
+    private:
+        std::vector<PlayerInfo> _members;
+        std::unordered_map<uint64, uint32> _slots;
+        std::unordered_map<uint32, std::vector<bool>> _ignoreMasks;
+    };
+
 public:
     Channel(std::string const& name, uint32 channel_id, uint32 channelDBId, TeamId teamId = TEAM_NEUTRAL, bool announce = true, bool ownership = true);
     std::string const& GetName() const { return _name; }
@@ -218,6 +249,8 @@ public:
     void FlagsNotify(Player* p);
     static void CleanOldChannelsInDB();
     void ToggleModeration(Player* p);
+    // a member added or removed guid from its ignore list
+    void InvalidateIgnores(uint64 guid) { playersStore.InvalidateIgnoreMask(guid); }
 
     // pussywizard:
     void AddWatching(Player* p);
@@ -280,7 +313,7 @@ private:
     uint8 GetPlayerFlags(uint64 guid) const
     {
         PlayerContainer::const_iterator itr = playersStore.find(guid);
-        return itr != playersStore.end() ? itr->second.flags : 0;
+        return itr != playersStore.end() ? itr->flags : 0;
     }
 
     void SetModerator(uint64 guid, bool set)
@@ -313,7 +346,6 @@ private:
         }
     }
 
-    typedef std::unordered_map<uint64, PlayerInfo> PlayerContainer;
     typedef std::unordered_map<uint32, uint32> BannedContainer;
     typedef std::unordered_set<Player*> PlayersWatchingContainer;
 
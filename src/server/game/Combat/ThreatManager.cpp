@@ -4,6 +4,7 @@
  * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
  */
 
+#include "Containers.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "Map.h"
@@ -275,12 +276,27 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 }
 
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Check if the list is dirty and restore the order if necessary
+// Between two updates usually only a few references change their threat,
+// so the entries out of place are moved to their new position instead of
+// sorting the whole list again
 
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(acore::ThreatOrderPred());
+    {
+        acore::ThreatOrderPred pred;
+
+        size_t outOfOrder = 0;
+        for (StorageType::const_iterator itr = std::next(iThreatList.begin()); itr != iThreatList.end(); ++itr)
+            if (pred(*itr, *std::prev(itr)))
+                ++outOfOrder;
+
+        if (outOfOrder > THREAT_INCREMENTAL_SORT_LIMIT)
+            std::stable_sort(iThreatList.begin(), iThreatList.end(), pred);
+        else if (outOfOrder)
+            acore::Containers::InsertionSort(iThreatList, pred);
+    }
 
     iDirty = false;
 }
@@ -597,8 +613,8 @@ void ThreatManager::resetAllAggro()
     if (threatList.empty())
         return;
 
-    for (ThreatContainer::StorageType::iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
-        (*itr)->setThreat(0);
+    for (size_t i = 0; i < threatList.size(); ++i)
+        threatList[i]->setThreat(0);
 
     setDirty(true);
 }
@@ -11,7 +11,7 @@
 #include "LinkedReference/Reference.h"
 #include "SharedDefines.h"
 #include "UnitEvents.h"
-#include <list>
+#include <vector>
 
 //==============================================================
 
@@ -21,6 +21,7 @@ class ThreatManager;
 class SpellInfo;
 
 #define THREAT_UPDATE_INTERVAL 2 * IN_MILLISECONDS    // Server should send threat update to client periodically each second
+#define THREAT_INCREMENTAL_SORT_LIMIT 8                // Above this many misplaced references the threat list is fully sorted again
 
 //==============================================================
 // Class to calculate the real threat based
@@ -125,7 +126,7 @@ class ThreatContainer
     friend class ThreatManager;
 
 public:
-    typedef std::list<HostileReference*> StorageType;
+    typedef std::vector<HostileReference*> StorageType;
 
     ThreatContainer() { }
 
@@ -156,9 +157,16 @@ public:
     [[nodiscard]] StorageType const& getThreatList() const { return iThreatList; }
 
 private:
+    friend class ThreatContainerTest;                   // unit tests of the threat order
+
+    // Restore the threat order of the list if necessary
+    void update();
+
     void remove(HostileReference* hostileRef)
     {
-        iThreatList.remove(hostileRef);
+        StorageType::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), hostileRef);
+        if (itr != iThreatList.end())
+            iThreatList.erase(itr);
     }
 
     void addReference(HostileReference* hostileRef)
@@ -168,9 +176,6 @@ private:
 
     void clearReferences();
 
-    // Sort the list if necessary
-    void update();
-
     StorageType iThreatList;
     bool iDirty{false};
 };
@@ -228,8 +233,9 @@ public:
         if (threatList.empty())
             return;
 
-        for (auto ref : threatList)
+        for (size_t i = 0; i < threatList.size(); ++i)
         {
+            HostileReference* ref = threatList[i];
             if (predicate(ref->getTarget()))
             {
                 ref->setThreat(0);
@@ -240,6 +246,7 @@ public:
 
     // methods to access the lists from the outside to do some dirty manipulation (scriping and such)
     // I hope they are used as little as possible.
+    // Adding threat to a pet may append its owner to the threat list, which moves the vector: copy it before adding threat in a loop over it
     [[nodiscard]] ThreatContainer::StorageType const& getThreatList() const { return iThreatContainer.getThreatList(); }
     [[nodiscard]] ThreatContainer::StorageType const& getOfflineThreatList() const { return iThreatOfflineContainer.getThreatList(); }
     ThreatContainer& getOnlineContainer() { return iThreatContainer; }
@@ -686,49 +686,104 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& co
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions)
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> ElseGroupStore;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    // loot items carry a copy of their template list, every condition being added to a single list its first one identifies it.
+    // A list only starting with the same condition (a script adding to a stored list) is not that copy.
+    auto copied = _compiledListCopies.find(conditions.front());
+    if (copied != _compiledListCopies.end() && *copied->second == conditions)
     {
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-        LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", (*i)->ConditionType, (*i)->ConditionValue1);
-#endif
-        if ((*i)->isLoaded())
-        {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = ElseGroupStore.find((*i)->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == ElseGroupStore.end())
-                ElseGroupStore[(*i)->ElseGroup] = true;
-            else if (!(*itr).second)
-                continue;
+        auto compiled = _compiledLists.find(copied->second);
+        ASSERT(compiled != _compiledLists.end());
+        return compiled->second.Run(sourceInfo);
+    }
+
+    // lists built after the conditions were loaded (scripts) are compiled on the fly
+    ConditionProgram program;
+    CompileConditionList(conditions, program);
+    return program.Run(sourceInfo);
+}
+
+void ConditionMgr::CompileConditionList(ConditionList const& conditions, ConditionProgram& program) const
+{
+    program.Compile(conditions, ConditionReferenceStore, _compiledLists);
+}
+
+void ConditionProgram::Compile(ConditionList const& conditions, ConditionReferenceContainer const& references, ConditionProgramContainer const& compiledLists)
+{
+    Steps.clear();
+    Steps.reserve(conditions.size());
 
-            if ((*i)->ReferenceId)//handle reference
+    uint32 position = 0;
+    for (Condition* condition : conditions)
+    {
+        ++position;
+        if (!condition->isLoaded())
+            continue;
+
+        ConditionProgram const* reference = nullptr;
+        if (condition->ReferenceId)
+        {
+            ConditionReferenceContainer::const_iterator ref = references.find(condition->ReferenceId);
+            if (ref != references.end())
             {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
-                        ElseGroupStore[(*i)->ElseGroup] = false;
-                }
-                else
-                {
+                auto compiled = compiledLists.find(&ref->second);
+                ASSERT(compiled != compiledLists.end());
+                reference = &compiled->second;
+            }
+        }
+
+        Steps.push_back({ condition, reference, position, 0 });
+    }
+
+    std::stable_sort(Steps.begin(), Steps.end(), [](Step const& left, Step const& right)
+    {
+        return left.Cond->ElseGroup < right.Cond->ElseGroup;
+    });
+
+    uint32 nextGroup = Steps.size();
+    for (uint32 i = Steps.size(); i > 0; --i)
+    {
+        Steps[i - 1].NextGroup = nextGroup;
+        if (i > 1 && Steps[i - 2].Cond->ElseGroup != Steps[i - 1].Cond->ElseGroup)
+            nextGroup = i - 1;
+    }
+}
+
+bool ConditionProgram::Run(ConditionSourceInfo& sourceInfo) const
+{
+    // the groups do not run in list order, keep the failure a list walk would have reported last
+    Condition* lastFailedCondition = sourceInfo.mLastFailedCondition;
+    uint32 lastFailedPosition = 0;
+
+    for (uint32 i = 0; i < Steps.size();)
+    {
+        Step const& step = Steps[i];
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                    LOG_DEBUG("condition", "IsPlayerMeetToConditionList: Reference template -%u not found", (*i)->ReferenceId);
+        LOG_DEBUG("condition", "ConditionProgram::Run condType: %u val1: %u", step.Cond->ConditionType, step.Cond->ConditionValue1);
 #endif
-                }
-            }
-            else //handle normal condition
-            {
-                if (!(*i)->Meets(sourceInfo))
-                    ElseGroupStore[(*i)->ElseGroup] = false;
-            }
+        bool meets;
+        if (step.Cond->ReferenceId)
+            meets = !step.Reference || step.Reference->Run(sourceInfo);
+        else
+            meets = step.Cond->Meets(sourceInfo);
+
+        if (meets)
+        {
+            // every condition of the group passed
+            if (++i == step.NextGroup)
+                return true;
+            continue;
+        }
+
+        if (step.ListPosition > lastFailedPosition)
+        {
+            lastFailedPosition = step.ListPosition;
+            lastFailedCondition = sourceInfo.mLastFailedCondition;
         }
+
+        i = step.NextGroup;
     }
-    for (std::map<uint32, bool>::const_iterator i = ElseGroupStore.begin(); i != ElseGroupStore.end(); ++i)
-        if (i->second)
-            return true;
 
+    sourceInfo.mLastFailedCondition = lastFailedCondition;
     return false;
 }
 
@@ -752,6 +807,10 @@ bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, Con
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
     LOG_DEBUG("condition", "ConditionMgr::IsObjectMeetToConditions");
 #endif
+    auto compiled = _compiledLists.find(&conditions);
+    if (compiled != _compiledLists.end())
+        return compiled->second.Run(sourceInfo);
+
     return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
@@ -783,95 +842,93 @@ bool ConditionMgr::CanHaveSourceIdSet(ConditionSourceType sourceType) const
     return (sourceType == CONDITION_SOURCE_TYPE_SMART_EVENT);
 }
 
-ConditionList ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry)
+ConditionList const& ConditionMgr::FindConditions(ConditionStoreKey const& key) const
 {
-    ConditionList spellCond;
-    if (sourceType > CONDITION_SOURCE_TYPE_NONE && sourceType < CONDITION_SOURCE_TYPE_MAX)
-    {
-        ConditionContainer::const_iterator itr = ConditionStore.find(sourceType);
-        if (itr != ConditionStore.end())
-        {
-            ConditionTypeContainer::const_iterator i = (*itr).second.find(entry);
-            if (i != (*itr).second.end())
-            {
-                spellCond = (*i).second;
+    static ConditionList const noConditions;
+
+    auto itr = _conditionIndex.find(key);
+    if (itr == _conditionIndex.end())
+        return noConditions;
+
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                LOG_DEBUG("condition", "GetConditionsForNotGroupedEntry: found conditions for type %u and entry %u", uint32(sourceType), entry);
+    LOG_DEBUG("condition", "ConditionMgr::FindConditions: found conditions for source type %u group %d id %u entry %u", uint32(key.SourceType), key.SourceGroup, key.SourceId, key.SourceEntry);
 #endif
-            }
-        }
-    }
-    return spellCond;
+    return *itr->second;
 }
 
-ConditionList ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId)
+ConditionList const& ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const
 {
-    ConditionList cond;
-    CreatureSpellConditionContainer::const_iterator itr = SpellClickEventConditionStore.find(creatureId);
-    if (itr != SpellClickEventConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-            LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for Vehicle entry %u spell %u", creatureId, spellId);
-#endif
-        }
-    }
-    return cond;
+    return FindConditions({ sourceType, 0, 0, entry });
 }
 
-ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId)
+ConditionList const& ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const
 {
-    ConditionList cond;
-    CreatureSpellConditionContainer::const_iterator itr = VehicleSpellConditionStore.find(creatureId);
-    if (itr != VehicleSpellConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-            LOG_DEBUG("condition", "GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureId, spellId);
-#endif
-        }
-    }
-    return cond;
+    return FindConditions({ CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT, int32(creatureId), 0, spellId });
 }
 
-ConditionList ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType)
+ConditionList const& ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId) const
 {
-    ConditionList cond;
-    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
-    if (itr != SmartEventConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(eventId + 1);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-            LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid %d event_id %u", entryOrGuid, eventId);
-#endif
-        }
-    }
-    return cond;
+    return FindConditions({ CONDITION_SOURCE_TYPE_VEHICLE_SPELL, int32(creatureId), 0, spellId });
 }
 
-ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId)
+ConditionList const& ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const
 {
-    ConditionList cond;
-    NpcVendorConditionContainer::const_iterator itr = NpcVendorConditionContainerStore.find(creatureId);
-    if (itr != NpcVendorConditionContainerStore.end())
+    return FindConditions({ CONDITION_SOURCE_TYPE_SMART_EVENT, entryOrGuid, sourceType, eventId + 1 });
+}
+
+ConditionList const& ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId) const
+{
+    return FindConditions({ CONDITION_SOURCE_TYPE_NPC_VENDOR, int32(creatureId), 0, itemId });
+}
+
+void ConditionMgr::CompileConditions()
+{
+    // the lists held outside of the stores (loot, gossip, spell targets) are the only ones registered so far
+    std::vector<ConditionList const*> heldLists;
+    heldLists.reserve(_compiledLists.size());
+    for (auto const& held : _compiledLists)
+        heldLists.push_back(held.first);
+
+    // reference templates first, with their programs created upfront so references to each other can be resolved
+    for (ConditionReferenceContainer::const_iterator itr = ConditionReferenceStore.begin(); itr != ConditionReferenceStore.end(); ++itr)
+        _compiledLists[&itr->second];
+
+    for (ConditionReferenceContainer::const_iterator itr = ConditionReferenceStore.begin(); itr != ConditionReferenceStore.end(); ++itr)
+        CompileConditionList(itr->second, _compiledLists[&itr->second]);
+
+    for (ConditionList const* conditions : heldLists)
     {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(itemId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            LOG_DEBUG("condition", "GetConditionsForNpcVendorEvent: found conditions for creature entry %u item %u", creatureId, itemId);
-        }
+        ConditionProgram& program = _compiledLists[conditions];
+        CompileConditionList(*conditions, program);
+        if (!conditions->empty())
+            _compiledListCopies[conditions->front()] = conditions;
     }
-    return cond;
+
+    auto addList = [this](ConditionStoreKey const& key, ConditionList const& conditions)
+    {
+        _conditionIndex[key] = &conditions;
+        CompileConditionList(conditions, _compiledLists[&conditions]);
+    };
+
+    for (ConditionContainer::const_iterator itr = ConditionStore.begin(); itr != ConditionStore.end(); ++itr)
+        for (ConditionTypeContainer::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            addList({ itr->first, 0, 0, it->first }, it->second);
+
+    for (CreatureSpellConditionContainer::const_iterator itr = SpellClickEventConditionStore.begin(); itr != SpellClickEventConditionStore.end(); ++itr)
+        for (ConditionTypeContainer::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            addList({ CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT, int32(itr->first), 0, it->first }, it->second);
+
+    for (CreatureSpellConditionContainer::const_iterator itr = VehicleSpellConditionStore.begin(); itr != VehicleSpellConditionStore.end(); ++itr)
+        for (ConditionTypeContainer::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            addList({ CONDITION_SOURCE_TYPE_VEHICLE_SPELL, int32(itr->first), 0, it->first }, it->second);
+
+    for (SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.begin(); itr != SmartEventConditionStore.end(); ++itr)
+        for (ConditionTypeContainer::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            addList({ CONDITION_SOURCE_TYPE_SMART_EVENT, itr->first.first, itr->first.second, it->first }, it->second);
+
+    for (NpcVendorConditionContainer::const_iterator itr = NpcVendorConditionContainerStore.begin(); itr != NpcVendorConditionContainerStore.end(); ++itr)
+        for (ConditionTypeContainer::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            addList({ CONDITION_SOURCE_TYPE_NPC_VENDOR, int32(itr->first), 0, it->first }, it->second);
 }
 
 void ConditionMgr::LoadConditions(bool isReload)
@@ -1141,6 +1198,8 @@ void ConditionMgr::LoadConditions(bool isReload)
         ++count;
     } while (result->NextRow());
 
+    CompileConditions();
+
     LOG_INFO("server", ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server", " ");
 }
@@ -1153,8 +1212,11 @@ bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot)
         return false;
     }
 
-    if (loot->addConditionItem(cond))
+    if (ConditionList* conditions = loot->addConditionItem(cond))
+    {
+        _compiledLists[conditions];
         return true;
+    }
 
     LOG_ERROR("sql.sql", "ConditionMgr: Item %u not found in LootTemplate %u", cond->SourceEntry, cond->SourceGroup);
     return false;
@@ -1171,6 +1233,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond)
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.TextID == uint32(cond->SourceEntry))
             {
                 (*itr).second.Conditions.push_back(cond);
+                _compiledLists[&(*itr).second.Conditions];
                 return true;
             }
         }
@@ -1190,6 +1253,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond)
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.OptionID == uint32(cond->SourceEntry))
             {
                 (*itr).second.Conditions.push_back(cond);
+                _compiledLists[&(*itr).second.Conditions];
                 return true;
             }
         }
@@ -1274,10 +1338,16 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond)
                 }
 
                 if (!assigned)
+                {
                     delete sharedList;
+                    sharedList = nullptr;
+                }
             }
             if (sharedList)
+            {
                 sharedList->push_back(cond);
+                _compiledLists[sharedList];
+            }
             break;
         }
     }
@@ -2248,6 +2318,10 @@ bool ConditionMgr::isConditionTypeValid(Condition* cond)
 
 void ConditionMgr::Clean()
 {
+    _conditionIndex.clear();
+    _compiledLists.clear();
+    _compiledListCopies.clear();
+
     for (ConditionReferenceContainer::iterator itr = ConditionReferenceStore.begin(); itr != ConditionReferenceStore.end(); ++itr)
     {
         for (ConditionList::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
@@ -11,6 +11,8 @@
 #include "Errors.h"
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 class Player;
 class Unit;
@@ -227,6 +229,55 @@ typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionTypeCont
 
 typedef std::map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
 
+struct ConditionProgram;
+typedef std::unordered_map<ConditionList const*, ConditionProgram> ConditionProgramContainer;
+
+/*
+ * A ConditionList flattened at load: the loaded conditions ordered by else group, keeping the list order inside a group.
+ * A group is abandoned at its first failed step and the evaluation ends with the first group that passes.
+ */
+struct ConditionProgram
+{
+    struct Step
+    {
+        Condition* Cond;
+        ConditionProgram const* Reference;  // compiled reference template, nullptr for a plain condition or a missing template
+        uint32 ListPosition;                // position in the source list, to report the same failed condition as a list walk
+        uint32 NextGroup;                   // first step of the next else group
+    };
+
+    std::vector<Step> Steps;
+
+    // the reference templates of the list must be in compiledLists already, they may still be empty
+    void Compile(ConditionList const& conditions, ConditionReferenceContainer const& references, ConditionProgramContainer const& compiledLists);
+    // same result and same mLastFailedCondition as walking the source list
+    bool Run(ConditionSourceInfo& sourceInfo) const;
+};
+
+/// (source type, source group, source id, source entry) of the lists stored by ConditionMgr
+struct ConditionStoreKey
+{
+    ConditionSourceType SourceType;
+    int32 SourceGroup;
+    uint32 SourceId;
+    uint32 SourceEntry;
+
+    bool operator==(ConditionStoreKey const& right) const
+    {
+        return SourceType == right.SourceType && SourceGroup == right.SourceGroup && SourceId == right.SourceId && SourceEntry == right.SourceEntry;
+    }
+};
+
+struct ConditionStoreKeyHash
+{
+    std::size_t operator()(ConditionStoreKey const& key) const
+    {
+        uint64 high = (uint64(key.SourceType) << 32) | key.SourceId;
+        uint64 low = (uint64(uint32(key.SourceGroup)) << 32) | key.SourceEntry;
+        return std::hash<uint64>()(high * 0x9E3779B97F4A7C15ULL ^ low);
+    }
+};
+
 class ConditionMgr
 {
 private:
@@ -246,11 +297,12 @@ public:
     bool IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
     [[nodiscard]] bool CanHaveSourceGroupSet(ConditionSourceType sourceType) const;
     [[nodiscard]] bool CanHaveSourceIdSet(ConditionSourceType sourceType) const;
-    ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
-    ConditionList GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
-    ConditionList GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType);
-    ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
-    ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
+    // the returned lists stay valid until the conditions are reloaded, evaluating them directly uses their compiled form
+    ConditionList const& GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const;
+    ConditionList const& GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const;
+    ConditionList const& GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const;
+    ConditionList const& GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId) const;
+    ConditionList const& GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId) const;
 
 private:
     bool isSourceTypeValid(Condition* cond);
@@ -260,6 +312,10 @@ private:
     bool addToSpellImplicitTargetConditions(Condition* cond);
     bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
 
+    ConditionList const& FindConditions(ConditionStoreKey const& key) const;
+    void CompileConditions();
+    void CompileConditionList(ConditionList const& conditions, ConditionProgram& program) const;
+
     void Clean(); // free up resources
     std::list<Condition*> AllocatedMemoryStore; // some garbage collection :)
 
@@ -269,6 +325,13 @@ private:
     CreatureSpellConditionContainer   SpellClickEventConditionStore;
     NpcVendorConditionContainer       NpcVendorConditionContainerStore;
     SmartEventConditionContainer      SmartEventConditionStore;
+
+    // built from the stores above once the conditions are loaded
+    std::unordered_map<ConditionStoreKey, ConditionList const*, ConditionStoreKeyHash> _conditionIndex;
+    // the lists held outside of the stores are registered by the addTo* functions and compiled with the others
+    ConditionProgramContainer _compiledLists;
+    // loot items evaluate a copy of their template list, found by its first condition
+    std::unordered_map<Condition const*, ConditionList const*> _compiledListCopies;
 };
 
 #define sConditionMgr ConditionMgr::instance()
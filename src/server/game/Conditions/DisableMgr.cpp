@@ -116,6 +116,7 @@ namespace DisableMgr
                     {
                         SpellInfo* spellInfo = const_cast<SpellInfo*>(sSpellMgr->GetSpellInfo(entry));
                         spellInfo->AttributesEx2 |= SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS;
+                        sSpellMgr->RefreshSpellHotInfo(spellInfo);
                     }
 
                     break;
@@ -317,58 +317,89 @@ namespace lfg
                     BootsStore.erase(itBoot);
                 }
             }
-        }
-        else if (task == 1)
-        {
-            this->lastProposalId = m_lfgProposalId; // pussywizard: task 2 is done independantly, store previous value in LFGMgr for future use
-            uint8 newGroupsProcessed = 0;
-            // Check if a proposal can be formed with the new groups being added
-            for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
-            {
-                newGroupsProcessed += it->second.FindGroups();
-                if (newGroupsProcessed)
-                    break;
-            }
 
-            // Update all players status queue info
-            if (!newGroupsProcessed) // don't do this on updates that precessed groups (performance)
-                for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
-                    it->second.UpdateQueueTimers(tdiff);
+            // Update all players status queue info, remove the ones queued for too long
+            LfgGuidList expired;
+            for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+                it->UpdateQueueTimers(tdiff, expired);
+            for (LfgGuidList::const_iterator it = expired.begin(); it != expired.end(); ++it)
+                LeaveAllLfgQueues(*it, true);
         }
         else if (task == 2)
         {
-            if (lastProposalId != m_lfgProposalId)
+            // Proposals found by the matchmaking thread, players may have left or changed state meanwhile
+            LfgProposalList proposals;
+            for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+                it->TakeProposals(proposals);
+
+            for (LfgProposalList::iterator itProposal = proposals.begin(); itProposal != proposals.end(); ++itProposal)
             {
-                // pussywizard: only one proposal can be created in World::Update (during maps update), and it has id == m_lfgProposalId, so try to find only that one, dunno why for loop here xD
-                for (LfgProposalContainer::const_iterator itProposal = ProposalsStore.find(m_lfgProposalId); itProposal != ProposalsStore.end(); ++itProposal)
+                LfgProposal& proposal = *itProposal;
+                if (!AllQueued(proposal.queues)) // can't create proposal
                 {
-                    uint32 proposalId = itProposal->first;
-                    LfgProposal& proposal = ProposalsStore[proposalId];
+                    for (uint8 i = 0; i < 5 && proposal.queues.guid[i]; ++i)
+                        if (GetState(proposal.queues.guid[i]) == LFG_STATE_QUEUED)
+                            GetQueue(proposal.queues.guid[i]).AddToQueue(proposal.queues.guid[i], true);
+                    continue;
+                }
 
-                    uint64 guid = 0;
-                    for (LfgProposalPlayerContainer::const_iterator itPlayers = proposal.players.begin(); itPlayers != proposal.players.end(); ++itPlayers)
+                if (!proposal.isNew)
+                {
+                    proposal.isNew = GetOldState(proposal.group) != LFG_STATE_DUNGEON;
+                    if (!proposal.isNew)
+                        for (LfgProposalPlayerContainer::iterator itPlayers = proposal.players.begin(); itPlayers != proposal.players.end(); ++itPlayers)
+                            if (itPlayers->second.group && itPlayers->second.group == proposal.group) // Player from existing group, autoaccept
+                                itPlayers->second.accept = LFG_ANSWER_AGREE;
+                }
+
+                uint32 proposalId = AddProposal(proposal);
+                LfgProposal& stored = ProposalsStore[proposalId];
+
+                uint64 guid = 0;
+                for (LfgProposalPlayerContainer::const_iterator itPlayers = stored.players.begin(); itPlayers != stored.players.end(); ++itPlayers)
+                {
+                    guid = itPlayers->first;
+                    SetState(guid, LFG_STATE_PROPOSAL);
+                    if (uint64 gguid = GetGroup(guid))
                     {
-                        guid = itPlayers->first;
-                        SetState(guid, LFG_STATE_PROPOSAL);
-                        if (uint64 gguid = GetGroup(guid))
-                        {
-                            SetState(gguid, LFG_STATE_PROPOSAL);
-                            SendLfgUpdateParty(guid, LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
-                        }
-                        else
-                            SendLfgUpdatePlayer(guid, LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
-                        SendLfgUpdateProposal(guid, proposal);
+                        SetState(gguid, LFG_STATE_PROPOSAL);
+                        SendLfgUpdateParty(guid, LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
                     }
-
-                    if (proposal.state == LFG_PROPOSAL_SUCCESS) // pussywizard: no idea what's the purpose of this xD
-                        UpdateProposal(proposalId, guid, true);
+                    else
+                        SendLfgUpdatePlayer(guid, LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
+                    SendLfgUpdateProposal(guid, stored);
                 }
+
+                if (stored.state == LFG_PROPOSAL_SUCCESS) // pussywizard: no idea what's the purpose of this xD
+                    UpdateProposal(proposalId, guid, true);
             }
 
             UpdateRaidBrowser(tdiff);
         }
     }
 
+    /**
+        Runs on the matchmaking thread, looks for groups in the queues of both factions
+
+       @return Whether a new group was processed
+    */
+    bool LFGMgr::UpdateMatchmaking()
+    {
+        if (!isOptionEnabled(LFG_OPTION_ENABLE_DUNGEON_FINDER | LFG_OPTION_ENABLE_RAID_BROWSER))
+            return false;
+
+        uint8 newGroupsProcessed = 0;
+        // Check if a proposal can be formed with the new groups being added
+        for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+            newGroupsProcessed += it->FindGroups();
+
+        if (!newGroupsProcessed) // don't do this on updates that precessed groups (performance)
+            for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+                it->RefreshCompatibles();
+
+        return newGroupsProcessed;
+    }
+
     /**
         Generate the dungeon lock map for a given player
 
@@ -1300,10 +1331,10 @@ namespace lfg
 
         if (pguid)
             for (lfg::LfgQueueContainer::iterator itr = QueuesStore.begin(); itr != QueuesStore.end(); ++itr)
-                itr->second.RemoveFromQueue(pguid);
+                itr->RemoveFromQueue(pguid);
         if (gguid)
             for (lfg::LfgQueueContainer::iterator itr = QueuesStore.begin(); itr != QueuesStore.end(); ++itr)
-                itr->second.RemoveFromQueue(gguid);
+                itr->RemoveFromQueue(gguid);
 
         if (pguid && !gguid)
         {
@@ -2494,6 +2525,31 @@ namespace lfg
         return PlayersStore[guid].GetRandomPlayersCount();
     }
 
+    void LFGMgr::AddIgnore(uint64 guid, uint32 ignoreGuid)
+    {
+        uint64 gguid = GetGroup(guid);
+        uint64 queueGuid = gguid && GetState(gguid) == LFG_STATE_QUEUED ? gguid : guid;
+        if (GetState(queueGuid) == LFG_STATE_QUEUED)
+            GetQueue(queueGuid).AddIgnore(queueGuid, ignoreGuid);
+    }
+
+    void LFGMgr::RemoveIgnore(uint64 guid, uint32 ignoreGuid)
+    {
+        uint64 gguid = GetGroup(guid);
+        uint64 queueGuid = gguid && GetState(gguid) == LFG_STATE_QUEUED ? gguid : guid;
+        if (GetState(queueGuid) != LFG_STATE_QUEUED)
+            return;
+
+        // the queue keeps the ignores of the whole group
+        if (queueGuid != guid)
+            for (uint64 memberGuid : GetPlayers(queueGuid))
+                if (Player* member = ObjectAccessor::FindPlayerInOrOutOfWorld(memberGuid))
+                    if (member->GetSocial()->HasIgnore(ignoreGuid))
+                        return;
+
+        GetQueue(queueGuid).RemoveIgnore(queueGuid, ignoreGuid);
+    }
+
     bool LFGMgr::HasIgnore(uint64 guid1, uint64 guid2)
     {
         Player* plr1 = ObjectAccessor::FindPlayerInOrOutOfWorld(guid1);
@@ -2597,7 +2653,8 @@ namespace lfg
     // Only for debugging purposes
     void LFGMgr::Clean()
     {
-        QueuesStore.clear();
+        for (LfgQueueContainer::iterator itr = QueuesStore.begin(); itr != QueuesStore.end(); ++itr)
+            itr->Clear();
     }
 
     bool LFGMgr::isOptionEnabled(uint32 option)
@@ -14,6 +14,8 @@
 #include "LFGPlayerData.h"
 #include "LFGQueue.h"
 #include "Map.h"
+#include <array>
+#include <atomic>
 
 class Group;
 class Player;
@@ -238,7 +240,7 @@ namespace lfg
     struct LfgProposalPlayer;
     struct LfgPlayerBoot;
 
-    typedef std::map<uint8, LFGQueue> LfgQueueContainer;
+    typedef std::array<LFGQueue, 2> LfgQueueContainer;
     typedef std::multimap<uint32, LfgReward const*> LfgRewardContainer;
     typedef std::pair<LfgRewardContainer::const_iterator, LfgRewardContainer::const_iterator> LfgRewardContainerBounds;
     typedef std::map<uint8, LfgDungeonSet> LfgCachedDungeonContainer;
@@ -420,6 +422,7 @@ namespace lfg
 
         // Functions used outside lfg namespace
         void Update(uint32 diff, uint8 task);
+        bool UpdateMatchmaking();
 
         // World.cpp
         /// Finish the dungeon for the given group. All check are performed using internal lfg data
@@ -498,6 +501,12 @@ namespace lfg
         bool IsSeasonActive(uint32 dungeonId);
         /// Gets the random dungeon reward corresponding to given dungeon and player level
         LfgReward const* GetRandomDungeonReward(uint32 dungeon, uint8 level);
+
+        // Socialhandler
+        /// Adds a new ignore to the queue data of a queued player or its group
+        void AddIgnore(uint64 guid, uint32 ignoreGuid);
+        /// Removes an ignore from the queued data, unless another member of the queued group still has it
+        void RemoveIgnore(uint64 guid, uint32 ignoreGuid);
         /// Returns all random and seasonal dungeons for given level and expansion
         LfgDungeonSet GetRandomAndSeasonalDungeons(uint8 level, uint8 expansion);
         /// Teleport a player to/from selected dungeon
@@ -587,8 +596,7 @@ namespace lfg
 
         // General variables
         uint32 m_lfgProposalId;                            ///< used as internal counter for proposals
-        uint32 m_options;                                  ///< Stores config options
-        uint32 lastProposalId;                             ///< pussywizard, store it here because of splitting LFGMgr update into tasks
+        std::atomic<uint32> m_options;                     ///< Stores config options, also read by the matchmaking thread
         uint32 m_raidBrowserUpdateTimer[2];                ///< pussywizard
         uint32 m_raidBrowserLastUpdatedDungeonId[2];       ///< pussywizard: for 2 factions
 
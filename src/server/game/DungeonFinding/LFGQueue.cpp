@@ -24,12 +24,30 @@
 #include "Log.h"
 #include "ObjectDefines.h"
 #include "ObjectMgr.h"
+#include "Player.h"
+#include "SocialMgr.h"
 #include "World.h"
 
 namespace lfg
 {
 
+    LFGQueue::LFGQueue(): m_QueueStatusTimer(0) { }
+
+    LFGQueue::~LFGQueue() { }
+
     void LFGQueue::AddToQueue(uint64 guid, bool failedProposal)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _AddToQueue(guid, failedProposal);
+    }
+
+    void LFGQueue::RemoveFromQueue(uint64 guid, bool partial)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _RemoveFromQueue(guid, partial);
+    }
+
+    void LFGQueue::_AddToQueue(uint64 guid, bool failedProposal)
     {
         //LOG_INFO("server", "ADD AddToQueue: %u, failed proposal: %u", GUID_LOPART(guid), failedProposal ? 1 : 0);
         LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
@@ -42,7 +60,7 @@ namespace lfg
         AddToNewQueue(guid, failedProposal);
     }
 
-    void LFGQueue::RemoveFromQueue(uint64 guid, bool partial)
+    void LFGQueue::_RemoveFromQueue(uint64 guid, bool partial)
     {
         //LOG_INFO("server", "REMOVE RemoveFromQueue: %u, partial: %u", GUID_LOPART(guid), partial ? 1 : 0);
         RemoveFromNewQueue(guid);
@@ -102,13 +120,58 @@ namespace lfg
     void LFGQueue::AddQueueData(uint64 guid, time_t joinTime, LfgDungeonSet const& dungeons, LfgRolesMap const& rolesMap)
     {
         //LOG_INFO("server", "JOINED AddQueueData: %u", GUID_LOPART(guid));
-        QueueDataStore[guid] = LfgQueueData(joinTime, dungeons, rolesMap);
-        AddToQueue(guid);
+        // everything the matchmaking thread needs is taken here, it never looks at LFGMgr or players
+        LfgQueueData data(joinTime, dungeons, rolesMap);
+        data.lfgGroup = sLFGMgr->IsLfgGroup(guid);
+        for (LfgRolesMap::const_iterator itr = rolesMap.begin(); itr != rolesMap.end(); ++itr)
+            if (Player* player = ObjectAccessor::FindPlayerInOrOutOfWorld(itr->first))
+                for (uint32 ignoreGuid : player->GetSocial()->GetIgnores())
+                {
+                    data.ignores.insert(ignoreGuid);
+                    data.mask.AddIgnore(ignoreGuid);
+                }
+
+        std::lock_guard<std::mutex> guard(_lock);
+        QueueDataStore[guid] = data;
+        _AddToQueue(guid, false);
+    }
+
+    void LFGQueue::AddIgnore(uint64 guid, uint32 ignoreGuid)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end())
+            return;
+
+        itQueue->second.ignores.insert(ignoreGuid);
+        itQueue->second.mask.AddIgnore(ignoreGuid);
+        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
+            if (it->guids.hasGuid(guid))
+                it->mask.AddIgnore(ignoreGuid);
+        for (LfgCompatibleContainer::iterator it = CompatibleTempList.begin(); it != CompatibleTempList.end(); ++it)
+            if (it->guids.hasGuid(guid))
+                it->mask.AddIgnore(ignoreGuid);
+    }
+
+    void LFGQueue::RemoveIgnore(uint64 guid, uint32 ignoreGuid)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end() || !itQueue->second.ignores.erase(ignoreGuid))
+            return;
+
+        // other ignores may share the filter bit, so the bits are built again
+        LfgQueueMask& mask = itQueue->second.mask;
+        mask.ignores.reset();
+        for (uint32 ignore : itQueue->second.ignores)
+            mask.AddIgnore(ignore);
+        // the compatibles keep the bit, it only sends them to the exact check which reads the ignores above
     }
 
     void LFGQueue::RemoveQueueData(uint64 guid)
     {
         //LOG_INFO("server", "LEFT RemoveQueueData: %u", GUID_LOPART(guid));
+        std::lock_guard<std::mutex> guard(_lock);
         LfgQueueDataContainer::iterator it = QueueDataStore.find(guid);
         if (it != QueueDataStore.end())
             QueueDataStore.erase(it);
@@ -116,6 +179,7 @@ namespace lfg
 
     void LFGQueue::UpdateWaitTimeAvg(int32 waitTime, uint32 dungeonId)
     {
+        std::lock_guard<std::mutex> guard(_lock);
         LfgWaitTime& wt = waitTimesAvgStore[dungeonId];
         uint32 old_number = wt.number++;
         wt.time = int32((wt.time * old_number + waitTime) / wt.number);
@@ -123,6 +187,7 @@ namespace lfg
 
     void LFGQueue::UpdateWaitTimeTank(int32 waitTime, uint32 dungeonId)
     {
+        std::lock_guard<std::mutex> guard(_lock);
         LfgWaitTime& wt = waitTimesTankStore[dungeonId];
         uint32 old_number = wt.number++;
         wt.time = int32((wt.time * old_number + waitTime) / wt.number);
@@ -130,6 +195,7 @@ namespace lfg
 
     void LFGQueue::UpdateWaitTimeHealer(int32 waitTime, uint32 dungeonId)
     {
+        std::lock_guard<std::mutex> guard(_lock);
         LfgWaitTime& wt = waitTimesHealerStore[dungeonId];
         uint32 old_number = wt.number++;
         wt.time = int32((wt.time * old_number + waitTime) / wt.number);
@@ -137,6 +203,7 @@ namespace lfg
 
     void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
     {
+        std::lock_guard<std::mutex> guard(_lock);
         LfgWaitTime& wt = waitTimesDpsStore[dungeonId];
         uint32 old_number = wt.number++;
         wt.time = int32((wt.time * old_number + waitTime) / wt.number);
@@ -146,31 +213,32 @@ namespace lfg
     {
         //LOG_INFO("server", "COMPATIBLES REMOVE for: %u", GUID_LOPART(guid));
         for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(guid))
+            if (it->guids.hasGuid(guid))
             {
-                //LOG_INFO("server", "Removed Compatible: %s, because of guid: %u", it->toString().c_str(), GUID_LOPART(guid));
-                it->clear(); // set to 0, this will be removed while iterating in FindNewGroups
+                //LOG_INFO("server", "Removed Compatible: %s, because of guid: %u", it->guids.toString().c_str(), GUID_LOPART(guid));
+                it->guids.clear(); // set to 0, this will be removed while iterating in FindNewGroups
             }
         for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); )
         {
             LfgCompatibleContainer::iterator it = itr++;
-            if (it->hasGuid(guid))
+            if (it->guids.hasGuid(guid))
             {
-                //LOG_INFO("server", "Erased Temp Compatible: %s, because of guid: %u", it->toString().c_str(), GUID_LOPART(guid));
+                //LOG_INFO("server", "Erased Temp Compatible: %s, because of guid: %u", it->guids.toString().c_str(), GUID_LOPART(guid));
                 CompatibleTempList.erase(it);
             }
         }
     }
 
-    void LFGQueue::AddToCompatibles(Lfg5Guids const& key)
+    void LFGQueue::AddToCompatibles(Lfg5Guids const& key, LfgQueueMask const& mask)
     {
         //LOG_INFO("server", "COMPATIBLES ADD: %s", key.toString().c_str());
-        CompatibleTempList.push_back(key);
+        CompatibleTempList.emplace_back(key, mask);
     }
 
     uint8 LFGQueue::FindGroups()
     {
         //LOG_INFO("server", "FIND GROUPS!");
+        std::lock_guard<std::mutex> guard(_lock);
         uint8 newGroupsProcessed = 0;
         if (!newToQueueStore.empty())
         {
@@ -199,37 +267,44 @@ namespace lfg
 
         //LOG_INFO("server", "FIND NEW GROUPS for: %u", GUID_LOPART(newGuid));
 
+        LfgQueueDataContainer::iterator itNew = QueueDataStore.find(newGuid);
+        if (itNew == QueueDataStore.end())
+        {
+            LOG_ERROR("server", "LFGQueue::FindNewGroups: Queue data not found for [" UI64FMTD "]", newGuid);
+            return LFG_COMPATIBILITY_PENDING;
+        }
+        LfgQueueMask const& newMask = itNew->second.mask;
+
         // we have to take into account that FindNewGroups is called every X minutes if number of compatibles is low!
         // build set of already present compatibles for this guid
         std::set<Lfg5Guids> currentCompatibles;
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(newGuid))
-            {
-                // unset roles here so they are not copied, restore after insertion
-                LfgRolesMap* r = it->roles;
-                it->roles = nullptr;
-                currentCompatibles.insert(*it);
-                it->roles = r;
-            }
+        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
+            if (it->guids.hasGuid(newGuid))
+                currentCompatibles.insert(Lfg5Guids(it->guids, false));
 
         LfgCompatibility selfCompatibility = LFG_COMPATIBILITY_PENDING;
         if (currentCompatibles.empty())
         {
-            selfCompatibility = CheckCompatibility(Lfg5Guids(), newGuid, foundMask, foundCount, currentCompatibles);
+            selfCompatibility = CheckCompatibility(Lfg5Guids(), LfgQueueMask(), newGuid, newMask, foundMask, foundCount, currentCompatibles);
             if (selfCompatibility != LFG_COMPATIBLES_WITH_LESS_PLAYERS) // group is already compatible (a party of 5 players)
                 return selfCompatibility;
         }
 
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); )
+        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); )
         {
-            Lfg5GuidsList::iterator itr = it++;
-            if (itr->empty())
+            LfgCompatibleContainer::iterator itr = it++;
+            if (itr->guids.empty())
             {
                 //LOG_INFO("server", "ERASE from CompatibleList");
                 CompatibleList.erase(itr);
                 continue;
             }
-            LfgCompatibility compatibility = CheckCompatibility(*itr, newGuid, foundMask, foundCount, currentCompatibles);
+
+            // too many players, no common dungeon or no roles left, without looking anything up
+            if (!itr->mask.CanMerge(newMask))
+                continue;
+
+            LfgCompatibility compatibility = CheckCompatibility(itr->guids, itr->mask, newGuid, newMask, foundMask, foundCount, currentCompatibles);
             if (compatibility == LFG_COMPATIBLES_MATCH)
                 return LFG_COMPATIBLES_MATCH;
             if ((foundMask & 0x3FFF3FFF3FFF3FFF) == 0x3FFF3FFF3FFF3FFF) // each combination of dps+heal+tank already found 4 times
@@ -239,7 +314,7 @@ namespace lfg
         return selfCompatibility;
     }
 
-    LfgCompatibility LFGQueue::CheckCompatibility(Lfg5Guids const& checkWith, const uint64& newGuid, uint64& foundMask, uint32& foundCount, const std::set<Lfg5Guids>& currentCompatibles)
+    LfgCompatibility LFGQueue::CheckCompatibility(Lfg5Guids const& checkWith, LfgQueueMask const& checkWithMask, const uint64& newGuid, LfgQueueMask const& newMask, uint64& foundMask, uint32& foundCount, const std::set<Lfg5Guids>& currentCompatibles)
     {
         //LOG_INFO("server", "CHECK CheckCompatibility: %s, new guid: %u", checkWith.toString().c_str(), GUID_LOPART(newGuid));
         Lfg5Guids check(checkWith, false); // here newGuid is at front
@@ -267,7 +342,7 @@ namespace lfg
             if (itQueue == QueueDataStore.end())
             {
                 LOG_ERROR("server", "LFGQueue::CheckCompatibility: [" UI64FMTD "] is not queued but listed as queued!", guid);
-                RemoveFromQueue(guid);
+                _RemoveFromQueue(guid, false);
                 return LFG_COMPATIBILITY_PENDING;
             }
 
@@ -277,7 +352,7 @@ namespace lfg
 
             numPlayers += itQueue->second.roles.size();
 
-            if (sLFGMgr->IsLfgGroup(guid))
+            if (itQueue->second.lfgGroup)
             {
                 if (!numLfgGroups)
                     proposal.group = guid;
@@ -297,7 +372,7 @@ namespace lfg
             strGuids.addRoles(roles);
             itQueue->second.bestCompatible.clear(); // this may be left after a failed proposal (not cleared, because UpdateQueueTimers would try to generate it with every update)
             //UpdateBestCompatibleInQueue(itQueue, strGuids);
-            AddToCompatibles(strGuids);
+            AddToCompatibles(strGuids, newMask);
             if (roleCheckResult && roleCheckResult <= 15)
                 foundMask |= ( (((uint64)1) << (roleCheckResult - 1)) | (((uint64)1) << (16 + roleCheckResult - 1)) | (((uint64)1) << (32 + roleCheckResult - 1)) | (((uint64)1) << (48 + roleCheckResult - 1)) );
             return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
@@ -309,9 +384,12 @@ namespace lfg
         // If it's single group no need to check for duplicate players, ignores, bad roles or bad dungeons as it's been checked before joining
         if (check.size() > 1)
         {
+            bool mayIgnore = checkWithMask.MayIgnore(newMask);
+            std::set<uint32> proposalIgnores;
             for (uint8 i = 0; i < 5 && check.guid[i]; ++i)
             {
-                const LfgRolesMap& roles = QueueDataStore[check.guid[i]].roles;
+                LfgQueueData const& queueData = QueueDataStore[check.guid[i]];
+                const LfgRolesMap& roles = queueData.roles;
                 for (LfgRolesMap::const_iterator itRoles = roles.begin(); itRoles != roles.end(); ++itRoles)
                 {
                     LfgRolesMap::const_iterator itPlayer;
@@ -323,7 +401,7 @@ namespace lfg
                             //LOG_ERROR("server", "LFGQueue::CheckCompatibility: ERROR! Player multiple times in queue! [" UI64FMTD "]", itRoles->first);
                             break;
                         }
-                        else if (sLFGMgr->HasIgnore(itRoles->first, itPlayer->first))
+                        else if (mayIgnore && (proposalIgnores.count(GUID_LOPART(itRoles->first)) || queueData.ignores.count(GUID_LOPART(itPlayer->first))))
                             break;
                     }
                     if (itPlayer == proposalRoles.end())
@@ -331,6 +409,8 @@ namespace lfg
                     else
                         break;
                 }
+                if (mayIgnore)
+                    proposalIgnores.insert(queueData.ignores.begin(), queueData.ignores.end());
             }
 
             if (numPlayers != proposalRoles.size())
@@ -395,18 +475,16 @@ namespace lfg
                 if (!itr->second.bestCompatible.empty()) // update if groups don't have it empty (for empty it will be generated in UpdateQueueTimers)
                     UpdateBestCompatibleInQueue(itr, strGuids);
             }
-            AddToCompatibles(strGuids);
+            LfgQueueMask mask(checkWithMask);
+            mask.Merge(newMask);
+            AddToCompatibles(strGuids, mask);
             foundMask |= addToFoundMask;
             ++foundCount;
             return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
         }
 
-        uint64 gguid = check.front();
         proposal.queues = strGuids;
-        proposal.isNew = numLfgGroups != 1 || sLFGMgr->GetOldState(gguid) != LFG_STATE_DUNGEON;
-
-        if (!sLFGMgr->AllQueued(check)) // can't create proposal
-            return LFG_COMPATIBILITY_PENDING;
+        proposal.isNew = numLfgGroups != 1; // LFGMgr checks the state of an existing group before registering the proposal
 
         // Create a new proposal
         proposal.cancelTime = time(nullptr) + LFG_TIME_PROPOSAL;
@@ -431,66 +509,70 @@ namespace lfg
             LfgProposalPlayer& data = proposal.players[itRoles->first];
             data.role = itRoles->second;
             data.group = proposalGroups.find(itRoles->first)->second;
-            if (!proposal.isNew && data.group && data.group == proposal.group) // Player from existing group, autoaccept
-                data.accept = LFG_ANSWER_AGREE;
         }
 
         for (uint8 i = 0; i < 5 && proposal.queues.guid[i]; ++i)
-            RemoveFromQueue(proposal.queues.guid[i], true);
+            _RemoveFromQueue(proposal.queues.guid[i], true);
 
-        sLFGMgr->AddProposal(proposal);
+        newProposals.push_back(proposal);
 
         return LFG_COMPATIBLES_MATCH;
     }
 
-    void LFGQueue::UpdateQueueTimers(uint32 diff)
+    void LFGQueue::RefreshCompatibles()
     {
         time_t currTime = time(nullptr);
-        bool sendQueueStatus = false;
+        std::lock_guard<std::mutex> guard(_lock);
 
-        if (m_QueueStatusTimer > LFG_QUEUEUPDATE_INTERVAL)
+        //LOG_INFO("server", "UPDATE RefreshCompatibles");
+        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); )
         {
-            m_QueueStatusTimer = 0;
-            sendQueueStatus = true;
-        }
-        else
-            m_QueueStatusTimer += diff;
-
-        //LOG_INFO("server", "UPDATE UpdateQueueTimers");
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); )
-        {
-            Lfg5GuidsList::iterator itr = it++;
-            if (itr->empty())
+            LfgCompatibleContainer::iterator itr = it++;
+            if (itr->guids.empty())
             {
                 //LOG_INFO("server", "UpdateQueueTimers ERASE compatible");
                 CompatibleList.erase(itr);
             }
         }
 
-        if (!sendQueueStatus)
+        for (LfgQueueDataContainer::iterator itQueue = QueueDataStore.begin(); itQueue != QueueDataStore.end(); )
         {
-            for (LfgQueueDataContainer::iterator itQueue = QueueDataStore.begin(); itQueue != QueueDataStore.end(); )
+            if (currTime - itQueue->second.joinTime > 2 * HOUR)
             {
-                if (currTime - itQueue->second.joinTime > 2 * HOUR)
-                {
-                    uint64 guid = itQueue->first;
-                    QueueDataStore.erase(itQueue++);
-                    sLFGMgr->LeaveAllLfgQueues(guid, true);
-                    continue;
-                }
-                if (itQueue->second.bestCompatible.empty())
+                // LFGMgr removes them from lfg on the world thread
+                expiredStore.push_back(itQueue->first);
+                QueueDataStore.erase(itQueue++);
+                continue;
+            }
+            if (itQueue->second.bestCompatible.empty())
+            {
+                uint32 numOfCompatibles = FindBestCompatibleInQueue(itQueue);
+                if (numOfCompatibles /*must be positive, because proposals don't delete QueueQueueData*/ && currTime - itQueue->second.lastRefreshTime >= 60 && numOfCompatibles < (5 - itQueue->second.bestCompatible.roles->size()) * 25)
                 {
-                    uint32 numOfCompatibles = FindBestCompatibleInQueue(itQueue);
-                    if (numOfCompatibles /*must be positive, because proposals don't delete QueueQueueData*/ && currTime - itQueue->second.lastRefreshTime >= 60 && numOfCompatibles < (5 - itQueue->second.bestCompatible.roles->size()) * 25)
-                    {
-                        itQueue->second.lastRefreshTime = currTime;
-                        AddToQueue(itQueue->first, false);
-                    }
+                    itQueue->second.lastRefreshTime = currTime;
+                    _AddToQueue(itQueue->first, false);
                 }
-                ++itQueue;
             }
+            ++itQueue;
+        }
+    }
+
+    void LFGQueue::UpdateQueueTimers(uint32 diff, LfgGuidList& expired)
+    {
+        time_t currTime = time(nullptr);
+        std::unique_lock<std::mutex> guard(_lock);
+
+        expired.splice(expired.end(), expiredStore);
+
+        if (m_QueueStatusTimer <= LFG_QUEUEUPDATE_INTERVAL)
+        {
+            m_QueueStatusTimer += diff;
             return;
         }
+        m_QueueStatusTimer = 0;
+
+        // the packets are sent once the matchmaking thread may use the queue again
+        std::vector<std::pair<uint64, LfgQueueStatusData>> statuses;
 
         // LOG_TRACE("lfg", "Updating queue timers...");
         for (LfgQueueDataContainer::iterator itQueue = QueueDataStore.begin(); itQueue != QueueDataStore.end(); ++itQueue)
@@ -536,26 +618,47 @@ namespace lfg
 
             LfgQueueStatusData queueData(dungeonId, waitTime, wtAvg, wtTank, wtHealer, wtDps, queuedTime, queueinfo.tanks, queueinfo.healers, queueinfo.dps);
             for (LfgRolesMap::const_iterator itPlayer = queueinfo.roles.begin(); itPlayer != queueinfo.roles.end(); ++itPlayer)
-            {
-                uint64 pguid = itPlayer->first;
-                LFGMgr::SendLfgQueueStatus(pguid, queueData);
-            }
+                statuses.emplace_back(itPlayer->first, queueData);
         }
+
+        guard.unlock();
+
+        for (auto const& status : statuses)
+            LFGMgr::SendLfgQueueStatus(status.first, status.second);
     }
 
     time_t LFGQueue::GetJoinTime(uint64 guid)
     {
+        std::lock_guard<std::mutex> guard(_lock);
         return QueueDataStore[guid].joinTime;
     }
 
+    void LFGQueue::TakeProposals(LfgProposalList& proposals)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        proposals.splice(proposals.end(), newProposals);
+    }
+
+    void LFGQueue::Clear()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        QueueDataStore.clear();
+        CompatibleList.clear();
+        CompatibleTempList.clear();
+        newToQueueStore.clear();
+        restoredAfterProposal.clear();
+        newProposals.clear();
+        expiredStore.clear();
+    }
+
     uint32 LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
     {
         uint32 numOfCompatibles = 0;
         for (LfgCompatibleContainer::const_iterator itr = CompatibleList.begin(); itr != CompatibleList.end(); ++itr)
-            if (itr->hasGuid(itrQueue->first))
+            if (itr->guids.hasGuid(itrQueue->first))
             {
                 ++numOfCompatibles;
-                UpdateBestCompatibleInQueue(itrQueue, *itr);
+                UpdateBestCompatibleInQueue(itrQueue, itr->guids);
             }
         return numOfCompatibles;
     }
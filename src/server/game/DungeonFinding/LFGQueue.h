@@ -8,9 +8,15 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <bitset>
+#include <mutex>
 
 namespace lfg
 {
+    struct LfgProposal;
+
+#define LFG_DUNGEON_MASK_BITS   512                            // LFGDungeons.dbc ids stay below it, higher ids would share bits
+#define LFG_IGNORE_FILTER_BITS  256
 
     enum LfgCompatibility
     {
@@ -25,16 +31,100 @@ namespace lfg
         LFG_COMPATIBLES_MATCH                                  // Must be the last one
     };
 
+    /**
+        Bitset summary of queued players or groups, compared before the exact compatibility checks.
+        Dungeons and ignored players may share bits, so it can only tell that a combination is
+        incompatible, the combinations it lets through still go through CheckCompatibility.
+    */
+    struct LfgQueueMask
+    {
+        LfgQueueMask(): players(0), roles() { }
+
+        LfgQueueMask(LfgDungeonSet const& _dungeons, LfgRolesMap const& _roles): players(0), roles()
+        {
+            for (uint32 dungeonId : _dungeons)
+                dungeons.set(dungeonId % LFG_DUNGEON_MASK_BITS);
+
+            for (LfgRolesMap::const_iterator itr = _roles.begin(); itr != _roles.end(); ++itr)
+            {
+                members.set(GetFilterBit(GUID_LOPART(itr->first)));
+                ++roles[(itr->second & ~PLAYER_ROLE_LEADER) >> 1];
+                ++players;
+            }
+        }
+
+        static uint32 GetFilterBit(uint32 guidLow) { return (guidLow * 2654435761u) >> 24; }
+
+        void AddIgnore(uint32 guidLow) { ignores.set(GetFilterBit(guidLow)); }
+
+        void Merge(LfgQueueMask const& other)
+        {
+            dungeons &= other.dungeons;
+            members |= other.members;
+            ignores |= other.ignores;
+            players += other.players;
+            for (uint8 i = 0; i < 8; ++i)
+                roles[i] += other.roles[i];
+        }
+
+        /// False if both together can't be in one group: too many players, no common dungeon or no role for somebody
+        bool CanMerge(LfgQueueMask const& other) const
+        {
+            if (players + other.players > LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED)
+                return false;
+
+            if ((dungeons & other.dungeons).none())
+                return false;
+
+            uint8 merged[8];
+            for (uint8 i = 0; i < 8; ++i)
+                merged[i] = roles[i] + other.roles[i];
+            return HasRoles(merged);
+        }
+
+        /// False if no player of both together ignores another one, ignores added while a side was stored included
+        bool MayIgnore(LfgQueueMask const& other) const
+        {
+            return ((ignores | other.ignores) & (members | other.members)).any();
+        }
+
+        /// True if every player can get one of the selected roles (counts per tank | healer << 1 | damage << 2 mask)
+        static bool HasRoles(uint8 const* counts)
+        {
+            if (counts[0])                                      // somebody without roles
+                return false;
+
+            // Hall's condition: the players limited to a set of roles must fit in the slots of these roles
+            for (uint8 allowed = 1; allowed < 8; ++allowed)
+            {
+                uint8 slots = ((allowed & 1) ? LFG_TANKS_NEEDED : 0) + ((allowed & 2) ? LFG_HEALERS_NEEDED : 0) + ((allowed & 4) ? LFG_DPS_NEEDED : 0);
+                uint8 limited = 0;
+                for (uint8 mask = 1; mask < 8; ++mask)
+                    if (!(mask & ~allowed))
+                        limited += counts[mask];
+                if (limited > slots)
+                    return false;
+            }
+            return true;
+        }
+
+        std::bitset<LFG_DUNGEON_MASK_BITS> dungeons;
+        std::bitset<LFG_IGNORE_FILTER_BITS> members;           ///< Filter bits of the players
+        std::bitset<LFG_IGNORE_FILTER_BITS> ignores;           ///< Filter bits of the players they ignore
+        uint8 players;
+        uint8 roles[8];                                        ///< Players per role mask
+    };
+
     /// Stores player or group queue info
     struct LfgQueueData
     {
         LfgQueueData(): joinTime(time_t(time(nullptr))), lastRefreshTime(joinTime), tanks(LFG_TANKS_NEEDED),
-            healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED)
+            healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), lfgGroup(false)
         { }
 
         LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, LfgRolesMap const& _roles):
             joinTime(_joinTime), lastRefreshTime(_joinTime), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED),
-            dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles)
+            dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles), lfgGroup(false), mask(_dungeons, _roles)
         { }
 
         time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
@@ -45,6 +135,18 @@ namespace lfg
         LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
         LfgRolesMap roles;                                     ///< Selected Player Role/s
         Lfg5Guids bestCompatible;                              ///< Best compatible combination of people queued
+        bool lfgGroup;                                         ///< Group formed by the dungeon finder, looking for more players
+        std::set<uint32> ignores;                              ///< Players ignored by any of the players
+        LfgQueueMask mask;                                     ///< Bitset summary of dungeons, roles and ignores
+    };
+
+    /// Combination of queued players and groups that could still be completed, with its merged mask
+    struct LfgCompatible
+    {
+        LfgCompatible(Lfg5Guids const& _guids, LfgQueueMask const& _mask): guids(_guids), mask(_mask) { }
+
+        Lfg5Guids guids;
+        LfgQueueMask mask;
     };
 
     struct LfgWaitTime
@@ -56,19 +158,29 @@ namespace lfg
 
     typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
     typedef std::map<uint64, LfgQueueData> LfgQueueDataContainer;
-    typedef std::list<Lfg5Guids> LfgCompatibleContainer;
+    typedef std::list<LfgCompatible> LfgCompatibleContainer;
+    typedef std::list<LfgProposal> LfgProposalList;
 
     /**
         Stores all data related to queue
+
+        Groups are matched by the matchmaking thread (FindGroups, RefreshCompatibles) on the data stored here
+        when they joined, without touching LFGMgr or players. It hands the proposals it finds to the world thread,
+        which checks that everybody is still queued before registering them. Every public function takes the lock.
     */
     class LFGQueue
     {
     public:
+        LFGQueue();
+        ~LFGQueue();                                       // out of line, LfgProposal is only complete in LFGMgr.h
+
         // Add/Remove from queue
         void AddToQueue(uint64 guid, bool failedProposal = false);
         void RemoveFromQueue(uint64 guid, bool partial = false); // xinef: partial remove, dont delete data from list!
         void AddQueueData(uint64 guid, time_t joinTime, LfgDungeonSet const& dungeons, LfgRolesMap const& rolesMap);
         void RemoveQueueData(uint64 guid);
+        void AddIgnore(uint64 guid, uint32 ignoreGuid);
+        void RemoveIgnore(uint64 guid, uint32 ignoreGuid);
 
         // Update Timers (when proposal success)
         void UpdateWaitTimeAvg(int32 waitTime, uint32 dungeonId);
@@ -76,27 +188,36 @@ namespace lfg
         void UpdateWaitTimeHealer(int32 waitTime, uint32 dungeonId);
         void UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId);
 
-        // Update Queue timers
-        void UpdateQueueTimers(uint32 diff);
+        // Update Queue timers, queued guids waiting for too long are returned to be removed from lfg
+        void UpdateQueueTimers(uint32 diff, LfgGuidList& expired);
         time_t GetJoinTime(uint64 guid);
 
-        // Find new group
+        // Matchmaking thread
         uint8 FindGroups();
+        void RefreshCompatibles();
+
+        // Proposals found since the last call, the queued guids are already taken out of matching
+        void TakeProposals(LfgProposalList& proposals);
+
+        void Clear();
 
     private:
         void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
 
+        void _AddToQueue(uint64 guid, bool failedProposal);
+        void _RemoveFromQueue(uint64 guid, bool partial);
+
         void AddToNewQueue(uint64 guid, bool front);
         void RemoveFromNewQueue(uint64 guid);
 
         void RemoveFromCompatibles(uint64 guid);
-        void AddToCompatibles(Lfg5Guids const& key);
+        void AddToCompatibles(Lfg5Guids const& key, LfgQueueMask const& mask);
 
         uint32 FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
         void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key);
 
         LfgCompatibility FindNewGroups(const uint64& newGuid);
-        LfgCompatibility CheckCompatibility(Lfg5Guids const& checkWith, const uint64& newGuid, uint64& foundMask, uint32& foundCount, const std::set<Lfg5Guids>& currentCompatibles);
+        LfgCompatibility CheckCompatibility(Lfg5Guids const& checkWith, LfgQueueMask const& checkWithMask, const uint64& newGuid, LfgQueueMask const& newMask, uint64& foundMask, uint32& foundCount, const std::set<Lfg5Guids>& currentCompatibles);
 
         // Queue
         uint32 m_QueueStatusTimer;                         ///< used to check interval of sending queue status
@@ -110,6 +231,10 @@ namespace lfg
         LfgWaitTimesContainer waitTimesDpsStore;           ///< Average wait time to find a group queuing as dps
         LfgGuidList newToQueueStore;                       ///< New groups to add to queue
         LfgGuidList restoredAfterProposal;
+        LfgProposalList newProposals;                      ///< Proposals waiting for the world thread
+        LfgGuidList expiredStore;                          ///< Queued for too long, waiting for the world thread
+
+        std::mutex _lock;
     };
 
 } // namespace lfg
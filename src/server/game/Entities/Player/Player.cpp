@@ -74,6 +74,7 @@
 #include "Vehicle.h"
 #include "Weather.h"
 #include "WeatherMgr.h"
+#include "WhoListCache.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -764,6 +765,7 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     // group is initialized in the reference constructor
     SetGroupInvite(nullptr);
     m_groupUpdateMask = 0;
+    m_groupUpdateTimer = 0;
     m_auraRaidUpdateMask = 0;
     m_bPassOnGroupLoot = false;
 
@@ -1931,7 +1933,7 @@ void Player::Update(uint32 p_time)
     }
 
     // group update
-    SendUpdateToOutOfRangeGroupMembers();
+    SendUpdateToOutOfRangeGroupMembers(p_time);
 
     Pet* pet = GetPet();
     if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityRange()) && !pet->isPossessed())
@@ -5778,6 +5780,12 @@ void Player::LeftChannel(Channel* c)
     m_channels.remove(c);
 }
 
+void Player::UpdateChannelIgnores(uint64 ignoredGuid)
+{
+    for (Channel* channel : m_channels)
+        channel->InvalidateIgnores(ignoredGuid);
+}
+
 void Player::CleanupChannels()
 {
     while (!m_channels.empty())
@@ -7794,6 +7802,7 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
         SendInitWorldStates(newZone, newArea);              // only if really enters to new zone, not just area change, works strange...
         if (Guild* guild = GetGuild())
             guild->UpdateMemberData(this, GUILD_MEMBER_DATA_ZONEID, newZone);
+        WhoListCacheMgr::UpdateZone(this, newZone);
     }
 
     // group update
@@ -12525,38 +12534,7 @@ InventoryResult Player::CanUseItem(Item* pItem, bool not_loading) const
             if (res != EQUIP_ERR_OK)
                 return res;
 
-            if (pItem->GetSkill() != 0)
-            {
-                bool allowEquip = false;
-                uint32 itemSkill = pItem->GetSkill();
-                // Armor that is binded to account can "morph" from plate to mail, etc. if skill is not learned yet.
-                if (pProto->Quality == ITEM_QUALITY_HEIRLOOM && pProto->Class == ITEM_CLASS_ARMOR && !HasSkill(itemSkill))
-                {
-                    // TODO: when you right-click already equipped item it throws EQUIP_ERR_NO_REQUIRED_PROFICIENCY.
-
-                    // In fact it's a visual bug, everything works properly... I need sniffs of operations with
-                    // binded to account items from off server.
-
-                    switch (getClass())
-                    {
-                        case CLASS_HUNTER:
-                        case CLASS_SHAMAN:
-                            allowEquip = (itemSkill == SKILL_MAIL);
-                            break;
-                        case CLASS_PALADIN:
-                        case CLASS_WARRIOR:
-                            allowEquip = (itemSkill == SKILL_PLATE_MAIL);
-                            break;
-                    }
-                }
-                if (!allowEquip && GetSkillValue(itemSkill) == 0)
-                    return EQUIP_ERR_NO_REQUIRED_PROFICIENCY;
-            }
-
-            if (pProto->RequiredReputationFaction && uint32(GetReputationRank(pProto->RequiredReputationFaction)) < pProto->RequiredReputationRank)
-                return EQUIP_ERR_CANT_EQUIP_REPUTATION;
-
-            return EQUIP_ERR_OK;
+            return CanUseItemProficiencyAndReputation(pProto);
         }
     }
     return EQUIP_ERR_ITEM_NOT_FOUND;
@@ -12610,6 +12588,50 @@ InventoryResult Player::CanUseItem(ItemTemplate const* proto) const
     return EQUIP_ERR_ITEM_NOT_FOUND;
 }
 
+InventoryResult Player::CanUseItemProficiencyAndReputation(ItemTemplate const* proto) const
+{
+    if (uint32 itemSkill = proto->GetSkill())
+        if (!HasItemProficiency(proto, getClass(), HasSkill(itemSkill), GetSkillValue(itemSkill)))
+            return EQUIP_ERR_NO_REQUIRED_PROFICIENCY;
+
+    if (proto->RequiredReputationFaction && uint32(GetReputationRank(proto->RequiredReputationFaction)) < proto->RequiredReputationRank)
+        return EQUIP_ERR_CANT_EQUIP_REPUTATION;
+
+    return EQUIP_ERR_OK;
+}
+
+bool Player::HasItemProficiency(ItemTemplate const* proto, uint8 playerClass, bool hasSkill, uint16 skillValue)
+{
+    uint32 itemSkill = proto->GetSkill();
+    if (!itemSkill)
+        return true;
+
+    // Armor that is binded to account can "morph" from plate to mail, etc. if skill is not learned yet.
+    if (proto->Quality == ITEM_QUALITY_HEIRLOOM && proto->Class == ITEM_CLASS_ARMOR && !hasSkill)
+    {
+        // TODO: when you right-click already equipped item it throws EQUIP_ERR_NO_REQUIRED_PROFICIENCY.
+
+        // In fact it's a visual bug, everything works properly... I need sniffs of operations with
+        // binded to account items from off server.
+
+        switch (playerClass)
+        {
+            case CLASS_HUNTER:
+            case CLASS_SHAMAN:
+                if (itemSkill == SKILL_MAIL)
+                    return true;
+                break;
+            case CLASS_PALADIN:
+            case CLASS_WARRIOR:
+                if (itemSkill == SKILL_PLATE_MAIL)
+                    return true;
+                break;
+        }
+    }
+
+    return skillValue != 0;
+}
+
 InventoryResult Player::CanRollForItemInLFG(ItemTemplate const* proto, WorldObject const* lootedObject) const
 {
     if (!GetGroup() || !GetGroup()->isLFGGroup())
@@ -16577,7 +16599,7 @@ bool Player::SatisfyQuestStatus(Quest const* qInfo, bool msg) const
 
 bool Player::SatisfyQuestConditions(Quest const* qInfo, bool msg)
 {
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, qInfo->GetQuestId());
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, qInfo->GetQuestId());
     if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
     {
         if (msg)
@@ -17034,7 +17056,7 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
         if (!quest)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
         if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
             continue;
 
@@ -17062,7 +17084,7 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
         if (!quest)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
         if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
             continue;
 
@@ -21631,7 +21653,7 @@ void Player::VehicleSpellInitialize()
             continue;
         }
 
-        ConditionList conditions = sConditionMgr->GetConditionsForVehicleSpell(vehicle->GetEntry(), spellId);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForVehicleSpell(vehicle->GetEntry(), spellId);
         if (!sConditionMgr->IsObjectMeetToConditions(this, vehicle, conditions))
         {
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
@@ -22620,7 +22642,7 @@ bool Player::BuyItemFromVendorSlot(uint64 vendorguid, uint32 vendorslot, uint32
         return false;
     }
 
-    ConditionList conditions = sConditionMgr->GetConditionsForNpcVendorEvent(creature->GetEntry(), item);
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNpcVendorEvent(creature->GetEntry(), item);
     if (!sConditionMgr->IsObjectMeetToConditions(this, creature, conditions))
     {
         //TC_LOG_DEBUG("condition", "BuyItemFromVendor: conditions not met for creature entry %u item %u", creature->GetEntry(), item);
@@ -23868,12 +23890,24 @@ void Player::SendInitialPacketsAfterAddToMap()
         SendRaidDifficulty(GetGroup() != nullptr);
 }
 
-void Player::SendUpdateToOutOfRangeGroupMembers()
+void Player::SendUpdateToOutOfRangeGroupMembers(uint32 diff)
 {
+    m_groupUpdateTimer = m_groupUpdateTimer > diff ? m_groupUpdateTimer - diff : 0;
+
     if (m_groupUpdateMask == GROUP_UPDATE_FLAG_NONE)
         return;
     if (Group* group = GetGroup())
+    {
+        // health, power and position changes wait for the interval, any other change takes them along
+        if (m_groupUpdateTimer && !(m_groupUpdateMask & ~GROUP_UPDATE_STATS))
+        {
+            ++groupMemberStatsCounters.Deferred;
+            return;
+        }
+
         group->UpdatePlayerOutOfRange(this);
+        m_groupUpdateTimer = sWorld->getIntConfig(CONFIG_GROUP_STATS_UPDATE_INTERVAL);
+    }
 
     m_groupUpdateMask = GROUP_UPDATE_FLAG_NONE;
     m_auraRaidUpdateMask = 0;
@@ -24395,7 +24429,7 @@ void Player::UpdateForQuestWorldObjects()
             {
                 //! This code doesn't look right, but it was logically converted to condition system to do the exact
                 //! same thing it did before. It definitely needs to be overlooked for intended functionality.
-                ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(obj->GetEntry(), _itr->second.spellId);
+                ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(obj->GetEntry(), _itr->second.spellId);
                 bool buildUpdateBlock = false;
                 for (ConditionList::const_iterator jtr = conds.begin(); jtr != conds.end() && !buildUpdateBlock; ++jtr)
                     if ((*jtr)->ConditionType == CONDITION_QUESTREWARDED || (*jtr)->ConditionType == CONDITION_QUESTTAKEN)
@@ -26565,7 +26599,7 @@ bool Player::CanSeeSpellClickOn(Creature const* c) const
         if (!itr->second.IsFitToRequirements(this, c))
             return false;
 
-        ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(c->GetEntry(), itr->second.spellId);
+        ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(c->GetEntry(), itr->second.spellId);
         ConditionSourceInfo info = ConditionSourceInfo(const_cast<Player*>(this), const_cast<Creature*>(c));
         if (sConditionMgr->IsObjectMeetToConditions(info, conds))
             return true;
@@ -28314,6 +28348,14 @@ void Player::UpdateCinematicLocation(uint32 /*diff*/)
     }
 }
 
+void Player::SetInGuild(uint32 GuildId)
+{
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
+    // xinef: update global storage
+    sWorld->UpdateGlobalPlayerGuild(GetGUIDLow(), GuildId);
+    WhoListCacheMgr::UpdateGuild(this);
+}
+
 Guild* Player::GetGuild() const
 {
     uint32 guildId = GetGuildId();
@@ -1296,6 +1296,10 @@ public:
     [[nodiscard]] bool HasItemTotemCategory(uint32 TotemCategory) const;
     bool IsTotemCategoryCompatiableWith(const ItemTemplate* pProto, uint32 requiredTotemCategoryId) const;
     InventoryResult CanUseItem(ItemTemplate const* pItem) const;
+    // Template checks of CanUseItem(Item*) that the template overload leaves out: armor/weapon proficiency and reputation
+    [[nodiscard]] InventoryResult CanUseItemProficiencyAndReputation(ItemTemplate const* proto) const;
+    // hasSkill and skillValue are HasSkill() and GetSkillValue() of the item skill
+    static bool HasItemProficiency(ItemTemplate const* proto, uint8 playerClass, bool hasSkill, uint16 skillValue);
     [[nodiscard]] InventoryResult CanUseAmmo(uint32 item) const;
     InventoryResult CanRollForItemInLFG(ItemTemplate const* item, WorldObject const* lootedObject) const;
     Item* StoreNewItem(ItemPosCountVec const& pos, uint32 item, bool update, int32 randomPropertyId = 0);
@@ -1883,14 +1887,9 @@ public:
     void UninviteFromGroup();
     static void RemoveFromGroup(Group* group, uint64 guid, RemoveMethod method = GROUP_REMOVEMETHOD_DEFAULT, uint64 kicker = 0, const char* reason = nullptr);
     void RemoveFromGroup(RemoveMethod method = GROUP_REMOVEMETHOD_DEFAULT) { RemoveFromGroup(GetGroup(), GetGUID(), method); }
-    void SendUpdateToOutOfRangeGroupMembers();
+    void SendUpdateToOutOfRangeGroupMembers(uint32 diff);
 
-    void SetInGuild(uint32 GuildId)
-    {
-        SetUInt32Value(PLAYER_GUILDID, GuildId);
-        // xinef: update global storage
-        sWorld->UpdateGlobalPlayerGuild(GetGUIDLow(), GuildId);
-    }
+    void SetInGuild(uint32 GuildId);
     void SetRank(uint8 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
     [[nodiscard]] uint8 GetRank() const { return uint8(GetUInt32Value(PLAYER_GUILDRANK)); }
     void SetGuildIdInvited(uint32 GuildId) { m_GuildIdInvited = GuildId; }
@@ -2060,6 +2059,7 @@ public:
 
     void JoinedChannel(Channel* c);
     void LeftChannel(Channel* c);
+    void UpdateChannelIgnores(uint64 ignoredGuid);
     void CleanupChannels();
     void ClearChannelWatch();
     void UpdateLocalChannels(uint32 newZone);
@@ -2884,6 +2884,7 @@ protected:
     GroupReference m_originalGroup;
     Group* m_groupInvite;
     uint32 m_groupUpdateMask;
+    uint32 m_groupUpdateTimer;
     uint64 m_auraRaidUpdateMask;
     bool m_bPassOnGroupLoot;
 
@@ -26,6 +26,15 @@ uint32 PlayerSocial::GetNumberOfSocialsWithFlag(SocialFlag flag) const
     return counter;
 }
 
+std::vector<uint32> PlayerSocial::GetIgnores() const
+{
+    std::vector<uint32> ignores;
+    for (const auto& itr : m_playerSocialMap)
+        if ((itr.second.Flags & SOCIAL_FLAG_IGNORED) != 0)
+            ignores.push_back(itr.first);
+    return ignores;
+}
+
 bool PlayerSocial::AddToSocialList(uint64 friendGuid, SocialFlag flag)
 {
     // check client limits
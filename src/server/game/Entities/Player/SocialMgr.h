@@ -104,6 +104,7 @@ class PlayerSocial
         uint64 GetPlayerGUID() const { return m_playerGUID; }
         void SetPlayerGUID(uint64 guid) { m_playerGUID = guid; }
         uint32 GetNumberOfSocialsWithFlag(SocialFlag flag) const;
+        std::vector<uint32> GetIgnores() const;
     private:
         bool _checkContact(uint64 guid, SocialFlag flags) const;
         typedef std::map<uint32, FriendInfo> PlayerSocialMap;
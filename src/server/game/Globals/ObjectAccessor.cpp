@@ -22,6 +22,7 @@
 #include "Opcodes.h"
 #include "Pet.h"
 #include "Player.h"
+#include "PlayerNameIndex.h"
 #include "Vehicle.h"
 #include "World.h"
 #include "WorldPacket.h"
@@ -32,6 +33,7 @@ void HashMapHolder<T>::Insert(T* o)
 {
     std::unique_lock<std::shared_mutex> lock(*GetLock());
     m_objectMap[o->GetGUID()] = o;
+    m_index.Insert(o->GetGUID(), o);
 }
 
 template<class T>
@@ -39,14 +41,13 @@ void HashMapHolder<T>::Remove(T* o)
 {
     std::unique_lock<std::shared_mutex> lock(*GetLock());
     m_objectMap.erase(o->GetGUID());
+    m_index.Remove(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(uint64 guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-    typename MapType::iterator itr = m_objectMap.find(guid);
-    return (itr != m_objectMap.end()) ? itr->second : nullptr;
+    return m_index.Find(guid);
 }
 
 template<class T>
@@ -220,15 +221,12 @@ Player* ObjectAccessor::FindConnectedPlayer(uint64 const& guid)
 
 Player* ObjectAccessor::FindPlayerByName(std::string const& name, bool checkInWorld)
 {
-    // pussywizard: optimization
-    std::string nameStr = name;
-    std::transform(nameStr.begin(), nameStr.end(), nameStr.begin(), ::tolower);
-    std::map<std::string, Player*>::iterator itr = playerNameToPlayerPointer.find(nameStr);
-    if (itr != playerNameToPlayerPointer.end())
-        if (!checkInWorld || itr->second->IsInWorld())
-            return itr->second;
+    uint32 guidLow = sPlayerNameIndex->Find(name);
+    if (!guidLow)
+        return nullptr;
 
-    return nullptr;
+    Player* player = HashMapHolder<Player>::Find(MAKE_NEW_GUID(guidLow, 0, HIGHGUID_PLAYER));
+    return player && (!checkInWorld || player->IsInWorld()) ? player : nullptr;
 }
 
 void ObjectAccessor::SaveAllPlayers()
@@ -574,8 +572,6 @@ template<class T>
     return nullptr;
 }
 
-std::map<std::string, Player*> ObjectAccessor::playerNameToPlayerPointer;
-
 /// Global definitions for the hashmap storage
 
 template class HashMapHolder<Player>;
@@ -10,6 +10,7 @@
 #include "Define.h"
 #include "GridDefines.h"
 #include "Object.h"
+#include "ShardedGuidMap.h"
 #include "UpdateData.h"
 #include <mutex>
 #include <set>
@@ -39,6 +40,7 @@ public:
     static void Remove(T* o);
     static T* Find(uint64 guid);
 
+    // iterating the container needs the lock, lookups go through the sharded index
     static MapType& GetContainer() { return m_objectMap; }
     static std::shared_mutex* GetLock();
 
@@ -47,11 +49,13 @@ private:
     HashMapHolder() = default;
 
     static MapType m_objectMap;
+    static ShardedGuidMap<T> m_index;
 };
 
 /// Define the static members of HashMapHolder
 
 template <class T> std::unordered_map< uint64, T* > HashMapHolder<T>::m_objectMap;
+template <class T> ShardedGuidMap<T> HashMapHolder<T>::m_index;
 
 // pussywizard:
 class DelayedCorpseAction
@@ -147,7 +151,6 @@ public:
     static Unit* FindUnit(uint64);
     static Player* FindConnectedPlayer(uint64 const&);
     static Player* FindPlayerByName(std::string const& name, bool checkInWorld = true);
-    static std::map<std::string, Player*> playerNameToPlayerPointer; // pussywizard: optimization
 
     // when using this, you must use the hashmapholder's lock
     static HashMapHolder<Player>::MapType const& GetPlayers()
@@ -37,6 +37,7 @@
 #include "Vehicle.h"
 #include "WaypointManager.h"
 #include "World.h"
+#include "WorldSnapshot.h"
 
 ScriptMapMap sSpellScripts;
 ScriptMapMap sEventScripts;
@@ -1827,10 +1828,98 @@ void ObjectMgr::LoadTempSummons()
     LOG_INFO("server", " ");
 }
 
+namespace
+{
+    // Tables whose content ends up in the creature spawn snapshot, either directly or through the validation
+    std::vector<std::string> const CreatureSnapshotTables = { "creature", "game_event_creature", "pool_creature", "creature_template", "creature_equip_template", "gameobject_template" };
+    std::vector<std::string> const GameObjectSnapshotTables = { "gameobject", "game_event_gameobject", "pool_gameobject", "gameobject_template" };
+
+    // The DBC stores the spawn validation reads, their files may change without the world database
+    void AddMapSnapshotData(WorldSnapshot& snapshot)
+    {
+        ByteBuffer data;
+        for (MapEntry const* mapEntry : sMapStore)
+            data << mapEntry->MapID << mapEntry->map_type;
+
+        snapshot.AddSourceData(data);
+    }
+
+    void AddGameObjectDisplaySnapshotData(WorldSnapshot& snapshot)
+    {
+        ByteBuffer data;
+        for (GameObjectDisplayInfoEntry const* displayInfo : sGameObjectDisplayInfoStore)
+            data << displayInfo->Displayid;
+
+        snapshot.AddSourceData(data);
+    }
+
+    void WriteCreatureData(ByteBuffer& buffer, CreatureData const& data)
+    {
+        buffer << data.id << data.mapid << data.phaseMask << data.displayid << data.equipmentId;
+        buffer << data.posX << data.posY << data.posZ << data.orientation;
+        buffer << data.spawntimesecs << data.wander_distance << data.currentwaypoint << data.curhealth << data.curmana;
+        buffer << data.movementType << data.spawnMask << data.npcflag << data.unit_flags << data.dynamicflags;
+    }
+
+    void ReadCreatureData(ByteBuffer& buffer, CreatureData& data)
+    {
+        buffer >> data.id >> data.mapid >> data.phaseMask >> data.displayid >> data.equipmentId;
+        buffer >> data.posX >> data.posY >> data.posZ >> data.orientation;
+        buffer >> data.spawntimesecs >> data.wander_distance >> data.currentwaypoint >> data.curhealth >> data.curmana;
+        buffer >> data.movementType >> data.spawnMask >> data.npcflag >> data.unit_flags >> data.dynamicflags;
+    }
+
+    void WriteGameObjectData(ByteBuffer& buffer, GameObjectData const& data)
+    {
+        buffer << data.id << data.mapid << data.phaseMask;
+        buffer << data.posX << data.posY << data.posZ << data.orientation;
+        buffer << data.rotation.x << data.rotation.y << data.rotation.z << data.rotation.w;
+        buffer << data.spawntimesecs << data.animprogress << uint8(data.go_state) << data.spawnMask << data.artKit;
+    }
+
+    void ReadGameObjectData(ByteBuffer& buffer, GameObjectData& data)
+    {
+        uint8 goState;
+        buffer >> data.id >> data.mapid >> data.phaseMask;
+        buffer >> data.posX >> data.posY >> data.posZ >> data.orientation;
+        buffer >> data.rotation.x >> data.rotation.y >> data.rotation.z >> data.rotation.w;
+        buffer >> data.spawntimesecs >> data.animprogress >> goState >> data.spawnMask >> data.artKit;
+        data.go_state = GOState(goState);
+    }
+}
+
 void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
 
+    // The snapshot holds the store as it was after validation, along with the spawns that were put on the grid
+    WorldSnapshot snapshot(sWorld->GetDataPath() + "creature.snapshot");
+    bool const useSnapshot = sWorld->getBoolConfig(CONFIG_WORLD_SNAPSHOT) && !sWorld->getBoolConfig(CONFIG_CALCULATE_CREATURE_ZONE_AREA_DATA);
+    if (useSnapshot)
+    {
+        snapshot.AddSourceTables(CreatureSnapshotTables);
+        AddMapSnapshotData(snapshot);
+
+        ByteBuffer payload(0);
+        if (snapshot.Read(payload))
+        {
+            uint32 storeSize = payload.read<uint32>();
+            _creatureDataStore.rehash(storeSize);
+            for (uint32 i = 0; i < storeSize; ++i)
+            {
+                uint32 guid = payload.read<uint32>();
+                CreatureData& data = _creatureDataStore[guid];
+                ReadCreatureData(payload, data);
+                if (payload.read<uint8>())
+                    AddCreatureToGrid(guid, &data);
+            }
+
+            LOG_INFO("server", ">> Loaded %u creatures from %s in %u ms", storeSize, snapshot.GetFileName().c_str(), GetMSTimeDiffToNow(oldMSTime));
+            LOG_INFO("server", " ");
+            return;
+        }
+    }
+
     //                                               0              1   2    3        4             5           6           7           8            9              10
     QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, wander_distance, "
                          //   11               12         13       14            15         16         17          18          19                20                   21
@@ -1855,6 +1944,7 @@ void ObjectMgr::LoadCreatures()
                     spawnMasks[i] |= (1 << k);
 
     _creatureDataStore.rehash(result->GetRowCount());
+    std::unordered_set<uint32> gridGuids;
     uint32 count = 0;
     do
     {
@@ -1981,11 +2071,28 @@ void ObjectMgr::LoadCreatures()
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
+        {
             AddCreatureToGrid(guid, &data);
+            gridGuids.insert(guid);
+        }
 
         ++count;
     } while (result->NextRow());
 
+    if (useSnapshot)
+    {
+        ByteBuffer payload(_creatureDataStore.size() * (sizeof(uint32) + sizeof(CreatureData) + sizeof(uint8)) + sizeof(uint32));
+        payload << uint32(_creatureDataStore.size());
+        for (auto const& [guid, data] : _creatureDataStore)
+        {
+            payload << guid;
+            WriteCreatureData(payload, data);
+            payload << uint8(gridGuids.count(guid));
+        }
+
+        snapshot.Write(payload);
+    }
+
     LOG_INFO("server", ">> Loaded %u creatures in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server", " ");
 }
@@ -2160,6 +2267,34 @@ void ObjectMgr::LoadGameobjects()
 {
     uint32 oldMSTime = getMSTime();
 
+    WorldSnapshot snapshot(sWorld->GetDataPath() + "gameobject.snapshot");
+    bool const useSnapshot = sWorld->getBoolConfig(CONFIG_WORLD_SNAPSHOT) && !sWorld->getBoolConfig(CONFIG_CALCULATE_GAMEOBJECT_ZONE_AREA_DATA);
+    if (useSnapshot)
+    {
+        snapshot.AddSourceTables(GameObjectSnapshotTables);
+        AddMapSnapshotData(snapshot);
+        AddGameObjectDisplaySnapshotData(snapshot);
+
+        ByteBuffer payload(0);
+        if (snapshot.Read(payload))
+        {
+            uint32 storeSize = payload.read<uint32>();
+            _gameObjectDataStore.rehash(storeSize);
+            for (uint32 i = 0; i < storeSize; ++i)
+            {
+                uint32 guid = payload.read<uint32>();
+                GameObjectData& data = _gameObjectDataStore[guid];
+                ReadGameObjectData(payload, data);
+                if (payload.read<uint8>())
+                    AddGameobjectToGrid(guid, &data);
+            }
+
+            LOG_INFO("server", ">> Loaded %u gameobjects from %s in %u ms", storeSize, snapshot.GetFileName().c_str(), GetMSTimeDiffToNow(oldMSTime));
+            LOG_INFO("server", " ");
+            return;
+        }
+    }
+
     uint32 count = 0;
 
     //                                                0                1   2    3           4           5           6
@@ -2185,6 +2320,7 @@ void ObjectMgr::LoadGameobjects()
                     spawnMasks[i] |= (1 << k);
 
     _gameObjectDataStore.rehash(result->GetRowCount());
+    std::unordered_set<uint32> gridGuids;
     do
     {
         Field* fields = result->Fetch();
@@ -2315,10 +2451,27 @@ void ObjectMgr::LoadGameobjects()
         }
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
+        {
             AddGameobjectToGrid(guid, &data);
+            gridGuids.insert(guid);
+        }
         ++count;
     } while (result->NextRow());
 
+    if (useSnapshot)
+    {
+        ByteBuffer payload(_gameObjectDataStore.size() * (sizeof(uint32) + sizeof(GameObjectData) + sizeof(uint8)) + sizeof(uint32));
+        payload << uint32(_gameObjectDataStore.size());
+        for (auto const& [guid, data] : _gameObjectDataStore)
+        {
+            payload << guid;
+            WriteGameObjectData(payload, data);
+            payload << uint8(gridGuids.count(guid));
+        }
+
+        snapshot.Write(payload);
+    }
+
     LOG_INFO("server", ">> Loaded %lu gameobjects in %u ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server", " ");
 }
@@ -5530,6 +5683,7 @@ void ObjectMgr::LoadInstanceEncounters()
                         continue;
                     }
                     const_cast<SpellInfo*>(spellInfo)->AttributesCu |= SPELL_ATTR0_CU_ENCOUNTER_REWARD;
+                    sSpellMgr->RefreshSpellHotInfo(spellInfo);
                     break;
                 }
             default:
@@ -5696,6 +5850,7 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 
     uint32 deletedCount = 0;
     uint32 returnedCount = 0;
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
     do
     {
         Field* fields = result->Fetch();
@@ -5721,73 +5876,198 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
             continue;
         }
 
-        // Delete or return mail
+        // read items from cache
         if (has_items)
-        {
-            // read items from cache
             m->items.swap(itemsCache[m->messageID]);
 
-            // don't return if: is mail from non-player, or sent to self, or already returned, or read and isn't COD
-            if (m->messageType != MAIL_NORMAL || m->receiver == m->sender || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)) || ((m->checked & MAIL_CHECK_MASK_READ) && !m->COD))
-            {
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
-                    stmt->setUInt32(0, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
-                }
+        if (ReturnOrDeleteOldMail(m, has_items, curTime, trans))
+            ++returnedCount;
+        else
+            ++deletedCount;
 
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
-                stmt->setUInt32(0, m->messageID);
-                CharacterDatabase.Execute(stmt);
-            }
-            else
+        delete m;
+    } while (result->NextRow());
+
+    CharacterDatabase.CommitTransaction(trans);
+
+    LOG_INFO("server", ">> Processed %u expired mails: %u deleted and %u returned in %u ms", deletedCount + returnedCount, deletedCount, returnedCount, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server", " ");
+}
+
+bool ObjectMgr::ReturnOrDeleteOldMail(Mail* m, bool hasItems, time_t curTime, SQLTransaction& trans)
+{
+    PreparedStatement* stmt = nullptr;
+
+    // Delete or return mail
+    if (hasItems)
+    {
+        // don't return if: is mail from non-player, or sent to self, or already returned, or read and isn't COD
+        if (m->messageType != MAIL_NORMAL || m->receiver == m->sender || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)) || ((m->checked & MAIL_CHECK_MASK_READ) && !m->COD))
+        {
+            for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
             {
-                // Mail will be returned
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
-                stmt->setUInt32(0, m->receiver);
-                stmt->setUInt32(1, m->sender);
-                stmt->setUInt32(2, curTime + 30 * DAY);
-                stmt->setUInt32(3, curTime);
-                stmt->setUInt8 (4, uint8(MAIL_CHECK_MASK_RETURNED));
-                stmt->setUInt32(5, m->messageID);
-                CharacterDatabase.Execute(stmt);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
-                    stmt->setUInt32(0, m->sender);
-                    stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
-
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
-                    stmt->setUInt32(0, m->sender);
-                    stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
-                }
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_INSTANCE);
+                stmt->setUInt32(0, itr2->item_guid);
+                stmt->setUInt32(1, m->messageID);
+                trans->Append(stmt);
+            }
 
-                // xinef: update global data
-                sWorld->UpdateGlobalPlayerMails(m->sender, 1);
-                sWorld->UpdateGlobalPlayerMails(m->receiver, -1);
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
+            stmt->setUInt32(0, m->messageID);
+            trans->Append(stmt);
+        }
+        else
+        {
+            // Mail will be returned
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
+            stmt->setUInt32(0, m->receiver);
+            stmt->setUInt32(1, m->sender);
+            stmt->setUInt32(2, curTime + 30 * DAY);
+            stmt->setUInt32(3, curTime);
+            stmt->setUInt8 (4, uint8(MAIL_CHECK_MASK_RETURNED));
+            stmt->setUInt32(5, m->messageID);
+            trans->Append(stmt);
+            for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+            {
+                // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
+                stmt->setUInt32(0, m->sender);
+                stmt->setUInt32(1, itr2->item_guid);
+                trans->Append(stmt);
+
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_INSTANCE_OWNER);
+                stmt->setUInt32(0, m->sender);
+                stmt->setUInt32(1, itr2->item_guid);
+                stmt->setUInt32(2, m->messageID);
+                trans->Append(stmt);
+            }
+
+            // xinef: update global data
+            sWorld->UpdateGlobalPlayerMails(m->sender, 1);
+            sWorld->UpdateGlobalPlayerMails(m->receiver, -1);
+            return true;
+        }
+    }
 
-                delete m;
-                ++returnedCount;
-                continue;
+    // xinef: update global data
+    sWorld->UpdateGlobalPlayerMails(m->receiver, -1);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
+    stmt->setUInt32(0, m->messageID);
+    trans->Append(stmt);
+    return false;
+}
+
+void ObjectMgr::StartMailExpiry()
+{
+    // the former pass is still running, it will catch up with the mails expired meanwhile next time
+    if (_mailExpiry.Running)
+        return;
+
+    _mailExpiry = MailExpiryProgress();
+    _mailExpiry.Running = true;
+    _mailExpiry.ExpireBefore = time(nullptr);
+    _mailExpiry.StartTime = getMSTime();
+
+    QueryMailExpiryPage();
+}
+
+void ObjectMgr::QueryMailExpiryPage()
+{
+    uint32 pageSize = std::max<uint32>(1, sWorld->getIntConfig(CONFIG_MAIL_EXPIRY_BATCH_SIZE));
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_PAGE);
+    stmt->setUInt32(0, _mailExpiry.ExpireBefore);
+    stmt->setUInt32(1, _mailExpiry.LastMailId);
+    stmt->setUInt32(2, pageSize);
+    _mailExpiryPage = CharacterDatabase.AsyncQuery(stmt);
+}
+
+void ObjectMgr::UpdateMailExpiry()
+{
+    if (!_mailExpiry.Running || !_mailExpiryPage.ready())
+        return;
+
+    PreparedQueryResult result;
+    _mailExpiryPage.get(result);
+    _mailExpiryPage.cancel();
+
+    if (!result)
+    {
+        FinishMailExpiry();
+        return;
+    }
+
+    // The mails and their items come from one query, so they are read at the same time. The mail may still be
+    // taken or deleted before the transaction runs: the item writes only touch items still attached to their mail.
+    time_t curTime = time(nullptr);
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    uint32 mailCount = 0;
+    bool hasRow = true;
+    Mail m;
+    do
+    {
+        Field* fields = result->Fetch();
+        m.messageID      = fields[0].GetUInt32();
+        m.messageType    = fields[1].GetUInt8();
+        m.sender         = fields[2].GetUInt32();
+        m.receiver       = fields[3].GetUInt32();
+        bool has_items   = fields[4].GetBool();
+        m.expire_time    = time_t(fields[5].GetUInt32());
+        m.deliver_time   = 0;
+        m.COD            = fields[6].GetUInt32();
+        m.checked        = fields[7].GetUInt8();
+        m.mailTemplateId = fields[8].GetInt16();
+        m.items.clear();
+
+        // the rows of a mail follow each other, one per item
+        do
+        {
+            if (!fields[9].IsNull())
+            {
+                MailItemInfo item;
+                item.item_guid = fields[9].GetUInt32();
+                item.item_template = fields[10].GetUInt32();
+                m.items.push_back(item);
             }
+
+            hasRow = result->NextRow();
+            if (hasRow)
+                fields = result->Fetch();
+        } while (hasRow && fields[0].GetUInt32() == m.messageID);
+
+        ++mailCount;
+        _mailExpiry.LastMailId = m.messageID;
+
+        // don't modify mails of a logged in player
+        if (ObjectAccessor::FindPlayerInOrOutOfWorld(MAKE_NEW_GUID(m.receiver, 0, HIGHGUID_PLAYER)))
+        {
+            ++_mailExpiry.Skipped;
+            continue;
         }
 
-        // xinef: update global data
-        sWorld->UpdateGlobalPlayerMails(m->receiver, -1);
+        if (ReturnOrDeleteOldMail(&m, has_items, curTime, trans))
+            ++_mailExpiry.Returned;
+        else
+            ++_mailExpiry.Deleted;
+    } while (hasRow);
+
+    CharacterDatabase.CommitTransaction(trans);
+    ++_mailExpiry.Pages;
 
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
-        stmt->setUInt32(0, m->messageID);
-        CharacterDatabase.Execute(stmt);
-        delete m;
-        ++deletedCount;
-    } while (result->NextRow());
+    // The page is limited in mails, not in rows: a page with fewer mails was the last one, a full one may be followed
+    // by an empty page. Skipped mails are behind LastMailId too, the next pass picks them up.
+    if (mailCount < std::max<uint32>(1, sWorld->getIntConfig(CONFIG_MAIL_EXPIRY_BATCH_SIZE)))
+        FinishMailExpiry();
+    else
+        QueryMailExpiryPage();
+}
 
-    LOG_INFO("server", ">> Processed %u expired mails: %u deleted and %u returned in %u ms", deletedCount + returnedCount, deletedCount, returnedCount, GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server", " ");
+void ObjectMgr::FinishMailExpiry()
+{
+    _mailExpiry.Running = false;
+    LOG_INFO("server", "Processed %u expired mails in %u pages: %u deleted, %u returned and %u skipped in %u ms", _mailExpiry.Deleted + _mailExpiry.Returned + _mailExpiry.Skipped, _mailExpiry.Pages,
+        _mailExpiry.Deleted, _mailExpiry.Returned, _mailExpiry.Skipped, GetMSTimeDiffToNow(_mailExpiry.StartTime));
 }
 
 void ObjectMgr::LoadQuestAreaTriggers()
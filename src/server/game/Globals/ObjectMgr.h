@@ -533,6 +533,19 @@ struct MailLevelReward
 typedef std::list<MailLevelReward> MailLevelRewardList;
 typedef std::unordered_map<uint8, MailLevelRewardList> MailLevelRewardContainer;
 
+// Counters of the running (or last) pass over the expired mails while the server is up
+struct MailExpiryProgress
+{
+    bool Running{false};
+    time_t ExpireBefore{0};                                 // mails expired before this are handled by the pass
+    uint32 LastMailId{0};                                   // the next page starts after this mail
+    uint32 Pages{0};
+    uint32 Deleted{0};
+    uint32 Returned{0};
+    uint32 Skipped{0};                                      // receiver online, the mail is left to the player session
+    uint32 StartTime{0};                                    // getMSTime() of the start
+};
+
 // We assume the rate is in general the same for all three types below, but chose to keep three for scalability and customization
 struct RepRewardRate
 {
@@ -1064,6 +1077,12 @@ public:
 
     void ReturnOrDeleteOldMails(bool serverUp);
 
+    // The same, while the server is up: the expired mails are read page by page on an async connection,
+    // UpdateMailExpiry() handles at most one page per call in one transaction
+    void StartMailExpiry();
+    void UpdateMailExpiry();
+    [[nodiscard]] MailExpiryProgress const& GetMailExpiryProgress() const { return _mailExpiry; }
+
     CreatureBaseStats const* GetCreatureBaseStats(uint8 level, uint8 unitClass);
 
     void SetHighestGuids();
@@ -1460,6 +1479,14 @@ private:
     typedef std::map<uint32, int32> FishingBaseSkillContainer; // [areaId][base skill level]
     FishingBaseSkillContainer _fishingBaseForAreaStore;
 
+    // returns true if the mail was returned to its sender, false if it was deleted
+    bool ReturnOrDeleteOldMail(Mail* m, bool hasItems, time_t curTime, SQLTransaction& trans);
+    void QueryMailExpiryPage();
+    void FinishMailExpiry();
+
+    MailExpiryProgress _mailExpiry;
+    PreparedQueryResultFuture _mailExpiryPage;
+
     typedef std::map<uint32, StringVector> HalfNameContainer;
     HalfNameContainer _petHalfName0;
     HalfNameContainer _petHalfName1;
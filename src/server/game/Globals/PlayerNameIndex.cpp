@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerNameIndex.h"
+#include "Util.h"
+#include <functional>
+
+PlayerNameIndex::Table::Table(uint32 capacity) : Capacity(capacity), Slots(new std::atomic<Entry*>[capacity])
+{
+    for (uint32 i = 0; i < Capacity; ++i)
+        Slots[i].store(nullptr, std::memory_order_relaxed);
+}
+
+PlayerNameIndex::PlayerNameIndex()
+{
+    _tables.push_back(std::make_unique<Table>(1024));
+    _table.store(_tables.back().get(), std::memory_order_release);
+}
+
+PlayerNameIndex* PlayerNameIndex::instance()
+{
+    static PlayerNameIndex instance;
+    return &instance;
+}
+
+void PlayerNameIndex::Reserve(uint32 count)
+{
+    std::lock_guard<std::mutex> lock(_writeLock);
+
+    uint32 capacity = _table.load(std::memory_order_relaxed)->Capacity;
+    if (uint64(count) * 2 <= capacity)
+        return;
+
+    while (uint64(count) * 2 > capacity)
+        capacity *= 2;
+    Resize(capacity);
+}
+
+void PlayerNameIndex::Insert(std::string const& name, uint32 guidLow)
+{
+    std::string key = MakeKey(name);
+    std::size_t hash = std::hash<std::string>()(key);
+
+    std::lock_guard<std::mutex> lock(_writeLock);
+
+    Table* table = _table.load(std::memory_order_relaxed);
+    if (Entry* entry = FindEntry(table, key, hash))
+    {
+        entry->GuidLow.store(guidLow, std::memory_order_release);
+        return;
+    }
+
+    if ((_entries.size() + 1) * 2 > table->Capacity)
+    {
+        Resize(table->Capacity * 2);
+        table = _table.load(std::memory_order_relaxed);
+    }
+
+    _entries.push_back(std::make_unique<Entry>(key, hash, guidLow));
+    Place(table, _entries.back().get());
+}
+
+void PlayerNameIndex::Remove(std::string const& name)
+{
+    std::string key = MakeKey(name);
+    std::size_t hash = std::hash<std::string>()(key);
+
+    std::lock_guard<std::mutex> lock(_writeLock);
+
+    if (Entry* entry = FindEntry(_table.load(std::memory_order_relaxed), key, hash))
+        entry->GuidLow.store(0, std::memory_order_release);
+}
+
+uint32 PlayerNameIndex::Find(std::string const& name) const
+{
+    std::string key = MakeKey(name);
+    Entry const* entry = FindEntry(_table.load(std::memory_order_acquire), key, std::hash<std::string>()(key));
+    return entry ? entry->GuidLow.load(std::memory_order_acquire) : 0;
+}
+
+std::string PlayerNameIndex::MakeKey(std::string const& name)
+{
+    std::string key = name;
+    for (char& c : key)
+    {
+        if (uint8(c) >= 0x80)
+        {
+            // names in other alphabets go through the wide characters
+            std::wstring wname;
+            if (!Utf8toWStr(name, wname))
+                return name;
+
+            wstrToLower(wname);
+            WStrToUtf8(wname, key);
+            return key;
+        }
+
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+    }
+    return key;
+}
+
+PlayerNameIndex::Entry* PlayerNameIndex::FindEntry(Table const* table, std::string const& key, std::size_t hash)
+{
+    // the table is never full, the probe ends on an empty slot
+    for (uint32 i = hash & (table->Capacity - 1);; i = (i + 1) & (table->Capacity - 1))
+    {
+        Entry* entry = table->Slots[i].load(std::memory_order_acquire);
+        if (!entry)
+            return nullptr;
+        if (entry->Hash == hash && entry->Key == key)
+            return entry;
+    }
+}
+
+void PlayerNameIndex::Place(Table* table, Entry* entry)
+{
+    uint32 i = entry->Hash & (table->Capacity - 1);
+    while (table->Slots[i].load(std::memory_order_relaxed))
+        i = (i + 1) & (table->Capacity - 1);
+    table->Slots[i].store(entry, std::memory_order_release);
+}
+
+void PlayerNameIndex::Resize(uint32 capacity)
+{
+    std::unique_ptr<Table> table = std::make_unique<Table>(capacity);
+    for (std::unique_ptr<Entry> const& entry : _entries)
+        Place(table.get(), entry.get());
+
+    _table.store(table.get(), std::memory_order_release);
+    _tables.push_back(std::move(table));
+}
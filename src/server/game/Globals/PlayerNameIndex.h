@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef ACORE_PLAYERNAMEINDEX_H
+#define ACORE_PLAYERNAMEINDEX_H
+
+#include "Define.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Character name to low guid for online and offline characters, names compare case insensitive.
+ * Writers (character creation, renames, deletions, the global player data load) are serialized,
+ * lookups from any thread never lock: entries and replaced tables are only freed with the index.
+ * A removed name keeps its entry, so the entries grow with the distinct names seen, not with the lookups.
+ */
+class PlayerNameIndex
+{
+public:
+    PlayerNameIndex();
+
+    static PlayerNameIndex* instance();
+
+    void Reserve(uint32 count);
+    void Insert(std::string const& name, uint32 guidLow);
+    void Remove(std::string const& name);
+
+    // low guid of the character with the name, 0 if there is none
+    [[nodiscard]] uint32 Find(std::string const& name) const;
+
+    static std::string MakeKey(std::string const& name);
+
+private:
+    struct Entry
+    {
+        Entry(std::string const& key, std::size_t hash, uint32 guidLow) : Key(key), Hash(hash), GuidLow(guidLow) { }
+
+        std::string const Key;
+        std::size_t const Hash;
+        std::atomic<uint32> GuidLow;                        // 0 while no character has the name
+    };
+
+    struct Table
+    {
+        explicit Table(uint32 capacity);
+
+        uint32 const Capacity;                              // power of two, at least twice the entries
+        std::unique_ptr<std::atomic<Entry*>[]> Slots;
+    };
+
+    static Entry* FindEntry(Table const* table, std::string const& key, std::size_t hash);
+    static void Place(Table* table, Entry* entry);
+    void Resize(uint32 capacity);
+
+    std::atomic<Table*> _table;
+    std::vector<std::unique_ptr<Table>> _tables;            // replaced tables stay readable, together they are smaller than the current one
+    std::vector<std::unique_ptr<Entry>> _entries;
+    std::mutex _writeLock;
+};
+
+#define sPlayerNameIndex PlayerNameIndex::instance()
+
+#endif
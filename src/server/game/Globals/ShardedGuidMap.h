@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef ACORE_SHARDEDGUIDMAP_H
+#define ACORE_SHARDEDGUIDMAP_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+/*
+ * Guid to object map for lookups from many threads (map updates, packet handlers, listing threads).
+ * Objects are spread over shards with a lock each, so readers only meet writers of the same shard.
+ * Every thread remembers its last lookups. A remembered object is returned without locking
+ * as long as nothing was removed or replaced in its shard since.
+ * Like any lookup, the returned object is only safe to use while the caller keeps it in the map.
+ */
+template<class T>
+class ShardedGuidMap
+{
+public:
+    ShardedGuidMap() : _id(++_lastId) { }
+
+    void Insert(uint64 guid, T* object)
+    {
+        Shard& shard = GetShard(guid);
+        std::unique_lock<std::shared_mutex> lock(shard.Lock);
+        auto result = shard.Objects.emplace(guid, object);
+        if (!result.second && result.first->second != object)
+        {
+            result.first->second = object;
+            shard.Version.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void Remove(uint64 guid)
+    {
+        Shard& shard = GetShard(guid);
+        std::unique_lock<std::shared_mutex> lock(shard.Lock);
+        if (shard.Objects.erase(guid))
+            shard.Version.fetch_add(1, std::memory_order_release);
+    }
+
+    T* Find(uint64 guid) const
+    {
+        Shard const& shard = GetShard(guid);
+        CacheEntry& cached = GetCacheEntry(guid);
+        if (cached.Guid == guid && cached.Owner == _id && cached.Version == shard.Version.load(std::memory_order_acquire))
+            return cached.Object;
+
+        std::shared_lock<std::shared_mutex> lock(shard.Lock);
+        auto itr = shard.Objects.find(guid);
+        if (itr == shard.Objects.end())
+            return nullptr;
+
+        cached.Guid = guid;
+        cached.Owner = _id;
+        cached.Version = shard.Version.load(std::memory_order_relaxed);
+        cached.Object = itr->second;
+        return itr->second;
+    }
+
+private:
+    static constexpr uint32 SHARD_COUNT = 64;
+    static constexpr uint32 CACHE_SIZE = 16;
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex Lock;
+        std::atomic<uint64> Version{0};                     // removed or replaced objects
+        std::unordered_map<uint64, T*> Objects;
+    };
+
+    struct CacheEntry
+    {
+        uint64 Guid;
+        uint32 Owner;
+        uint64 Version;
+        T* Object;
+    };
+
+    // low guids are sequential, the multiplication spreads the high guid and entry bits over the shards too
+    static uint32 GetShardIndex(uint64 guid) { return uint32((guid * UI64LIT(0x9E3779B97F4A7C15)) >> 58); }
+
+    Shard& GetShard(uint64 guid) { return _shards[GetShardIndex(guid)]; }
+    Shard const& GetShard(uint64 guid) const { return _shards[GetShardIndex(guid)]; }
+
+    static CacheEntry& GetCacheEntry(uint64 guid)
+    {
+        static thread_local std::array<CacheEntry, CACHE_SIZE> cache = { };
+        return cache[(guid ^ (guid >> 32)) & (CACHE_SIZE - 1)];
+    }
+
+    static_assert(SHARD_COUNT == 64, "GetShardIndex keeps the top 6 bits");
+
+    std::array<Shard, SHARD_COUNT> _shards;
+    uint32 const _id;                                       // tells the maps apart in the thread caches
+    static std::atomic<uint32> _lastId;
+};
+
+template<class T> std::atomic<uint32> ShardedGuidMap<T>::_lastId(0);
+
+#endif
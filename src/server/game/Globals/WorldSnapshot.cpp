@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "WorldSnapshot.h"
+#include "DatabaseEnv.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    constexpr uint32 SNAPSHOT_MAGIC = 0x53574341; // "ACWS"
+}
+
+WorldSnapshot::WorldSnapshot(std::string const& fileName) : _fileName(fileName), _sourceKnown(true), _sourceDigestReady(false)
+{
+    // The snapshots hold validated data, so a new build may change their content too
+    _sourceHash.UpdateData(GitRevision::GetHash());
+}
+
+void WorldSnapshot::AddSourceTables(std::vector<std::string> const& tables)
+{
+    ASSERT(!_sourceDigestReady);
+
+    // The live checksum MyISAM keeps for tables created with CHECKSUM=1 covers every row and is read
+    // from the table header, unlike a full CHECKSUM TABLE. The information_schema statistics are no
+    // substitute: MySQL 8 caches them and an in place update of a fixed row table keeps its size.
+    // A table without a live checksum (ie: InnoDB) cannot prove it is unchanged and disables the snapshot.
+    std::string names;
+    for (std::string const& table : tables)
+    {
+        if (!names.empty())
+            names += ", ";
+        names += "`" + table + "`";
+    }
+
+    QueryResult result = WorldDatabase.PQuery("CHECKSUM TABLE %s QUICK", names.c_str());
+    if (!result || result->GetRowCount() != tables.size())
+    {
+        _sourceKnown = false;
+        return;
+    }
+
+    do
+    {
+        Field* fields = result->Fetch();
+        if (fields[1].IsNull())
+        {
+            LOG_INFO("server", "World snapshot %s is disabled, table `%s` has no live checksum (CHECKSUM=1).", _fileName.c_str(), fields[0].GetCString());
+            _sourceKnown = false;
+        }
+
+        _sourceHash.UpdateData(fields[0].GetString());
+        _sourceHash.UpdateData(";");
+        _sourceHash.UpdateData(fields[1].GetString());
+        _sourceHash.UpdateData(";");
+    } while (result->NextRow());
+}
+
+void WorldSnapshot::AddSourceData(ByteBuffer const& data)
+{
+    ASSERT(!_sourceDigestReady);
+
+    if (!data.empty())
+        _sourceHash.UpdateData(data.contents(), data.size());
+}
+
+bool WorldSnapshot::Read(ByteBuffer& payload)
+{
+    acore::Crypto::SHA1::Digest const& sourceDigest = GetSourceDigest();
+    if (!_sourceKnown)
+        return false;
+
+    std::ifstream file(_fileName, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+
+    uint64 fileSize = uint64(file.tellg());
+    file.seekg(0);
+
+    ByteBuffer header(HEADER_SIZE);
+    header.resize(HEADER_SIZE);
+    if (fileSize < HEADER_SIZE || !file.read(reinterpret_cast<char*>(header.contents()), HEADER_SIZE))
+        return false;
+
+    uint32 magic = header.read<uint32>();
+    uint32 version = header.read<uint32>();
+    acore::Crypto::SHA1::Digest fileSourceDigest, payloadDigest;
+    header.read(fileSourceDigest);
+    uint64 payloadSize = header.read<uint64>();
+    header.read(payloadDigest);
+
+    if (magic != SNAPSHOT_MAGIC || version != FORMAT_VERSION)
+    {
+        LOG_INFO("server", "World snapshot %s has an unknown format, rebuilding it.", _fileName.c_str());
+        return false;
+    }
+
+    if (fileSourceDigest != sourceDigest)
+    {
+        LOG_INFO("server", "World snapshot %s is outdated, rebuilding it.", _fileName.c_str());
+        return false;
+    }
+
+    if (!payloadSize || payloadSize != fileSize - HEADER_SIZE)
+    {
+        LOG_ERROR("server", "World snapshot %s is truncated, rebuilding it.", _fileName.c_str());
+        return false;
+    }
+
+    // One read for the whole payload, the loaders then only walk memory
+    payload.resize(payloadSize);
+    if (!file.read(reinterpret_cast<char*>(payload.contents()), payloadSize) ||
+        acore::Crypto::SHA1::GetDigestOf(payload.contents(), payload.size()) != payloadDigest)
+    {
+        LOG_ERROR("server", "World snapshot %s is corrupted, rebuilding it.", _fileName.c_str());
+        payload.clear();
+        return false;
+    }
+
+    payload.rpos(0);
+    return true;
+}
+
+void WorldSnapshot::Write(ByteBuffer const& payload)
+{
+    acore::Crypto::SHA1::Digest const& sourceDigest = GetSourceDigest();
+    if (!_sourceKnown)
+        return;
+
+    // Field by field, the file must not depend on the struct layout of the build
+    ByteBuffer header(HEADER_SIZE);
+    header << uint32(SNAPSHOT_MAGIC);
+    header << uint32(FORMAT_VERSION);
+    header.append(sourceDigest);
+    header << uint64(payload.size());
+    header.append(acore::Crypto::SHA1::GetDigestOf(payload.contents(), payload.size()));
+
+    // Written aside then renamed, a crash while writing must not leave a truncated snapshot behind
+    std::string tempFileName = _fileName + ".tmp";
+    {
+        std::ofstream file(tempFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(header.contents()), header.size());
+        file.write(reinterpret_cast<char const*>(payload.contents()), payload.size());
+        if (!file)
+        {
+            LOG_ERROR("server", "Could not write world snapshot %s.", tempFileName.c_str());
+            return;
+        }
+    }
+
+    std::remove(_fileName.c_str());
+    if (std::rename(tempFileName.c_str(), _fileName.c_str()))
+        LOG_ERROR("server", "Could not replace world snapshot %s.", _fileName.c_str());
+}
+
+acore::Crypto::SHA1::Digest const& WorldSnapshot::GetSourceDigest()
+{
+    if (!_sourceDigestReady)
+    {
+        _sourceHash.Finalize();
+        _sourceDigestReady = true;
+    }
+
+    return _sourceHash.GetDigest();
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef ACORE_WORLDSNAPSHOT_H
+#define ACORE_WORLDSNAPSHOT_H
+
+#include "ByteBuffer.h"
+#include "CryptoHash.h"
+#include "Define.h"
+#include <string>
+#include <vector>
+
+/*
+ * Binary copy of a static container, stored in DataDir and reused at the next boot
+ * as long as everything it was built from is unchanged: the build, the world database
+ * tables and any other data the caller adds (ie: the DBC stores used by its validation).
+ *
+ * File layout: magic, format version, source digest, payload size, payload digest, payload.
+ * Any mismatch makes Read() fail so the caller falls back to the database and writes a fresh snapshot.
+ */
+class WorldSnapshot
+{
+public:
+    // Bump whenever the payload layout of any snapshot changes
+    static constexpr uint32 FORMAT_VERSION = 2;
+    static constexpr std::size_t HEADER_SIZE = 4 + 4 + acore::Crypto::SHA1::DIGEST_LENGTH + 8 + acore::Crypto::SHA1::DIGEST_LENGTH;
+
+    explicit WorldSnapshot(std::string const& fileName);
+
+    // Adds the live checksums of world database tables to the source digest, it does not read the tables themselves
+    void AddSourceTables(std::vector<std::string> const& tables);
+    void AddSourceData(ByteBuffer const& data);
+
+    bool Read(ByteBuffer& payload);
+    void Write(ByteBuffer const& payload);
+
+    std::string const& GetFileName() const { return _fileName; }
+
+private:
+    acore::Crypto::SHA1::Digest const& GetSourceDigest();
+
+    std::string _fileName;
+    acore::Crypto::SHA1 _sourceHash;
+    bool _sourceKnown;                                      // false when a source cannot tell whether it changed
+    bool _sourceDigestReady;
+};
+
+#endif
@@ -231,8 +231,8 @@ void acore::WorldObjectLastSearcher<Check>::Visit(DynamicObjectMapType& m)
     }
 }
 
-template<class Check>
-void acore::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
+template<class Check, class Container>
+void acore::WorldObjectListSearcher<Check, Container>::Visit(PlayerMapType& m)
 {
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
@@ -242,8 +242,8 @@ void acore::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
             i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void acore::WorldObjectListSearcher<Check>::Visit(CreatureMapType& m)
+template<class Check, class Container>
+void acore::WorldObjectListSearcher<Check, Container>::Visit(CreatureMapType& m)
 {
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
@@ -253,8 +253,8 @@ void acore::WorldObjectListSearcher<Check>::Visit(CreatureMapType& m)
             i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void acore::WorldObjectListSearcher<Check>::Visit(CorpseMapType& m)
+template<class Check, class Container>
+void acore::WorldObjectListSearcher<Check, Container>::Visit(CorpseMapType& m)
 {
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
@@ -264,8 +264,8 @@ void acore::WorldObjectListSearcher<Check>::Visit(CorpseMapType& m)
             i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void acore::WorldObjectListSearcher<Check>::Visit(GameObjectMapType& m)
+template<class Check, class Container>
+void acore::WorldObjectListSearcher<Check, Container>::Visit(GameObjectMapType& m)
 {
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
@@ -275,8 +275,8 @@ void acore::WorldObjectListSearcher<Check>::Visit(GameObjectMapType& m)
             i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void acore::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType& m)
+template<class Check, class Container>
+void acore::WorldObjectListSearcher<Check, Container>::Visit(DynamicObjectMapType& m)
 {
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
@@ -30,6 +30,8 @@
 #include "WorldPacket.h"
 #include "WorldSession.h"
 
+GroupMemberStatsCounters groupMemberStatsCounters;
+
 Roll::Roll(uint64 _guid, LootItem const& li) : itemGUID(_guid), itemid(li.itemid),
     itemRandomPropId(li.randomPropertyId), itemRandomSuffix(li.randomSuffix), itemCount(li.count),
     totalPlayersRolling(0), totalNeed(0), totalGreed(0), totalPass(0), itemSlot(0),
@@ -1620,20 +1622,35 @@ void Group::UpdatePlayerOutOfRange(Player* player)
     if (!player || !player->IsInWorld())
         return;
 
+    // members in range see the changes through object updates, the packet is built for the first out of range one
     WorldPacket data;
-    player->GetSession()->BuildPartyMemberStatsChangedPacket(player, &data);
+    SharedWorldPacket shared(data);
+    uint32 sent = 0;
 
     Player* member;
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         member = itr->GetSource();
-        if (member && (!member->IsInMap(player) || !member->IsWithinDist(player, member->GetSightRange(player), false)))
-            member->GetSession()->SendPacket(&data);
+        if (!member || (member->IsInMap(player) && member->IsWithinDist(player, member->GetSightRange(player), false)))
+            continue;
+
+        if (!sent++)
+            player->GetSession()->BuildPartyMemberStatsChangedPacket(player, &data);
+        member->GetSession()->SendPacket(shared);
     }
+
+    if (sent)
+    {
+        ++groupMemberStatsCounters.Built;
+        groupMemberStatsCounters.Sent += sent;
+    }
+    else
+        ++groupMemberStatsCounters.Unneeded;
 }
 
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, uint64 ignore)
 {
+    SharedWorldPacket shared(*packet);
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* player = itr->GetSource();
@@ -1641,7 +1658,7 @@ void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int
             continue;
 
         if (group == -1 || itr->getSubGroup() == group)
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(shared);
     }
 }
 
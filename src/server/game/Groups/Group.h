@@ -12,6 +12,7 @@
 #include "LootMgr.h"
 #include "QueryResult.h"
 #include "SharedDefines.h"
+#include <atomic>
 
 class Battlefield;
 class Battleground;
@@ -106,6 +107,7 @@ enum GroupUpdateFlags
     GROUP_UPDATE_FLAG_VEHICLE_SEAT      = 0x00080000,       // uint32 vehicle_seat_id (index from VehicleSeat.dbc)
     GROUP_UPDATE_PET                    = 0x0007FC00,       // all pet flags
     GROUP_UPDATE_FULL                   = 0x0007FFFF,       // all known flags
+    GROUP_UPDATE_STATS                  = 0x00012112,       // current health, power and position of player and pet, sent at most every Group.StatsUpdateInterval
 };
 
 enum lfgGroupFlags
@@ -123,6 +125,17 @@ enum DifficultyPreventionChangeType
 };
 
 #define GROUP_UPDATE_FLAGS_COUNT          20
+
+// SMSG_PARTY_MEMBER_STATS sent to out of range members of all groups, shown to developers by .server info
+struct GroupMemberStatsCounters
+{
+    std::atomic<uint32> Built{0};                           // packets built, one for all recipients
+    std::atomic<uint32> Sent{0};                            // packets sent
+    std::atomic<uint32> Deferred{0};                        // health and power updates held back by the interval
+    std::atomic<uint32> Unneeded{0};                        // updates no member was out of range for
+};
+
+extern GroupMemberStatsCounters groupMemberStatsCounters;
 // 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19
 static const uint8 GroupUpdateLength[GROUP_UPDATE_FLAGS_COUNT] = { 0, 2, 2, 2, 1, 2, 2, 2, 2, 4, 8, 8, 1, 2, 2, 2, 1, 2, 2, 8};
 
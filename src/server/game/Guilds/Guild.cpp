@@ -119,64 +119,78 @@ void Guild::SendSaveEmblemResult(WorldSession* session, GuildEmblemError errCode
 Guild::LogHolder::~LogHolder()
 {
     // Cleanup
-    for (GuildLog::iterator itr = m_log.begin(); itr != m_log.end(); ++itr)
-        delete (*itr);
+    for (uint32 i = 0; i < m_size; ++i)
+        delete _GetEntry(i);
 }
 
-// Adds event loaded from database to collection
-inline void Guild::LogHolder::LoadEvent(LogEntry* entry)
+// Adds event loaded from database to collection, in front of the newer ones
+void Guild::LogHolder::LoadEvent(LogEntry* entry)
 {
-    if (m_nextGUID == uint32(GUILD_EVENT_LOG_GUID_UNDEFINED))
-        m_nextGUID = entry->GetGUID();
-    m_log.push_front(entry);
+    // the oldest slot is the newest event once the log is full
+    ASSERT(CanInsert());
+
+    if (m_log.empty())
+        m_log.resize(m_maxRecords, nullptr);
+
+    m_first = (m_first + m_maxRecords - 1) % m_maxRecords;
+    m_log[m_first] = entry;
+    ++m_size;
 }
 
 // Adds new event happened in game.
-// If maximum number of events is reached, oldest event is removed from collection.
-inline void Guild::LogHolder::AddEvent(SQLTransaction& trans, LogEntry* entry)
+// If maximum number of events is reached, oldest event is overwritten.
+void Guild::LogHolder::AddEvent(LogEntry* entry)
 {
+    if (!m_maxRecords)
+    {
+        delete entry;
+        return;
+    }
+
+    if (m_log.empty())
+        m_log.resize(m_maxRecords, nullptr);
+
     // Check max records limit
-    if (m_log.size() >= m_maxRecords)
+    if (m_size >= m_maxRecords)
     {
-        LogEntry* oldEntry = m_log.front();
-        delete oldEntry;
-        m_log.pop_front();
+        delete m_log[m_first];
+        m_log[m_first] = entry;
+        m_first = (m_first + 1) % m_maxRecords;
     }
-    // Add event to list
-    m_log.push_back(entry);
-    // Save to DB
-    entry->SaveToDB(trans);
+    else
+        _GetEntry(m_size++) = entry;
+
+    // an event overwritten before it was saved is not saved at all
+    m_unsaved = std::min(m_unsaved + 1, m_maxRecords);
 }
 
-// Writes information about all events into packet.
-inline void Guild::LogHolder::WritePacket(WorldPacket& data) const
+bool Guild::LogHolder::SaveToDB(SQLTransaction& trans)
 {
-    data << uint8(m_log.size());
-    for (GuildLog::const_iterator itr = m_log.begin(); itr != m_log.end(); ++itr)
-        (*itr)->WritePacket(data);
+    if (!m_unsaved)
+        return false;
+
+    for (uint32 i = m_size - m_unsaved; i < m_size; ++i)
+        _GetEntry(i)->SaveToDB(trans);
+    m_unsaved = 0;
+
+    if (m_nextGUID > m_maxRecords)
+        _GetEntry(m_size - 1)->DeleteOlderFromDB(trans, m_nextGUID - m_maxRecords);
+    return true;
 }
 
-inline uint32 Guild::LogHolder::GetNextGUID()
+// Writes information about all events into packet.
+void Guild::LogHolder::WritePacket(WorldPacket& data) const
 {
-    // Next guid was not initialized. It means there are no records for this holder in DB yet.
-    // Start from the beginning.
-    if (m_nextGUID == uint32(GUILD_EVENT_LOG_GUID_UNDEFINED))
-        m_nextGUID = 0;
-    else
-        m_nextGUID = (m_nextGUID + 1) % m_maxRecords;
-    return m_nextGUID;
+    data << uint8(m_size);
+    for (uint32 i = 0; i < m_size; ++i)
+        _GetEntry(i)->WritePacket(data);
 }
 
 // EventLogEntry
 void Guild::EventLogEntry::SaveToDB(SQLTransaction& trans) const
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_EVENTLOG);
-    stmt->setUInt32(0, m_guildId);
-    stmt->setUInt32(1, m_guid);
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
-
     uint8 index = 0;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_EVENTLOG);
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_EVENTLOG);
     stmt->setUInt32(  index, m_guildId);
     stmt->setUInt32(++index, m_guid);
     stmt->setUInt8 (++index, uint8(m_eventType));
@@ -184,7 +198,15 @@ void Guild::EventLogEntry::SaveToDB(SQLTransaction& trans) const
     stmt->setUInt32(++index, m_playerGuid2);
     stmt->setUInt8 (++index, m_newRank);
     stmt->setUInt64(++index, m_timestamp);
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
+    trans->Append(stmt);
+}
+
+void Guild::EventLogEntry::DeleteOlderFromDB(SQLTransaction& trans, uint32 guid) const
+{
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_EVENTLOG_OLDER);
+    stmt->setUInt32(0, m_guildId);
+    stmt->setUInt32(1, guid);
+    trans->Append(stmt);
 }
 
 void Guild::EventLogEntry::WritePacket(WorldPacket& data) const
@@ -207,15 +229,7 @@ void Guild::EventLogEntry::WritePacket(WorldPacket& data) const
 void Guild::BankEventLogEntry::SaveToDB(SQLTransaction& trans) const
 {
     uint8 index = 0;
-
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_BANK_EVENTLOG);
-    stmt->setUInt32(  index, m_guildId);
-    stmt->setUInt32(++index, m_guid);
-    stmt->setUInt8 (++index, m_bankTabId);
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
-
-    index = 0;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_BANK_EVENTLOG);
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_BANK_EVENTLOG);
     stmt->setUInt32(  index, m_guildId);
     stmt->setUInt32(++index, m_guid);
     stmt->setUInt8 (++index, m_bankTabId);
@@ -225,7 +239,16 @@ void Guild::BankEventLogEntry::SaveToDB(SQLTransaction& trans) const
     stmt->setUInt16(++index, m_itemStackCount);
     stmt->setUInt8 (++index, m_destTabId);
     stmt->setUInt64(++index, m_timestamp);
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
+    trans->Append(stmt);
+}
+
+void Guild::BankEventLogEntry::DeleteOlderFromDB(SQLTransaction& trans, uint32 guid) const
+{
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_BANK_EVENTLOG_OLDER);
+    stmt->setUInt32(0, m_guildId);
+    stmt->setUInt8 (1, m_bankTabId);
+    stmt->setUInt32(2, guid);
+    trans->Append(stmt);
 }
 
 void Guild::BankEventLogEntry::WritePacket(WorldPacket& data) const
@@ -892,11 +915,11 @@ Item* Guild::PlayerMoveItemData::StoreItem(SQLTransaction& trans, Item* pItem)
     return pItem;
 }
 
-void Guild::PlayerMoveItemData::LogBankEvent(SQLTransaction& trans, MoveItemData* pFrom, uint32 count) const
+void Guild::PlayerMoveItemData::LogBankEvent(MoveItemData* pFrom, uint32 count) const
 {
     ASSERT(pFrom);
     // Bank -> Char
-    m_pGuild->_LogBankEvent(trans, GUILD_BANK_LOG_WITHDRAW_ITEM, pFrom->GetContainer(), m_pPlayer->GetGUIDLow(),
+    m_pGuild->_LogBankEvent(GUILD_BANK_LOG_WITHDRAW_ITEM, pFrom->GetContainer(), m_pPlayer->GetGUIDLow(),
                             pFrom->GetItem()->GetEntry(), count);
 }
 
@@ -978,16 +1001,16 @@ Item* Guild::BankMoveItemData::StoreItem(SQLTransaction& trans, Item* pItem)
     return pLastItem;
 }
 
-void Guild::BankMoveItemData::LogBankEvent(SQLTransaction& trans, MoveItemData* pFrom, uint32 count) const
+void Guild::BankMoveItemData::LogBankEvent(MoveItemData* pFrom, uint32 count) const
 {
     ASSERT(pFrom->GetItem());
     if (pFrom->IsBank())
         // Bank -> Bank
-        m_pGuild->_LogBankEvent(trans, GUILD_BANK_LOG_MOVE_ITEM, pFrom->GetContainer(), m_pPlayer->GetGUIDLow(),
+        m_pGuild->_LogBankEvent(GUILD_BANK_LOG_MOVE_ITEM, pFrom->GetContainer(), m_pPlayer->GetGUIDLow(),
                                 pFrom->GetItem()->GetEntry(), count, m_container);
     else
         // Char -> Bank
-        m_pGuild->_LogBankEvent(trans, GUILD_BANK_LOG_DEPOSIT_ITEM, m_container, m_pPlayer->GetGUIDLow(),
+        m_pGuild->_LogBankEvent(GUILD_BANK_LOG_DEPOSIT_ITEM, m_container, m_pPlayer->GetGUIDLow(),
                                 pFrom->GetItem()->GetEntry(), count);
 }
 
@@ -1253,6 +1276,10 @@ void Guild::Disband()
     stmt->setUInt32(0, m_id);
     trans->Append(stmt);
 
+    m_eventLog->DiscardUnsaved();
+    for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS; ++tabId)
+        m_bankEventLog[tabId]->DiscardUnsaved();
+
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_BANK_EVENTLOGS);
     stmt->setUInt32(0, m_id);
     trans->Append(stmt);
@@ -1736,7 +1763,7 @@ void Guild::HandleMemberDepositMoney(WorldSession* session, uint32 amount)
 
     player->ModifyMoney(-int32(amount));
     player->SaveGoldToDB(trans);
-    _LogBankEvent(trans, GUILD_BANK_LOG_DEPOSIT_MONEY, uint8(0), player->GetGUIDLow(), amount);
+    _LogBankEvent(GUILD_BANK_LOG_DEPOSIT_MONEY, uint8(0), player->GetGUIDLow(), amount);
 
     CharacterDatabase.CommitTransaction(trans);
 
@@ -1783,7 +1810,7 @@ bool Guild::HandleMemberWithdrawMoney(WorldSession* session, uint32 amount, bool
     _ModifyBankMoney(trans, amount, false);
 
     // Log guild bank event
-    _LogBankEvent(trans, repair ? GUILD_BANK_LOG_REPAIR_MONEY : GUILD_BANK_LOG_WITHDRAW_MONEY, uint8(0), player->GetGUIDLow(), amount);
+    _LogBankEvent(repair ? GUILD_BANK_LOG_REPAIR_MONEY : GUILD_BANK_LOG_WITHDRAW_MONEY, uint8(0), player->GetGUIDLow(), amount);
     CharacterDatabase.CommitTransaction(trans);
 
     if (amount > 10 * GOLD)
@@ -1999,61 +2026,18 @@ void Guild::LoadBankRightFromDB(Field* fields)
     _SetRankBankTabRightsAndSlots(fields[2].GetUInt8(), rightsAndSlots, false);
 }
 
-bool Guild::LoadEventLogFromDB(Field* fields)
+void Guild::LoadEventLogGuidFromDB(Field* fields)
 {
-    if (m_eventLog->CanInsert())
-    {
-        m_eventLog->LoadEvent(new EventLogEntry(
-                                  m_id,                                       // guild id
-                                  fields[1].GetUInt32(),                      // guid
-                                  time_t(fields[6].GetUInt32()),              // timestamp
-                                  GuildEventLogTypes(fields[2].GetUInt8()),   // event type
-                                  fields[3].GetUInt32(),                      // player guid 1
-                                  fields[4].GetUInt32(),                      // player guid 2
-                                  fields[5].GetUInt8()));                     // rank
-        return true;
-    }
-    return false;
+    m_eventLog->SetNextGUID(fields[1].GetUInt32() + 1);
 }
 
-bool Guild::LoadBankEventLogFromDB(Field* fields)
+void Guild::LoadBankEventLogGuidFromDB(Field* fields)
 {
     uint8 dbTabId = fields[1].GetUInt8();
-    bool isMoneyTab = (dbTabId == GUILD_BANK_MONEY_LOGS_TAB);
-    if (dbTabId < _GetPurchasedTabsSize() || isMoneyTab)
-    {
-        uint8 tabId = isMoneyTab ? uint8(GUILD_BANK_MAX_TABS) : dbTabId;
-        LogHolder* pLog = m_bankEventLog[tabId];
-        if (pLog->CanInsert())
-        {
-            uint32 guid = fields[2].GetUInt32();
-            GuildBankEventLogTypes eventType = GuildBankEventLogTypes(fields[3].GetUInt8());
-            if (BankEventLogEntry::IsMoneyEvent(eventType))
-            {
-                if (!isMoneyTab)
-                {
-                    LOG_ERROR("server", "GuildBankEventLog ERROR: MoneyEvent(LogGuid: %u, Guild: %u) does not belong to money tab (%u), ignoring...", guid, m_id, dbTabId);
-                    return false;
-                }
-            }
-            else if (isMoneyTab)
-            {
-                LOG_ERROR("server", "GuildBankEventLog ERROR: non-money event (LogGuid: %u, Guild: %u) belongs to money tab, ignoring...", guid, m_id);
-                return false;
-            }
-            pLog->LoadEvent(new BankEventLogEntry(
-                                m_id,                                   // guild id
-                                guid,                                   // guid
-                                time_t(fields[8].GetUInt32()),          // timestamp
-                                dbTabId,                                // tab id
-                                eventType,                              // event type
-                                fields[4].GetUInt32(),                  // player guid
-                                fields[5].GetUInt32(),                  // item or money
-                                fields[6].GetUInt16(),                  // itam stack count
-                                fields[7].GetUInt8()));                 // dest tab id
-        }
-    }
-    return true;
+    if (dbTabId == GUILD_BANK_MONEY_LOGS_TAB)
+        m_bankEventLog[GUILD_BANK_MAX_TABS]->SetNextGUID(fields[2].GetUInt32() + 1);
+    else if (dbTabId < GUILD_BANK_MAX_TABS)
+        m_bankEventLog[dbTabId]->SetNextGUID(fields[2].GetUInt32() + 1);
 }
 
 void Guild::LoadBankTabFromDB(Field* fields)
@@ -2077,6 +2061,14 @@ bool Guild::LoadBankItemFromDB(Field* fields)
     return m_bankTabs[tabId]->LoadItemFromDB(fields);
 }
 
+bool Guild::SaveLogsToDB(SQLTransaction& trans)
+{
+    bool saved = m_eventLog->SaveToDB(trans);
+    for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS; ++tabId)
+        saved |= m_bankEventLog[tabId]->SaveToDB(trans);
+    return saved;
+}
+
 // Validates guild data loaded from database. Returns false if guild should be deleted.
 bool Guild::Validate()
 {
@@ -2149,6 +2141,129 @@ bool Guild::Validate()
     return true;
 }
 
+PreparedStatement* Guild::GetEventLogQuery()
+{
+    if (m_eventLog->IsLoaded())
+        return nullptr;
+
+    if (!m_eventLog->CanInsert())
+    {
+        m_eventLog->SetLoaded();
+        return nullptr;
+    }
+
+    // events of this session are in memory already, only older ones are read
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_EVENTLOG);
+    stmt->setUInt32(0, m_id);
+    stmt->setUInt32(1, m_eventLog->GetFirstGUID());
+    stmt->setUInt32(2, m_eventLog->GetFreeRecords());
+    return stmt;
+}
+
+// New events only fill the log behind the loaded ones, so the oldest guid of the query is still valid,
+// but they can leave less room than the query asked for.
+// When several members opened the log at once, the first result is loaded and the others are dropped.
+void Guild::LoadEventLog(PreparedQueryResult result)
+{
+    if (m_eventLog->IsLoaded())
+        return;
+
+    m_eventLog->SetLoaded();
+    if (!result)
+        return;
+
+    do
+    {
+        // events added since the query can fill the log
+        if (!m_eventLog->CanInsert())
+            break;
+
+        Field* fields = result->Fetch();
+        m_eventLog->LoadEvent(new EventLogEntry(
+                                  m_id,                                       // guild id
+                                  fields[0].GetUInt32(),                      // guid
+                                  time_t(fields[5].GetUInt32()),              // timestamp
+                                  GuildEventLogTypes(fields[1].GetUInt8()),   // event type
+                                  fields[2].GetUInt32(),                      // player guid 1
+                                  fields[3].GetUInt32(),                      // player guid 2
+                                  fields[4].GetUInt8()));                     // rank
+    } while (result->NextRow());
+}
+
+PreparedStatement* Guild::GetBankEventLogQuery(uint8 tabId)
+{
+    // GUILD_BANK_MAX_TABS send by client for money log
+    if (tabId >= _GetPurchasedTabsSize() && tabId != GUILD_BANK_MAX_TABS)
+        return nullptr;
+
+    LogHolder* pLog = m_bankEventLog[tabId];
+    if (pLog->IsLoaded())
+        return nullptr;
+
+    if (!pLog->CanInsert())
+    {
+        pLog->SetLoaded();
+        return nullptr;
+    }
+
+    // events of this session are in memory already, only older ones are read
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_BANK_EVENTLOG);
+    stmt->setUInt32(0, m_id);
+    stmt->setUInt8 (1, tabId == GUILD_BANK_MAX_TABS ? uint8(GUILD_BANK_MONEY_LOGS_TAB) : tabId);
+    stmt->setUInt32(2, pLog->GetFirstGUID());
+    stmt->setUInt32(3, pLog->GetFreeRecords());
+    return stmt;
+}
+
+void Guild::LoadBankEventLog(uint8 tabId, PreparedQueryResult result)
+{
+    LogHolder* pLog = m_bankEventLog[tabId];
+    if (pLog->IsLoaded())
+        return;
+
+    pLog->SetLoaded();
+    if (!result)
+        return;
+
+    bool isMoneyTab = (tabId == GUILD_BANK_MAX_TABS);
+    uint8 dbTabId = isMoneyTab ? uint8(GUILD_BANK_MONEY_LOGS_TAB) : tabId;
+
+    do
+    {
+        // events added since the query can fill the log
+        if (!pLog->CanInsert())
+            break;
+
+        Field* fields = result->Fetch();
+        uint32 guid = fields[0].GetUInt32();
+        GuildBankEventLogTypes eventType = GuildBankEventLogTypes(fields[1].GetUInt8());
+        if (BankEventLogEntry::IsMoneyEvent(eventType))
+        {
+            if (!isMoneyTab)
+            {
+                LOG_ERROR("server", "GuildBankEventLog ERROR: MoneyEvent(LogGuid: %u, Guild: %u) does not belong to money tab (%u), ignoring...", guid, m_id, dbTabId);
+                continue;
+            }
+        }
+        else if (isMoneyTab)
+        {
+            LOG_ERROR("server", "GuildBankEventLog ERROR: non-money event (LogGuid: %u, Guild: %u) belongs to money tab, ignoring...", guid, m_id);
+            continue;
+        }
+
+        pLog->LoadEvent(new BankEventLogEntry(
+                            m_id,                                   // guild id
+                            guid,                                   // guid
+                            time_t(fields[6].GetUInt32()),          // timestamp
+                            dbTabId,                                // tab id
+                            eventType,                              // event type
+                            fields[2].GetUInt32(),                  // player guid
+                            fields[3].GetUInt32(),                  // item or money
+                            fields[4].GetUInt16(),                  // itam stack count
+                            fields[5].GetUInt8()));                 // dest tab id
+    } while (result->NextRow());
+}
+
 // Broadcasts
 void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, std::string const& msg, uint32 language) const
 {
@@ -2165,17 +2280,19 @@ void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, std::strin
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
+    SharedWorldPacket shared(*packet);
     for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (itr->second->IsRank(rankId))
             if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+                player->GetSession()->SendPacket(shared);
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
+    SharedWorldPacket shared(*packet);
     for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (Player* player = itr->second->FindPlayer())
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(shared);
 }
 
 void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank)
@@ -2651,15 +2768,13 @@ inline bool Guild::_MemberHasTabRights(uint64 guid, uint8 tabId, uint32 rights)
 // Add new event log record
 inline void Guild::_LogEvent(GuildEventLogTypes eventType, uint32 playerGuid1, uint32 playerGuid2, uint8 newRank)
 {
-    SQLTransaction trans = CharacterDatabase.BeginTransaction();
-    m_eventLog->AddEvent(trans, new EventLogEntry(m_id, m_eventLog->GetNextGUID(), eventType, playerGuid1, playerGuid2, newRank));
-    CharacterDatabase.CommitTransaction(trans);
+    m_eventLog->AddEvent(new EventLogEntry(m_id, m_eventLog->GetNextGUID(), eventType, playerGuid1, playerGuid2, newRank));
 
     sScriptMgr->OnGuildEvent(this, uint8(eventType), playerGuid1, playerGuid2, newRank);
 }
 
 // Add new bank event log record
-void Guild::_LogBankEvent(SQLTransaction& trans, GuildBankEventLogTypes eventType, uint8 tabId, uint32 lowguid, uint32 itemOrMoney, uint16 itemStackCount, uint8 destTabId)
+void Guild::_LogBankEvent(GuildBankEventLogTypes eventType, uint8 tabId, uint32 lowguid, uint32 itemOrMoney, uint16 itemStackCount, uint8 destTabId)
 {
     if (tabId > GUILD_BANK_MAX_TABS)
         return;
@@ -2675,7 +2790,7 @@ void Guild::_LogBankEvent(SQLTransaction& trans, GuildBankEventLogTypes eventTyp
         dbTabId = GUILD_BANK_MONEY_LOGS_TAB;
     }
     LogHolder* pLog = m_bankEventLog[tabId];
-    pLog->AddEvent(trans, new BankEventLogEntry(m_id, pLog->GetNextGUID(), eventType, dbTabId, lowguid, itemOrMoney, itemStackCount, destTabId));
+    pLog->AddEvent(new BankEventLogEntry(m_id, pLog->GetNextGUID(), eventType, dbTabId, lowguid, itemOrMoney, itemStackCount, destTabId));
 
     sScriptMgr->OnGuildBankEvent(this, uint8(eventType), tabId, lowguid, itemOrMoney, itemStackCount, destTabId);
 }
@@ -2768,9 +2883,9 @@ bool Guild::_DoItemsMove(MoveItemData* pSrc, MoveItemData* pDest, bool sendError
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     // 3. Log bank events
-    pDest->LogBankEvent(trans, pSrc, pSrcItem->GetCount());
+    pDest->LogBankEvent(pSrc, pSrcItem->GetCount());
     if (swap)
-        pSrc->LogBankEvent(trans, pDest, pDestItem->GetCount());
+        pSrc->LogBankEvent(pDest, pDestItem->GetCount());
 
     // 4. Remove item from source
     pSrc->RemoveItem(trans, pDest, splitedAmount);
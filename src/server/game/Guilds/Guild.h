@@ -373,6 +373,8 @@ public: // pussywizard: public class Member
     }
 
 private:
+    friend class GuildLogHolderTest;                    // unit tests of the log classes
+
     // Base class for event entries
     class LogEntry
     {
@@ -385,6 +387,8 @@ private:
         uint64 GetTimestamp() const { return m_timestamp; }
 
         virtual void SaveToDB(SQLTransaction& trans) const = 0;
+        // Deletes the events of the same log with a lower guid
+        virtual void DeleteOlderFromDB(SQLTransaction& trans, uint32 guid) const = 0;
         virtual void WritePacket(WorldPacket& data) const = 0;
 
     protected:
@@ -406,6 +410,7 @@ private:
         ~EventLogEntry() override { }
 
         void SaveToDB(SQLTransaction& trans) const override;
+        void DeleteOlderFromDB(SQLTransaction& trans, uint32 guid) const override;
         void WritePacket(WorldPacket& data) const override;
 
     private:
@@ -438,6 +443,7 @@ private:
         ~BankEventLogEntry() override { }
 
         void SaveToDB(SQLTransaction& trans) const override;
+        void DeleteOlderFromDB(SQLTransaction& trans, uint32 guid) const override;
         void WritePacket(WorldPacket& data) const override;
 
     private:
@@ -450,31 +456,51 @@ private:
     };
 
     // Class encapsulating work with events collection
-    typedef std::list<LogEntry*> GuildLog;
-
+    // Events are kept in a ring of m_maxRecords entries, the oldest one is overwritten when it is full.
+    // Guids are sequence numbers: new events are saved to DB in batches and older rows are deleted by
+    // guid, the last saved sequence is found again after a restart.
     class LogHolder
     {
     public:
-        LogHolder(uint32 guildId, uint32 maxRecords) : m_guildId(guildId), m_maxRecords(maxRecords), m_nextGUID(uint32(GUILD_EVENT_LOG_GUID_UNDEFINED)) { }
+        LogHolder(uint32 guildId, uint32 maxRecords) : m_guildId(guildId), m_maxRecords(maxRecords), m_first(0), m_size(0), m_unsaved(0), m_nextGUID(0), m_loaded(false) { }
         ~LogHolder();
 
-        uint8 GetSize() const { return uint8(m_log.size()); }
+        uint8 GetSize() const { return uint8(m_size); }
         uint32 GetGuildId() const { return m_guildId; }
+        // Events are read from DB when the log is opened for the first time
+        bool IsLoaded() const { return m_loaded; }
+        void SetLoaded() { m_loaded = true; }
+        // Guid of the oldest event in memory, events loaded from DB must be older
+        uint32 GetFirstGUID() const { return m_size ? m_log[m_first]->GetGUID() : m_nextGUID; }
+        // Continues the sequence saved in DB
+        void SetNextGUID(uint32 nextGUID) { m_nextGUID = nextGUID; }
         // Checks if new log entry can be added to holder when loading from DB
-        inline bool CanInsert() const { return m_log.size() < m_maxRecords; }
-        // Adds event from DB to collection
+        inline bool CanInsert() const { return m_size < m_maxRecords; }
+        uint32 GetFreeRecords() const { return m_maxRecords - m_size; }
+        // Adds event from DB to collection, events are loaded from the newest to the oldest
         void LoadEvent(LogEntry* entry);
-        // Adds new event to collection and saves it to DB
-        void AddEvent(SQLTransaction& trans, LogEntry* entry);
+        // Adds new event to collection, it is saved to DB with the next SaveToDB
+        void AddEvent(LogEntry* entry);
+        // Saves events added since the last call and deletes the ones that dropped out of the log
+        bool SaveToDB(SQLTransaction& trans);
+        // Forgets unsaved events, the log is deleted from DB
+        void DiscardUnsaved() { m_unsaved = 0; }
         // Writes information about all events to packet
         void WritePacket(WorldPacket& data) const;
-        uint32 GetNextGUID();
+        uint32 GetNextGUID() { return m_nextGUID++; }
 
     private:
-        GuildLog m_log;
+        LogEntry*& _GetEntry(uint32 index) { return m_log[(m_first + index) % m_maxRecords]; }
+        LogEntry* _GetEntry(uint32 index) const { return m_log[(m_first + index) % m_maxRecords]; }
+
+        std::vector<LogEntry*> m_log;                       // allocated with the first event
         uint32 m_guildId;
         uint32 m_maxRecords;
+        uint32 m_first;                                     // position of the oldest event
+        uint32 m_size;
+        uint32 m_unsaved;                                   // the newest events not saved to DB yet
         uint32 m_nextGUID;
+        bool m_loaded;
     };
 
     // Class encapsulating guild rank data
@@ -589,7 +615,7 @@ private:
         // Saves item to container
         virtual Item* StoreItem(SQLTransaction& trans, Item* pItem) = 0;
         // Log bank event
-        virtual void LogBankEvent(SQLTransaction& trans, MoveItemData* pFrom, uint32 count) const = 0;
+        virtual void LogBankEvent(MoveItemData* pFrom, uint32 count) const = 0;
         // Log GM action
         virtual void LogAction(MoveItemData* pFrom) const;
         // Copy slots id from position vector
@@ -621,7 +647,7 @@ private:
         bool InitItem() override;
         void RemoveItem(SQLTransaction& trans, MoveItemData* pOther, uint32 splitedAmount = 0) override;
         Item* StoreItem(SQLTransaction& trans, Item* pItem) override;
-        void LogBankEvent(SQLTransaction& trans, MoveItemData* pFrom, uint32 count) const override;
+        void LogBankEvent(MoveItemData* pFrom, uint32 count) const override;
     protected:
         InventoryResult CanStore(Item* pItem, bool swap) override;
     };
@@ -638,7 +664,7 @@ private:
         bool HasWithdrawRights(MoveItemData* pOther) const override;
         void RemoveItem(SQLTransaction& trans, MoveItemData* pOther, uint32 splitedAmount) override;
         Item* StoreItem(SQLTransaction& trans, Item* pItem) override;
-        void LogBankEvent(SQLTransaction& trans, MoveItemData* pFrom, uint32 count) const override;
+        void LogBankEvent(MoveItemData* pFrom, uint32 count) const override;
         void LogAction(MoveItemData* pFrom) const override;
 
     protected:
@@ -713,13 +739,23 @@ public:
     bool LoadFromDB(Field* fields);
     void LoadRankFromDB(Field* fields);
     bool LoadMemberFromDB(Field* fields);
-    bool LoadEventLogFromDB(Field* fields);
+    void LoadEventLogGuidFromDB(Field* fields);
     void LoadBankRightFromDB(Field* fields);
     void LoadBankTabFromDB(Field* fields);
-    bool LoadBankEventLogFromDB(Field* fields);
+    void LoadBankEventLogGuidFromDB(Field* fields);
     bool LoadBankItemFromDB(Field* fields);
     bool Validate();
 
+    // Events older than this session are read from DB when the log is opened for the first time.
+    // The queries return nullptr when there is nothing to read.
+    PreparedStatement* GetEventLogQuery();
+    PreparedStatement* GetBankEventLogQuery(uint8 tabId);
+    void LoadEventLog(PreparedQueryResult result);
+    void LoadBankEventLog(uint8 tabId, PreparedQueryResult result);
+
+    // Saves the log events added since the last call, returns false if there were none
+    bool SaveLogsToDB(SQLTransaction& trans);
+
     // Broadcasts
     void BroadcastToGuild(WorldSession* session, bool officerOnly, std::string const& msg, uint32 language = LANG_UNIVERSAL) const;
     void BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const;
@@ -775,7 +811,6 @@ protected:
     Members m_members;
     BankTabs m_bankTabs;
 
-    // These are actually ordered lists. The first element is the oldest entry.
     LogHolder* m_eventLog;
     LogHolder* m_bankEventLog[GUILD_BANK_MAX_TABS + 1];
 
@@ -833,7 +868,7 @@ private:
     bool _MemberHasTabRights(uint64 guid, uint8 tabId, uint32 rights) const;
 
     void _LogEvent(GuildEventLogTypes eventType, uint32 playerGuid1, uint32 playerGuid2 = 0, uint8 newRank = 0);
-    void _LogBankEvent(SQLTransaction& trans, GuildBankEventLogTypes eventType, uint8 tabId, uint32 playerGuid, uint32 itemOrMoney, uint16 itemStackCount = 0, uint8 destTabId = 0);
+    void _LogBankEvent(GuildBankEventLogTypes eventType, uint8 tabId, uint32 playerGuid, uint32 itemOrMoney, uint16 itemStackCount = 0, uint8 destTabId = 0);
 
     Item* _GetItem(uint8 tabId, uint8 slotId) const;
     void _RemoveItem(SQLTransaction& trans, uint8 tabId, uint8 slotId);
@@ -6,6 +6,9 @@
 
 #include "Common.h"
 #include "GuildMgr.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "WhoListCache.h"
 
 GuildMgr::GuildMgr() : NextGuildId(1)
 { }
@@ -25,6 +28,10 @@ GuildMgr* GuildMgr::instance()
 void GuildMgr::AddGuild(Guild* guild)
 {
     GuildStore[guild->GetId()] = guild;
+
+    // the leader joined before the guild was registered, so its /who entry has no guild name yet
+    if (Player* leader = ObjectAccessor::FindPlayerInOrOutOfWorld(guild->GetLeaderGUID()))
+        WhoListCacheMgr::UpdateGuild(leader);
 }
 
 void GuildMgr::RemoveGuild(uint32 guildId)
@@ -239,19 +246,17 @@ void GuildMgr::LoadGuilds()
         }
     }
 
-    // 5. Load all event logs
-    LOG_INFO("server", "Loading guild event logs...");
+    // 5. Load event log sequences, the events are read when a log is opened
+    LOG_INFO("server", "Loading guild event log guids...");
     {
         uint32 oldMSTime = getMSTime();
 
-        CharacterDatabase.DirectPExecute("DELETE FROM guild_eventlog WHERE LogGuid > %u", sWorld->getIntConfig(CONFIG_GUILD_EVENT_LOG_COUNT));
-
-        //          0        1        2          3            4            5        6
-        QueryResult result = CharacterDatabase.Query("SELECT guildid, LogGuid, EventType, PlayerGuid1, PlayerGuid2, NewRank, TimeStamp FROM guild_eventlog ORDER BY TimeStamp DESC, LogGuid DESC");
+        //          0        1
+        QueryResult result = CharacterDatabase.Query("SELECT guildid, MAX(LogGuid) FROM guild_eventlog GROUP BY guildid");
 
         if (!result)
         {
-            LOG_INFO("server", ">> Loaded 0 guild event logs. DB table `guild_eventlog` is empty.");
+            LOG_INFO("server", ">> Loaded 0 guild event log guids. DB table `guild_eventlog` is empty.");
             LOG_INFO("server", " ");
         }
         else
@@ -263,30 +268,27 @@ void GuildMgr::LoadGuilds()
                 uint32 guildId = fields[0].GetUInt32();
 
                 if (Guild* guild = GetGuildById(guildId))
-                    guild->LoadEventLogFromDB(fields);
+                    guild->LoadEventLogGuidFromDB(fields);
 
                 ++count;
             } while (result->NextRow());
 
-            LOG_INFO("server", ">> Loaded %u guild event logs in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+            LOG_INFO("server", ">> Loaded %u guild event log guids in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
             LOG_INFO("server", " ");
         }
     }
 
-    // 6. Load all bank event logs
-    LOG_INFO("server", "Loading guild bank event logs...");
+    // 6. Load bank event log sequences
+    LOG_INFO("server", "Loading guild bank event log guids...");
     {
         uint32 oldMSTime = getMSTime();
 
-        // Remove log entries that exceed the number of allowed entries per guild
-        CharacterDatabase.DirectPExecute("DELETE FROM guild_bank_eventlog WHERE LogGuid > %u", sWorld->getIntConfig(CONFIG_GUILD_BANK_EVENT_LOG_COUNT));
-
-        //          0        1      2        3          4           5            6               7          8
-        QueryResult result = CharacterDatabase.Query("SELECT guildid, TabId, LogGuid, EventType, PlayerGuid, ItemOrMoney, ItemStackCount, DestTabId, TimeStamp FROM guild_bank_eventlog ORDER BY TimeStamp DESC, LogGuid DESC");
+        //          0        1      2
+        QueryResult result = CharacterDatabase.Query("SELECT guildid, TabId, MAX(LogGuid) FROM guild_bank_eventlog GROUP BY guildid, TabId");
 
         if (!result)
         {
-            LOG_INFO("server", ">> Loaded 0 guild bank event logs. DB table `guild_bank_eventlog` is empty.");
+            LOG_INFO("server", ">> Loaded 0 guild bank event log guids. DB table `guild_bank_eventlog` is empty.");
             LOG_INFO("server", " ");
         }
         else
@@ -298,12 +300,12 @@ void GuildMgr::LoadGuilds()
                 uint32 guildId = fields[0].GetUInt32();
 
                 if (Guild* guild = GetGuildById(guildId))
-                    guild->LoadBankEventLogFromDB(fields);
+                    guild->LoadBankEventLogGuidFromDB(fields);
 
                 ++count;
             } while (result->NextRow());
 
-            LOG_INFO("server", ">> Loaded %u guild bank event logs in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+            LOG_INFO("server", ">> Loaded %u guild bank event log guids in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
             LOG_INFO("server", " ");
         }
     }
@@ -406,3 +408,15 @@ void GuildMgr::ResetTimes()
 
     CharacterDatabase.DirectExecute("TRUNCATE guild_member_withdraw");
 }
+
+void GuildMgr::SaveGuildLogs()
+{
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+
+    bool saved = false;
+    for (GuildContainer::const_iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
+        saved |= itr->second->SaveLogsToDB(trans);
+
+    if (saved)
+        CharacterDatabase.CommitTransaction(trans);
+}
@@ -31,6 +31,8 @@ public:
     void SetNextGuildId(uint32 Id) { NextGuildId = Id; }
 
     void ResetTimes();
+    // Saves the guild log events added since the last call in one transaction
+    void SaveGuildLogs();
 protected:
     typedef std::unordered_map<uint32, Guild*> GuildContainer;
     uint32 NextGuildId;
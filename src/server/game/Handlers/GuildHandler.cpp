@@ -377,7 +377,31 @@ void WorldSession::HandleGuildEventLogQueryOpcode(WorldPacket& /* recvPacket */)
 #endif
 
     if (Guild* guild = GetPlayer()->GetGuild())
-        guild->SendEventLog(this);
+    {
+        // the events older than this session are read from DB when the log is opened for the first time,
+        // the pending query sends the log once it is loaded
+        if (_guildEventLogCallback.GetParam() == guild->GetId())
+            return;
+
+        if (PreparedStatement* stmt = guild->GetEventLogQuery())
+        {
+            _guildEventLogCallback.SetParam(guild->GetId());
+            _guildEventLogCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+        }
+        else
+            guild->SendEventLog(this);
+    }
+}
+
+void WorldSession::HandleGuildEventLogQueryCallback(PreparedQueryResult result, uint32 guildId)
+{
+    // the player may have left the guild meanwhile
+    Guild* guild = GetPlayer() ? GetPlayer()->GetGuild() : nullptr;
+    if (!guild || guild->GetId() != guildId)
+        return;
+
+    guild->LoadEventLog(result);
+    guild->SendEventLog(this);
 }
 
 void WorldSession::HandleGuildBankMoneyWithdrawn(WorldPacket& /* recvData */)
@@ -605,9 +629,60 @@ void WorldSession::HandleGuildBankLogQuery(WorldPacket& recvData)
 #endif
 
     if (Guild* guild = GetPlayer()->GetGuild())
+    {
+        // only one tab is read at a time, the others wait for it: their logs may not be loaded yet
+        if (_guildBankLogCallback.GetFirstParam() == guild->GetId())
+        {
+            if (_guildBankLogCallback.GetSecondParam() != tabId && tabId <= GUILD_BANK_MAX_TABS)
+                _guildBankLogQueuedTabs |= 1 << tabId;
+            return;
+        }
+
+        QueryGuildBankLog(guild, tabId);
+    }
+}
+
+void WorldSession::QueryGuildBankLog(Guild* guild, uint8 tabId)
+{
+    if (PreparedStatement* stmt = guild->GetBankEventLogQuery(tabId))
+    {
+        _guildBankLogCallback.SetFirstParam(guild->GetId());
+        _guildBankLogCallback.SetSecondParam(tabId);
+        _guildBankLogCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    }
+    else
         guild->SendBankLog(this, tabId);
 }
 
+void WorldSession::SendQueuedGuildBankLogs()
+{
+    Guild* guild = GetPlayer() ? GetPlayer()->GetGuild() : nullptr;
+
+    // stops at the next tab that has to be read, its callback goes on with the others
+    for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS && _guildBankLogQueuedTabs && !_guildBankLogCallback.GetFirstParam(); ++tabId)
+    {
+        if (!(_guildBankLogQueuedTabs & (1 << tabId)))
+            continue;
+
+        _guildBankLogQueuedTabs &= ~(1 << tabId);
+        if (guild)
+            QueryGuildBankLog(guild, tabId);
+    }
+
+    if (!guild)
+        _guildBankLogQueuedTabs = 0;
+}
+
+void WorldSession::HandleGuildBankLogQueryCallback(PreparedQueryResult result, uint32 guildId, uint8 tabId)
+{
+    Guild* guild = GetPlayer() ? GetPlayer()->GetGuild() : nullptr;
+    if (!guild || guild->GetId() != guildId)
+        return;
+
+    guild->LoadBankEventLog(tabId, result);
+    guild->SendBankLog(this, tabId);
+}
+
 void WorldSession::HandleQueryGuildBankTabText(WorldPacket& recvData)
 {
     uint8 tabId;
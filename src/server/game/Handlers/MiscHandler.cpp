@@ -291,96 +291,62 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     data << uint32(matchcount);                           // placeholder, count of players matching criteria
     data << uint32(displaycount);                         // placeholder, count of players displayed
 
-    std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
+    uint32 teamMask = (1 << TEAM_ALLIANCE) | (1 << TEAM_HORDE);
+    if (AccountMgr::IsPlayerAccount(security) && !allowTwoSideWhoList)
+        teamMask = 1 << team;
+
+    std::shared_lock<std::shared_mutex> lock(WhoListCacheMgr::GetLock());
+    WhoListIndex::EntryList candidates;
+    WhoListCacheMgr::GetIndex().Search(teamMask, level_min, level_max, std::vector<uint32>(zoneids, zoneids + zones_count), candidates);
+    for (WhoListPlayerInfo const* target : candidates)
     {
-        if (AccountMgr::IsPlayerAccount(security))
-        {
-            // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
-            if (itr->second->GetTeamId() != team  && !allowTwoSideWhoList)
-                continue;
-
-            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if ((itr->second->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList)))
-                continue;
-        }
+        // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+        if (AccountMgr::IsPlayerAccount(security) && target->player->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList))
+            continue;
 
         //do not process players which are not in world
-        if (!(itr->second->IsInWorld()))
+        if (!(target->player->IsInWorld()))
             continue;
 
         // check if target is globally visible for player
-        if (!(itr->second->IsVisibleGloballyFor(_player)))
-            continue;
-
-        // check if target's level is in level range
-        uint8 lvl = itr->second->getLevel();
-        if (lvl < level_min || lvl > level_max)
+        if (!(target->player->IsVisibleGloballyFor(_player)))
             continue;
 
         // check if class matches classmask
-        uint32 class_ = itr->second->getClass();
-        if (!(classmask & (1 << class_)))
+        if (!(classmask & (1 << target->clas)))
             continue;
 
         // check if race matches racemask
-        uint32 race = itr->second->getRace();
-        if (!(racemask & (1 << race)))
-            continue;
-
-        uint32 pzoneid = itr->second->GetZoneId();
-        uint8 gender = itr->second->getGender();
-
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
-            {
-                z_show = true;
-                break;
-            }
-
-            z_show = false;
-        }
-        if (!z_show)
-            continue;
-
-        std::string pname = itr->second->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-            continue;
-        wstrToLower(wpname);
-
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
+        if (!(racemask & (1 << target->race)))
             continue;
 
-        std::string gname = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
+        if (!(wplayer_name.empty() || target->wpname.find(wplayer_name) != std::wstring::npos))
             continue;
-        wstrToLower(wgname);
 
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
+        if (!(wguild_name.empty() || target->wgname.find(wguild_name) != std::wstring::npos))
             continue;
 
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(itr->second->GetZoneId()))
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
-
         bool s_show = true;
-        for (uint32 i = 0; i < str_count; ++i)
+        if (str_count)
         {
-            if (!str[i].empty())
+            std::string aname;
+            if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(target->zoneid))
+                aname = areaEntry->area_name[GetSessionDbcLocale()];
+
+            for (uint32 i = 0; i < str_count; ++i)
             {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                        wpname.find(str[i]) != std::wstring::npos ||
-                        Utf8FitTo(aname, str[i]))
+                if (!str[i].empty())
                 {
-                    s_show = true;
-                    break;
+                    if (target->wgname.find(str[i]) != std::wstring::npos ||
+                            target->wpname.find(str[i]) != std::wstring::npos ||
+                            Utf8FitTo(aname, str[i]))
+                    {
+                        s_show = true;
+                        break;
+                    }
+                    s_show = false;
                 }
-                s_show = false;
             }
         }
         if (!s_show)
@@ -391,13 +357,13 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
         if ((matchcount++) >= sWorld->getIntConfig(CONFIG_MAX_WHO_LIST_RETURN))
             continue;
 
-        data << pname;                                    // player name
-        data << gname;                                    // guild name
-        data << uint32(lvl);                              // player level
-        data << uint32(class_);                           // player class
-        data << uint32(race);                             // player race
-        data << uint8(gender);                            // player gender
-        data << uint32(pzoneid);                          // player zone id
+        data << target->pname;                            // player name
+        data << target->gname;                            // guild name
+        data << uint32(target->level);                    // player level
+        data << uint32(target->clas);                     // player class
+        data << uint32(target->race);                     // player race
+        data << uint8(target->gender);                    // player gender
+        data << uint32(target->zoneid);                   // player zone id
 
         ++displaycount;
     }
@@ -6,6 +6,7 @@
 
 #include "AccountMgr.h"
 #include "Language.h"
+#include "LFGMgr.h"
 #include "Log.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -125,6 +126,11 @@ void WorldSession::HandleAddIgnoreOpcode(WorldPacket& recv_data)
         // ignore list full
         if (!GetPlayer()->GetSocial()->AddToSocialList(lowGuid, SOCIAL_FLAG_IGNORED))
             ignoreResult = FRIEND_IGNORE_FULL;
+        else
+        {
+            sLFGMgr->AddIgnore(GetPlayer()->GetGUID(), lowGuid);
+            GetPlayer()->UpdateChannelIgnores(IgnoreGuid);
+        }
     }
 
     sSocialMgr->SendFriendStatus(GetPlayer(), ignoreResult, lowGuid, false);
@@ -138,6 +144,8 @@ void WorldSession::HandleDelIgnoreOpcode(WorldPacket& recv_data)
     recv_data >> IgnoreGUID;
 
     _player->GetSocial()->RemoveFromSocialList(GUID_LOPART(IgnoreGUID), SOCIAL_FLAG_IGNORED);
+    sLFGMgr->RemoveIgnore(_player->GetGUID(), GUID_LOPART(IgnoreGUID));
+    _player->UpdateChannelIgnores(IgnoreGUID);
     sSocialMgr->SendFriendStatus(GetPlayer(), FRIEND_IGNORE_REMOVED, GUID_LOPART(IgnoreGUID), false);
 }
 
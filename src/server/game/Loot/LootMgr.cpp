@@ -74,37 +74,6 @@ private:
     uint16 _lootMode;
 };
 
-class LootTemplate::LootGroup                               // A set of loot definitions for items (refs are not allowed)
-{
-public:
-    LootGroup() { }
-    ~LootGroup();
-
-    void AddEntry(LootStoreItem* item);                 // Adds an entry to the group (at loading stage)
-    bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
-    bool HasQuestDropForPlayer(Player const* player) const;
-    // The same for active quests of the player
-    void Process(Loot& loot, Player const* player, LootStore const& lootstore, uint16 lootMode) const;    // Rolls an item from the group (if any) and adds the item to the loot
-    float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
-    float TotalChance() const;                          // Overall chance for the group
-
-    void Verify(LootStore const& lootstore, uint32 id, uint8 group_id) const;
-    void CollectLootIds(LootIdSet& set) const;
-    void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
-    LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
-    LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
-    void CopyConditions(ConditionList conditions);
-private:
-    LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
-    LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
-
-    LootStoreItem const* Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const;   // Rolls an item from the group, returns nullptr if all miss their chances
-
-    // This class must never be copied - storing pointers
-    LootGroup(LootGroup const&);
-    LootGroup& operator=(LootGroup const&);
-};
-
 //Remove all data and free all memory
 void LootStore::Clear()
 {
@@ -192,6 +161,9 @@ uint32 LootStore::LoadLootTable()
         ++count;
     } while (result->NextRow());
 
+    for (LootTemplateMap::const_iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
+        itr->second->Compile();
+
     Verify();                                           // Checks validity of the loot store
 
     return count;
@@ -1161,28 +1133,31 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
 // Rolls an item from the group, returns nullptr if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const
 {
-    LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
-
-    if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
+    // No entry filtered out and no script changing the chances: the precomputed tables give the same pick as the filtered walk
+    if ((CommonLootMode & lootMode) && !sScriptMgr->HasItemRollHooks() && !HasItemIn(loot))
     {
-        float roll = (float)rand_chance();
+        if (!CumulativeChance.empty())
+            if (LootStoreItem const* item = PickExplicitlyChanced((float)rand_chance()))
+                return item;
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
-        {
-            LootStoreItem* item = *itr;
-            float chance = item->chance;
+        if (!EqualChancedItems.empty())
+            return acore::Containers::SelectRandomContainerElement(EqualChancedItems);
 
-            sScriptMgr->OnItemRoll(player, item, chance, loot, store);
+        return nullptr;
+    }
 
-            if (chance >= 100.0f)
-                return item;
+    return RollFiltered(loot, player, store, lootMode);
+}
 
-            roll -= chance;
-            if (roll < 0)
-                return item;
-        }
-    }
+// Rolls an item from a copy of the group without the entries of other loot modes or already in the loot, the scripts may change each chance
+LootStoreItem const* LootTemplate::LootGroup::RollFiltered(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const
+{
+    LootStoreItemList possibleLoot = ExplicitlyChanced;
+    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+
+    if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
+        if (LootStoreItem const* item = PickExplicitlyChanced(possibleLoot, (float)rand_chance(), loot, player, store))
+            return item;
 
     possibleLoot = EqualChanced;
     possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
@@ -1192,29 +1167,88 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* pla
     return nullptr;                                            // Empty drop from the group
 }
 
-// True if group includes at least 1 quest drop entry
-bool LootTemplate::LootGroup::HasQuestDrop() const
+// Picks the explicitly chanced entry hit by the roll from the roll tables
+LootStoreItem const* LootTemplate::LootGroup::PickExplicitlyChanced(float roll) const
 {
-    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
-        if ((*i)->needs_quest)
-            return true;
+    std::vector<float>::const_iterator itr = std::upper_bound(CumulativeChance.begin(), CumulativeChance.end(), roll);
+    if (itr == CumulativeChance.end())
+        return nullptr;
+
+    return RollItems[itr - CumulativeChance.begin()];
+}
+
+// Picks the explicitly chanced entry hit by the roll walking the list, the scripts may change each chance
+LootStoreItem const* LootTemplate::LootGroup::PickExplicitlyChanced(LootStoreItemList const& possibleLoot, float roll, Loot& loot, Player const* player, LootStore const& store)
+{
+    for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
+    {
+        LootStoreItem* item = *itr;
+        float chance = item->chance;
+
+        sScriptMgr->OnItemRoll(player, item, chance, loot, store);
+
+        if (chance >= 100.0f)
+            return item;
+
+        roll -= chance;
+        if (roll < 0)
+            return item;
+    }
+
+    return nullptr;
+}
 
-    for (LootStoreItemList::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
-        if ((*i)->needs_quest)
+void LootTemplate::LootGroup::Compile()
+{
+    RollItems.assign(ExplicitlyChanced.begin(), ExplicitlyChanced.end());
+    EqualChancedItems.assign(EqualChanced.begin(), EqualChanced.end());
+
+    CumulativeChance.clear();
+    CumulativeChance.reserve(RollItems.size());
+    float total = 0.0f;
+    for (LootStoreItem const* item : RollItems)
+    {
+        total += item->chance;
+        CumulativeChance.push_back(total);
+    }
+
+    ItemIds.clear();
+    CommonLootMode = 0xFFFF;
+    QuestDrop = false;
+    for (LootStoreItemList const* list : { &ExplicitlyChanced, &EqualChanced })
+    {
+        for (LootStoreItem const* item : *list)
+        {
+            ItemIds.push_back(item->itemid);
+            CommonLootMode &= item->lootmode;
+            QuestDrop = QuestDrop || item->needs_quest;
+        }
+    }
+
+    std::sort(ItemIds.begin(), ItemIds.end());
+    ItemIds.erase(std::unique(ItemIds.begin(), ItemIds.end()), ItemIds.end());
+}
+
+bool LootTemplate::LootGroup::HasItemIn(Loot const& loot) const
+{
+    for (LootItem const& item : loot.items)
+        if (std::binary_search(ItemIds.begin(), ItemIds.end(), item.itemid))
             return true;
 
     return false;
 }
 
+// True if group includes at least 1 quest drop entry
+bool LootTemplate::LootGroup::HasQuestDrop() const
+{
+    return QuestDrop;
+}
+
 // True if group includes at least 1 quest drop entry for active quests of the player
 bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player) const
 {
-    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
-        if (player->HasQuestForItem((*i)->itemid))
-            return true;
-
-    for (LootStoreItemList::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
-        if (player->HasQuestForItem((*i)->itemid))
+    for (uint32 itemId : ItemIds)
+        if (player->HasQuestForItem(itemId))
             return true;
 
     return false;
@@ -1333,6 +1367,36 @@ void LootTemplate::AddEntry(LootStoreItem* item)
         Entries.push_back(item);
 }
 
+void LootTemplate::Compile()
+{
+    CompiledEntries.clear();
+    CompiledEntries.reserve(Entries.size());
+    for (LootStoreItem* item : Entries)
+    {
+        ItemTemplate const* proto = item->reference ? nullptr : sObjectMgr->GetItemTemplate(item->itemid);
+        CompiledEntries.push_back({ item, uint8(proto ? proto->Quality : MAX_ITEM_QUALITY) });
+    }
+
+    for (LootGroup* group : Groups)
+        if (group)
+            group->Compile();
+}
+
+// LootStoreItem::Roll with the item quality resolved at loading, used when no script can change the chance
+bool LootTemplate::RollCompiledEntry(CompiledEntry const& entry, bool rate)
+{
+    LootStoreItem const* item = entry.Item;
+    if (item->chance >= 100.0f)
+        return true;
+
+    if (item->reference > 0)                                   // reference case
+        return roll_chance_f(item->chance * (rate ? sWorld->getRate(RATE_DROP_ITEM_REFERENCED) : 1.0f));
+
+    float qualityModifier = entry.Quality < MAX_ITEM_QUALITY && rate ? sWorld->getRate(qualityToRate[entry.Quality]) : 1.0f;
+
+    return roll_chance_f(item->chance * qualityModifier);
+}
+
 void LootTemplate::CopyConditions(ConditionList conditions)
 {
     for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
@@ -1374,14 +1438,16 @@ void LootTemplate::Process(Loot& loot, LootStore const& store, uint16 lootMode,
         return;
     }
 
+    bool const rollHooks = sScriptMgr->HasItemRollHooks();
+
     // Rolling non-grouped items
-    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
+    for (CompiledEntry const& entry : CompiledEntries)
     {
-        LootStoreItem* item = *i;
+        LootStoreItem* item = entry.Item;
         if (!(item->lootmode & lootMode))                         // Do not add if mode mismatch
             continue;
 
-        if (!item->Roll(rate, player, loot, store))
+        if (rollHooks ? !item->Roll(rate, player, loot, store) : !RollCompiledEntry(entry, rate))
             continue;                                           // Bad luck for the entry
 
         if (item->reference > 0)                            // References processing
@@ -1516,12 +1582,12 @@ void LootTemplate::CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_se
             group->CheckLootRefs(store, ref_set);
 }
 
-bool LootTemplate::addConditionItem(Condition* cond)
+ConditionList* LootTemplate::addConditionItem(Condition* cond)
 {
     if (!cond || !cond->isLoaded())//should never happen, checked at loading
     {
         LOG_ERROR("server", "LootTemplate::addConditionItem: condition is null");
-        return false;
+        return nullptr;
     }
 
     if (!Entries.empty())
@@ -1531,7 +1597,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
             if ((*i)->itemid == uint32(cond->SourceEntry))
             {
                 (*i)->conditions.push_back(cond);
-                return true;
+                return &(*i)->conditions;
             }
         }
     }
@@ -1552,7 +1618,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
                         (*i)->conditions.push_back(cond);
-                        return true;
+                        return &(*i)->conditions;
                     }
                 }
             }
@@ -1565,13 +1631,13 @@ bool LootTemplate::addConditionItem(Condition* cond)
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
                         (*i)->conditions.push_back(cond);
-                        return true;
+                        return &(*i)->conditions;
                     }
                 }
             }
         }
     }
-    return false;
+    return nullptr;
 }
 
 bool LootTemplate::isReference(uint32 id) const
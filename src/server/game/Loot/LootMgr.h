@@ -228,15 +228,26 @@ private:
 
 class LootTemplate
 {
+public:
     class LootGroup;                                       // A set of loot definitions for items (refs are not allowed inside)
+
+private:
     typedef std::vector<LootGroup*> LootGroups;
 
+    struct CompiledEntry                                   // A non-grouped entry with what its roll needs, resolved at loading
+    {
+        LootStoreItem* Item;
+        uint8 Quality;                                     // selects the drop rate, MAX_ITEM_QUALITY for references
+    };
+
 public:
     LootTemplate() = default;
     ~LootTemplate();
 
     // Adds an entry to the group (at loading stage)
     void AddEntry(LootStoreItem* item);
+    // Builds the roll tables of the template and its groups, once all entries are added
+    void Compile();
     // Rolls for every item in the template and adds the rolled items the the loot
     void Process(Loot& loot, LootStore const& store, uint16 lootMode, Player const* player, uint8 groupId = 0) const;
     void CopyConditions(ConditionList conditions);
@@ -250,18 +261,68 @@ public:
     // Checks integrity of the template
     void Verify(LootStore const& store, uint32 Id) const;
     void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
-    bool addConditionItem(Condition* cond);
+    ConditionList* addConditionItem(Condition* cond);   // returns the list of the item the condition was added to
     [[nodiscard]] bool isReference(uint32 id) const;
 
 private:
     LootStoreItemList Entries;                          // not grouped only
     LootGroups        Groups;                           // groups have own (optimised) processing, grouped entries go there
+    std::vector<CompiledEntry> CompiledEntries;         // Entries in roll order, filled by Compile()
+
+    static bool RollCompiledEntry(CompiledEntry const& entry, bool rate);
 
     // Objects of this class must never be copied, we are storing pointers in container
     LootTemplate(LootTemplate const&);
     LootTemplate& operator=(LootTemplate const&);
 };
 
+class LootTemplate::LootGroup                               // A set of loot definitions for items (refs are not allowed)
+{
+public:
+    LootGroup() { }
+    ~LootGroup();
+
+    void AddEntry(LootStoreItem* item);                 // Adds an entry to the group (at loading stage)
+    void Compile();                                     // Builds the roll tables once all entries are added
+    bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
+    bool HasQuestDropForPlayer(Player const* player) const;
+    // The same for active quests of the player
+    void Process(Loot& loot, Player const* player, LootStore const& lootstore, uint16 lootMode) const;    // Rolls an item from the group (if any) and adds the item to the loot
+    float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
+    float TotalChance() const;                          // Overall chance for the group
+
+    void Verify(LootStore const& lootstore, uint32 id, uint8 group_id) const;
+    void CollectLootIds(LootIdSet& set) const;
+    void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
+    LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
+    LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
+    void CopyConditions(ConditionList conditions);
+
+    // The explicitly chanced entry hit by a roll in [0, 100), nullptr if the roll is past all chances
+    LootStoreItem const* PickExplicitlyChanced(float roll) const;
+    static LootStoreItem const* PickExplicitlyChanced(LootStoreItemList const& possibleLoot, float roll, Loot& loot, Player const* player, LootStore const& store);
+    // The roll without the roll tables, used while entries are filtered out or scripts may change the chances
+    LootStoreItem const* RollFiltered(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const;
+private:
+    LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
+    LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+
+    // Roll tables, filled by Compile()
+    std::vector<LootStoreItem*> RollItems;              // ExplicitlyChanced in roll order
+    std::vector<float> CumulativeChance;                // Running total of the RollItems chances, one roll picks an entry by binary search
+    std::vector<LootStoreItem*> EqualChancedItems;
+    std::vector<uint32> ItemIds;                        // Sorted ids of all entries
+    uint16 CommonLootMode = 0;                          // Loot modes set on every entry
+    bool QuestDrop = false;
+
+    bool HasItemIn(Loot const& loot) const;             // True if an entry of the group is already in the loot
+    LootStoreItem const* Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const;   // Rolls an item from the group, returns nullptr if all miss their chances
+
+    // This class must never be copied - storing pointers
+    LootGroup(LootGroup const&);
+    LootGroup& operator=(LootGroup const&);
+};
+
 //=====================================================
 
 class LootValidatorRef :  public Reference<Loot, LootValidatorRef>
@@ -24,6 +24,7 @@
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
+#include "WhoListCache.h"
 
 #ifdef ELUNA
 #include "LuaEngine.h"
@@ -390,11 +391,7 @@ template<>
 void Map::DeleteFromWorld(Player* player)
 {
     sObjectAccessor->RemoveObject(player);
-
-    // pussywizard: optimization
-    std::string charName = player->GetName();
-    std::transform(charName.begin(), charName.end(), charName.begin(), ::tolower);
-    sObjectAccessor->playerNameToPlayerPointer.erase(charName);
+    WhoListCacheMgr::RemovePlayer(player);
 
     sObjectAccessor->RemoveUpdateObject(player); //TODO: I do not know why we need this, it should be removed in ~Object anyway
     delete player;
@@ -4,7 +4,6 @@
  * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
  */
 
-#include "AvgDiffTracker.h"
 #include "CellImpl.h"
 #include "Chat.h"
 #include "Config.h"
@@ -254,20 +253,6 @@ void MapManager::Update(uint32 diff)
     for (uint8 i = 0; i < 4; ++i)
         i_timer[i].Update(diff);
 
-    // pussywizard: lfg compatibles update, schedule before maps so it is processed from the very beginning
-    //if (mapUpdateStep == 0)
-    {
-        if (m_updater.activated())
-            m_updater.schedule_lfg_update(diff);
-        else
-        {
-            uint32 startTime = getMSTime();
-            sLFGMgr->Update(diff, 1);
-            uint32 totalTime = getMSTimeDiff(startTime, getMSTime());
-            lfgDiffTracker.Update(10000 + totalTime); // +10k to mark it was NOT multithreaded
-        }
-    }
-
     MapMapType::iterator iter = i_maps.begin();
     for (; iter != i_maps.end(); ++iter)
     {
@@ -4,8 +4,6 @@
  * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
  */
 
-#include "AvgDiffTracker.h"
-#include "LFGMgr.h"
 #include "Map.h"
 #include "MapUpdater.h"
 
@@ -38,24 +36,6 @@ private:
     uint32 s_diff;
 };
 
-class LFGUpdateRequest : public UpdateRequest
-{
-public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : m_updater(u), m_diff(d) {}
-
-    void call() override
-    {
-        uint32 startTime = getMSTime();
-        sLFGMgr->Update(m_diff, 1);
-        uint32 totalTime = getMSTimeDiff(startTime, getMSTime());
-        lfgDiffTracker.Update(totalTime);
-        m_updater.update_finished();
-    }
-private:
-    MapUpdater& m_updater;
-    uint32 m_diff;
-};
-
 MapUpdater::MapUpdater(): pending_requests(0)
 {
 }
@@ -106,15 +86,6 @@ void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
     _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
 }
 
-void MapUpdater::schedule_lfg_update(uint32 diff)
-{
-    std::lock_guard<std::mutex> guard(_lock);
-
-    ++pending_requests;
-
-    _queue.Push(new LFGUpdateRequest(*this, diff));
-}
-
 bool MapUpdater::activated()
 {
     return _workerThreads.size() > 0;
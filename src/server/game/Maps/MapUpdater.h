@@ -17,7 +17,6 @@ public:
     virtual ~MapUpdater();
 
     void schedule_update(Map& map, uint32 diff, uint32 s_diff);
-    void schedule_lfg_update(uint32 diff);
     void wait();
     void activate(size_t num_threads);
     void deactivate();
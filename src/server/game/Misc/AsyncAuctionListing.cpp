@@ -6,13 +6,66 @@
 #include "Player.h"
 #include "SpellAuraEffects.h"
 
-uint32 AsyncAuctionListingMgr::auctionListingDiff = 0;
-bool AsyncAuctionListingMgr::auctionListingAllowed = false;
+std::atomic<uint32> AsyncAuctionListingMgr::auctionListingDiff(0);
+std::atomic<bool> AsyncAuctionListingMgr::auctionListingAllowed(false);
 std::list<AuctionListItemsDelayEvent> AsyncAuctionListingMgr::auctionListingList;
 std::list<AuctionListItemsDelayEvent> AsyncAuctionListingMgr::auctionListingListTemp;
-std::mutex AsyncAuctionListingMgr::auctionListingLock;
+std::mutex AsyncAuctionListingMgr::auctionListingListLock;
+std::shared_mutex AsyncAuctionListingMgr::auctionListingLock;
 std::mutex AsyncAuctionListingMgr::auctionListingTempLock;
 
+bool AsyncAuctionListingMgr::ExecuteNext()
+{
+    if (!IsAuctionListingAllowed())
+        return false;
+
+    std::list<AuctionListItemsDelayEvent> due;
+    {
+        std::lock_guard<std::mutex> guard(auctionListingListLock);
+
+        {
+            std::lock_guard<std::mutex> tempGuard(auctionListingTempLock);
+            auctionListingList.splice(auctionListingList.end(), auctionListingListTemp);
+        }
+
+        uint32 diff = auctionListingDiff.exchange(0);
+        if (diff)
+        {
+            for (AuctionListItemsDelayEvent& event : auctionListingList)
+                event._msTimer = event._msTimer <= diff ? 0 : event._msTimer - diff;
+        }
+
+        for (std::list<AuctionListItemsDelayEvent>::iterator itr = auctionListingList.begin(); itr != auctionListingList.end(); ++itr)
+        {
+            if (itr->_msTimer == 0)
+            {
+                due.splice(due.end(), auctionListingList, itr);
+                break;
+            }
+        }
+    }
+
+    if (due.empty())
+        return false;
+
+    bool done = false;
+    {
+        std::shared_lock<std::shared_mutex> guard(auctionListingLock);
+        // World::Update may have started waiting for us meanwhile
+        if (IsAuctionListingAllowed())
+            done = due.front().Execute();
+    }
+
+    // not finished, try again first thing
+    if (!done)
+    {
+        std::lock_guard<std::mutex> guard(auctionListingListLock);
+        auctionListingList.splice(auctionListingList.begin(), due);
+    }
+
+    return true;
+}
+
 bool AuctionListOwnerItemsDelayEvent::Execute(uint64  /*e_time*/, uint32  /*p_time*/)
 {
     if (Player* plr = ObjectAccessor::FindPlayer(playerguid))
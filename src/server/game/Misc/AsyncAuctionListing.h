@@ -4,6 +4,8 @@
 #include "Common.h"
 #include "EventProcessor.h"
 #include "WorldPacket.h"
+#include <atomic>
+#include <shared_mutex>
 
 class AuctionListOwnerItemsDelayEvent : public BasicEvent
 {
@@ -44,26 +46,33 @@ public:
     uint8 _getAll;
 };
 
+/*
+ * Listing threads search the published auction snapshots (AuctionHouseSearchSnapshots), so they run
+ * side by side and never block the auction changes of the world thread. They still hold GetLock() shared
+ * while they run an event, World::Update takes it exclusively around UpdateSessions only, as players
+ * may leave the world there.
+ */
 class AsyncAuctionListingMgr
 {
 public:
     static void Update(uint32 diff) { auctionListingDiff += diff; }
-    static uint32 GetDiff() { return auctionListingDiff; }
-    static void ResetDiff() { auctionListingDiff = 0; }
     static bool IsAuctionListingAllowed() { return auctionListingAllowed; }
     static void SetAuctionListingAllowed(bool a) { auctionListingAllowed = a; }
 
-    static std::list<AuctionListItemsDelayEvent>& GetList() { return auctionListingList; }
     static std::list<AuctionListItemsDelayEvent>& GetTempList() { return auctionListingListTemp; }
-    static std::mutex& GetLock() { return auctionListingLock; }
+    static std::shared_mutex& GetLock() { return auctionListingLock; }
     static std::mutex& GetTempLock() { return auctionListingTempLock; }
 
+    // Runs the first due listing event, called by every listing thread. Returns false if none was due
+    static bool ExecuteNext();
+
 private:
-    static uint32 auctionListingDiff;
-    static bool auctionListingAllowed;
+    static std::atomic<uint32> auctionListingDiff;
+    static std::atomic<bool> auctionListingAllowed;
     static std::list<AuctionListItemsDelayEvent> auctionListingList;
     static std::list<AuctionListItemsDelayEvent> auctionListingListTemp;
-    static std::mutex auctionListingLock;
+    static std::mutex auctionListingListLock;
+    static std::shared_mutex auctionListingLock;
     static std::mutex auctionListingTempLock;
 };
 
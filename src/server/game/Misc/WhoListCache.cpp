@@ -1,46 +1,207 @@
 #include "GuildMgr.h"
-#include "ObjectAccessor.h"
 #include "Player.h"
+#include "Util.h"
 #include "WhoListCache.h"
-#include "World.h"
 
-std::vector<WhoListPlayerInfo> WhoListCacheMgr::m_whoOpcodeList;
+WhoListIndex WhoListCacheMgr::m_index;
+std::shared_mutex WhoListCacheMgr::m_lock;
 
-void WhoListCacheMgr::Update()
+void WhoListIndex::Insert(WhoListPlayerInfo const& info)
 {
-    // clear current list
-    m_whoOpcodeList.clear();
-    m_whoOpcodeList.reserve(sWorld->GetPlayerCount() + 1);
+    Remove(info.guidLow);
 
-    std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    if (info.teamId >= TEAM_NEUTRAL)
+        return;
+
+    Partition& partition = _partitions[info.teamId];
+    WhoListPlayerInfo const* indexed = &(partition.Players[info.guidLow] = info);
+    _teams[info.guidLow] = info.teamId;
+    Link(partition, indexed);
+}
+
+void WhoListIndex::Remove(uint32 guidLow)
+{
+    Partition* partition = nullptr;
+    if (WhoListPlayerInfo* info = Find(guidLow, partition))
     {
-        if (!itr->second->FindMap() || itr->second->GetSession()->PlayerLoading())
-            continue;
+        Unlink(*partition, info);
+        partition->Players.erase(guidLow);
+        _teams.erase(guidLow);
+    }
+}
 
-        if (itr->second->GetSession()->GetSecurity() > SEC_PLAYER)
-            continue;
+void WhoListIndex::UpdateLevel(uint32 guidLow, uint8 level)
+{
+    Partition* partition = nullptr;
+    WhoListPlayerInfo* info = Find(guidLow, partition);
+    if (!info || info->level == level)
+        return;
 
-        std::string pname = itr->second->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-            continue;
-        wstrToLower(wpname);
+    Unlink(*partition, info);
+    info->level = level;
+    Link(*partition, info);
+}
+
+void WhoListIndex::UpdateZone(uint32 guidLow, uint32 zoneId)
+{
+    Partition* partition = nullptr;
+    WhoListPlayerInfo* info = Find(guidLow, partition);
+    if (!info || info->zoneid == zoneId)
+        return;
+
+    Unlink(*partition, info);
+    info->zoneid = zoneId;
+    Link(*partition, info);
+}
+
+void WhoListIndex::UpdateGuild(uint32 guidLow, std::string const& gname, std::wstring const& wgname)
+{
+    Partition* partition = nullptr;
+    if (WhoListPlayerInfo* info = Find(guidLow, partition))
+    {
+        info->gname = gname;
+        info->wgname = wgname;
+    }
+}
+
+uint32 WhoListIndex::GetSize() const
+{
+    return _teams.size();
+}
+
+void WhoListIndex::Search(uint32 teamMask, uint32 levelMin, uint32 levelMax, std::vector<uint32> const& zones, EntryList& result) const
+{
+    if (levelMax > STRONG_MAX_LEVEL)
+        levelMax = STRONG_MAX_LEVEL;
 
-        std::string gname = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
+    for (uint8 teamId = 0; teamId < _partitions.size(); ++teamId)
+    {
+        if (!(teamMask & (1 << teamId)))
             continue;
-        wstrToLower(wgname);
 
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(itr->second->GetZoneId()))
-            aname = areaEntry->area_name[sWorld->GetDefaultDbcLocale()];
+        Partition const& partition = _partitions[teamId];
+
+        // walk the smaller of the zone lists and the level lists, check the other filter on each player
+        std::size_t zoneCount = 0;
+        for (uint32 zoneId : zones)
+        {
+            auto itr = partition.ByZone.find(zoneId);
+            if (itr != partition.ByZone.end())
+                zoneCount += itr->second.size();
+        }
 
-        if (itr->second->IsSpectator())
-            aname = "Dalaran";
+        std::size_t levelCount = 0;
+        for (uint32 level = levelMin; level <= levelMax; ++level)
+            levelCount += partition.ByLevel[level].size();
 
-        m_whoOpcodeList.push_back( WhoListPlayerInfo(itr->second->GetTeamId(), itr->second->GetSession()->GetSecurity(), itr->second->getLevel(), itr->second->getClass(), itr->second->getRace(), (itr->second->IsSpectator() ? 4395 /*Dalaran*/ : itr->second->GetZoneId()), itr->second->getGender(), wpname, wgname, aname, pname, gname) );
+        if (!zones.empty() && zoneCount <= levelCount)
+        {
+            for (std::size_t i = 0; i < zones.size(); ++i)
+            {
+                // the client may send a zone twice
+                if (std::find(zones.begin(), zones.begin() + i, zones[i]) != zones.begin() + i)
+                    continue;
+
+                auto itr = partition.ByZone.find(zones[i]);
+                if (itr == partition.ByZone.end())
+                    continue;
+
+                for (WhoListPlayerInfo const* info : itr->second)
+                    if (info->level >= levelMin && info->level <= levelMax)
+                        result.push_back(info);
+            }
+        }
+        else
+        {
+            for (uint32 level = levelMin; level <= levelMax; ++level)
+                for (WhoListPlayerInfo const* info : partition.ByLevel[level])
+                    if (zones.empty() || std::find(zones.begin(), zones.end(), info->zoneid) != zones.end())
+                        result.push_back(info);
+        }
     }
-}
\ No newline at end of file
+}
+
+WhoListPlayerInfo* WhoListIndex::Find(uint32 guidLow, Partition*& partition)
+{
+    auto team = _teams.find(guidLow);
+    if (team == _teams.end())
+        return nullptr;
+
+    partition = &_partitions[team->second];
+    auto itr = partition->Players.find(guidLow);
+    return itr != partition->Players.end() ? &itr->second : nullptr;
+}
+
+void WhoListIndex::Unlink(Partition& partition, WhoListPlayerInfo const* info)
+{
+    partition.ByLevel[info->level].erase(info);
+
+    auto itr = partition.ByZone.find(info->zoneid);
+    if (itr != partition.ByZone.end())
+    {
+        itr->second.erase(info);
+        if (itr->second.empty())
+            partition.ByZone.erase(itr);
+    }
+}
+
+void WhoListIndex::Link(Partition& partition, WhoListPlayerInfo const* info)
+{
+    partition.ByLevel[info->level].insert(info);
+    partition.ByZone[info->zoneid].insert(info);
+}
+
+void WhoListCacheMgr::AddPlayer(Player* player)
+{
+    WhoListPlayerInfo info;
+    info.guidLow = player->GetGUIDLow();
+    info.player = player;
+    info.teamId = player->GetTeamId();
+    info.level = player->getLevel();
+    info.clas = player->getClass();
+    info.race = player->getRace();
+    info.zoneid = player->GetZoneId();
+    info.gender = player->getGender();
+    info.pname = player->GetName();
+    info.gname = sGuildMgr->GetGuildNameById(player->GetGuildId());
+
+    // names the client could not search for stay out of the list
+    if (!Utf8toWStr(info.pname, info.wpname) || !Utf8toWStr(info.gname, info.wgname))
+        return;
+
+    wstrToLower(info.wpname);
+    wstrToLower(info.wgname);
+
+    std::unique_lock<std::shared_mutex> lock(m_lock);
+    m_index.Insert(info);
+}
+
+void WhoListCacheMgr::RemovePlayer(Player* player)
+{
+    std::unique_lock<std::shared_mutex> lock(m_lock);
+    m_index.Remove(player->GetGUIDLow());
+}
+
+void WhoListCacheMgr::UpdateLevel(Player* player)
+{
+    std::unique_lock<std::shared_mutex> lock(m_lock);
+    m_index.UpdateLevel(player->GetGUIDLow(), player->getLevel());
+}
+
+void WhoListCacheMgr::UpdateZone(Player* player, uint32 zoneId)
+{
+    std::unique_lock<std::shared_mutex> lock(m_lock);
+    m_index.UpdateZone(player->GetGUIDLow(), zoneId);
+}
+
+void WhoListCacheMgr::UpdateGuild(Player* player)
+{
+    std::string gname = sGuildMgr->GetGuildNameById(player->GetGuildId());
+    std::wstring wgname;
+    if (!Utf8toWStr(gname, wgname))
+        wgname.clear();
+    wstrToLower(wgname);
+
+    std::unique_lock<std::shared_mutex> lock(m_lock);
+    m_index.UpdateGuild(player->GetGUIDLow(), gname, wgname);
+}
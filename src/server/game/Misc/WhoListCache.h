@@ -2,35 +2,87 @@
 #define __WHOLISTCACHE_H
 
 #include "Common.h"
+#include "DBCEnums.h"
 #include "SharedDefines.h"
+#include <array>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+class Player;
 
 struct WhoListPlayerInfo
 {
+    uint32 guidLow;
+    Player* player;                                         // valid while the player is in the index
     TeamId teamId;
-    AccountTypes security;
     uint8 level;
     uint8 clas;
     uint8 race;
     uint32 zoneid;
     uint8 gender;
-    std::wstring wpname;
-    std::wstring wgname;
-    std::string aname;
+    std::wstring wpname;                                    // lower case
+    std::wstring wgname;                                    // lower case
     std::string pname;
     std::string gname;
+};
+
+/*
+ * Online players for CMSG_WHO, one partition per faction with secondary indexes by level and by zone.
+ * Kept up to date on login, logout, level, zone and guild changes, so a search only walks the players
+ * of the searched faction(s) in the smallest of its level range or zone lists.
+ */
+class WhoListIndex
+{
+public:
+    typedef std::vector<WhoListPlayerInfo const*> EntryList;
+
+    void Insert(WhoListPlayerInfo const& info);
+    void Remove(uint32 guidLow);
+    void UpdateLevel(uint32 guidLow, uint8 level);
+    void UpdateZone(uint32 guidLow, uint32 zoneId);
+    void UpdateGuild(uint32 guidLow, std::string const& gname, std::wstring const& wgname);
 
-    WhoListPlayerInfo(TeamId teamId, AccountTypes security, uint8 level, uint8 clas, uint8 race, uint32 zoneid, uint8 gender, std::wstring wpname, std::wstring wgname, std::string aname, std::string pname, std::string gname) :
-        teamId(teamId), security(security), level(level), clas(clas), race(race), zoneid(zoneid), gender(gender), wpname(wpname), wgname(wgname), aname(aname), pname(pname), gname(gname) {}
+    [[nodiscard]] uint32 GetSize() const;
+
+    // Appends the players of the teams of teamMask (1 << TeamId) with their level in [levelMin, levelMax]
+    // and, if zones is not empty, their zone in zones. The order is unspecified
+    void Search(uint32 teamMask, uint32 levelMin, uint32 levelMax, std::vector<uint32> const& zones, EntryList& result) const;
+
+private:
+    typedef std::unordered_set<WhoListPlayerInfo const*> EntrySet;
+
+    struct Partition
+    {
+        std::unordered_map<uint32 /*guidLow*/, WhoListPlayerInfo> Players;
+        std::array<EntrySet, STRONG_MAX_LEVEL + 1> ByLevel;
+        std::unordered_map<uint32 /*zoneId*/, EntrySet> ByZone;
+    };
+
+    WhoListPlayerInfo* Find(uint32 guidLow, Partition*& partition);
+    static void Unlink(Partition& partition, WhoListPlayerInfo const* info);
+    static void Link(Partition& partition, WhoListPlayerInfo const* info);
+
+    std::array<Partition, TEAM_NEUTRAL> _partitions;        // alliance and horde
+    std::unordered_map<uint32 /*guidLow*/, TeamId> _teams;
 };
 
 class WhoListCacheMgr
 {
 public:
-    static void Update();
-    static std::vector<WhoListPlayerInfo>* GetWhoList() { return &m_whoOpcodeList; }
+    static void AddPlayer(Player* player);
+    static void RemovePlayer(Player* player);
+    static void UpdateLevel(Player* player);
+    static void UpdateZone(Player* player, uint32 zoneId);
+    static void UpdateGuild(Player* player);
+
+    // hold it shared while reading the index
+    static std::shared_mutex& GetLock() { return m_lock; }
+    static WhoListIndex const& GetIndex() { return m_index; }
 
 protected:
-    static std::vector<WhoListPlayerInfo> m_whoOpcodeList;
+    static WhoListIndex m_index;
+    static std::shared_mutex m_lock;
 };
 
 #endif
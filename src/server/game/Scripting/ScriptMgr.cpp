@@ -1981,6 +1981,16 @@ void ScriptMgr::OnItemRoll(Player const* player, LootStoreItem const* LootStoreI
     FOREACH_SCRIPT(GlobalScript)->OnItemRoll(player, LootStoreItem,  chance, loot, store);
 }
 
+// While a global script changes the loot chances, the loot rolls walk the items and call OnItemRoll instead of using their precomputed tables
+bool ScriptMgr::HasItemRollHooks() const
+{
+    for (SCR_REG_ITR(GlobalScript) itr = SCR_REG_LST(GlobalScript).begin(); itr != SCR_REG_LST(GlobalScript).end(); ++itr)
+        if (itr->second->HasItemRollHook())
+            return true;
+
+    return false;
+}
+
 void ScriptMgr::OnInitializeLockedDungeons(Player* player, uint8& level, uint32& lockData, lfg::LFGDungeonData const* dungeon)
 {
     FOREACH_SCRIPT(GlobalScript)->OnInitializeLockedDungeons(player, level, lockData, dungeon);
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef AZEROTHCORE_SHAREDPAYLOADDATABLOCK_H
+#define AZEROTHCORE_SHAREDPAYLOADDATABLOCK_H
+
+#include "WorldPacket.h"
+#include <ace/Message_Block.h>
+#include <ace/Message_Queue.h>
+#include <ace/Null_Condition.h>
+#include <ace/Null_Mutex.h>
+#include <ace/Synch_Traits.h>
+#include <ace/os_include/sys/os_uio.h>
+#include <algorithm>
+#include <memory>
+
+/// Data block of a queued message pointing at a payload shared with other sockets, it holds a reference to the payload until sent.
+class SharedPayloadDataBlock : public ACE_Data_Block
+{
+public:
+    explicit SharedPayloadDataBlock(std::shared_ptr<WorldPacket const> const& payload) :
+        ACE_Data_Block(payload->size(), ACE_Message_Block::MB_DATA, (char const*)payload->contents(), nullptr, nullptr, ACE_Message_Block::DONT_DELETE, ACE_Allocator::instance()),
+        _payload(payload) { }
+
+    /// ACE frees released data blocks with their allocator, so they are allocated from it too
+    static ACE_Message_Block* Create(std::shared_ptr<WorldPacket const> const& payload)
+    {
+        void* memory = ACE_Allocator::instance()->malloc(sizeof(SharedPayloadDataBlock));
+        if (!memory)
+            return nullptr;
+
+        ACE_Message_Block* mb = new ACE_Message_Block(new (memory) SharedPayloadDataBlock(payload));
+        mb->wr_ptr(payload->size());
+        return mb;
+    }
+
+    /// Fills @a iov with the data of the queued messages and of the blocks chained to them, in sending order,
+    /// so a header and its shared payload go out in the same write.
+    /// @return the number of iovec filled, at most @a max
+    static int Gather(ACE_Message_Queue<ACE_NULL_SYNCH>& queue, iovec* iov, int max)
+    {
+        ACE_Message_Block* mblk = nullptr;
+        if (queue.peek_dequeue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+            return 0;
+
+        int count = 0;
+        for (; mblk && count < max; mblk = mblk->next())
+        {
+            for (ACE_Message_Block* block = mblk; block && count < max; block = block->cont())
+            {
+                if (!block->length())
+                    continue;
+
+                iov[count].iov_base = block->rd_ptr();
+                iov[count].iov_len = block->length();
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    /// Removes @a sent bytes from the head of the queue, releasing the messages sent completely.
+    /// A message sent in part is put back at the head with its blocks advanced past the sent data.
+    /// @return -1 if the message could not be put back
+    static int ReleaseSent(ACE_Message_Queue<ACE_NULL_SYNCH>& queue, size_t sent)
+    {
+        ACE_Message_Block* mblk = nullptr;
+        while (queue.dequeue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) != -1)
+        {
+            for (ACE_Message_Block* block = mblk; block && sent; block = block->cont())
+            {
+                size_t length = std::min(sent, block->length());
+                block->rd_ptr(length);
+                sent -= length;
+            }
+
+            if (!mblk->total_length())
+            {
+                mblk->release();
+                continue;
+            }
+
+            if (queue.enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+            {
+                mblk->release();
+                return -1;
+            }
+
+            break;
+        }
+
+        return 0;
+    }
+
+private:
+    std::shared_ptr<WorldPacket const> _payload;
+};
+
+#endif
@@ -191,14 +191,10 @@ uint32 WorldSession::GetGuidLow() const
     return GetPlayer() ? GetPlayer()->GetGUIDLow() : 0;
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet)
-{
-    if (!m_Socket)
-        return;
-
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS) && defined(ACORE_DEBUG)
-    // Code for network use statistic
+// Code for network use statistic, counts the packets sent to all clients
+static void LogSendPacketStatistic(WorldPacket const& packet)
+{
     static uint64 sendPacketCount = 0;
     static uint64 sendPacketBytes = 0;
 
@@ -213,10 +209,10 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if ((cur_time - lastTime) < 60)
     {
         sendPacketCount += 1;
-        sendPacketBytes += packet->size();
+        sendPacketBytes += packet.size();
 
         sendLastPacketCount += 1;
-        sendLastPacketBytes += packet->size();
+        sendLastPacketBytes += packet.size();
     }
     else
     {
@@ -229,10 +225,21 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
         lastTime = cur_time;
         sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
+        sendLastPacketBytes = packet.wpos();                // wpos is real written size
     }
+}
 #endif                                                      // !ACORE_DEBUG
 
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    if (!m_Socket)
+        return;
+
+#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS) && defined(ACORE_DEBUG)
+    LogSendPacketStatistic(*packet);
+#endif
+
     sScriptMgr->OnPacketSend(this, *packet);
 
 #ifdef ELUNA
@@ -244,6 +251,27 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         m_Socket->CloseSocket("m_Socket->SendPacket(*packet) == -1");
 }
 
+/// Send a packet of a broadcast to the client, the sockets share a large payload instead of copying it
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!m_Socket)
+        return;
+
+#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS) && defined(ACORE_DEBUG)
+    LogSendPacketStatistic(packet.GetPacket());
+#endif
+
+    sScriptMgr->OnPacketSend(this, packet.GetPacket());
+
+#ifdef ELUNA
+    if (!sEluna->OnPacketSend(this, packet.GetPacket()))
+        return;
+#endif
+
+    if (m_Socket->SendPacket(packet) == -1)
+        m_Socket->CloseSocket("m_Socket->SendPacket(packet) == -1");
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -392,6 +420,10 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     if (updater.ProcessLogout())
     {
+        // guilds are not thread-safe, their callbacks are processed in World::UpdateSessions() only
+        if (m_Socket && !m_Socket->IsClosed())
+            ProcessQueryCallbackGuild();
+
         if (m_Socket && !m_Socket->IsClosed() && _warden)
         {
             _warden->Update(diff);
@@ -1163,6 +1195,11 @@ void WorldSession::InitializeQueryCallbackParameters()
     _charCreateCallback.SetParam(nullptr);
     _loadPetFromDBFirstCallback.SetFirstParam(0);
     _loadPetFromDBFirstCallback.SetSecondParam(nullptr);
+
+    // a guild id is set while its log query is pending
+    _guildEventLogCallback.SetParam(0);
+    _guildBankLogCallback.SetFirstParam(0);
+    _guildBankLogQueuedTabs = 0;
 }
 
 void WorldSession::ProcessQueryCallbacks()
@@ -1330,6 +1367,33 @@ void WorldSession::ProcessQueryCallbackLogin()
     }
 }
 
+void WorldSession::ProcessQueryCallbackGuild()
+{
+    PreparedQueryResult result;
+
+    //- HandleGuildEventLogQueryOpcode
+    if (_guildEventLogCallback.IsReady())
+    {
+        uint32 guildId = _guildEventLogCallback.GetParam();
+        _guildEventLogCallback.GetResult(result);
+        HandleGuildEventLogQueryCallback(result, guildId);
+        _guildEventLogCallback.FreeResult();
+        _guildEventLogCallback.SetParam(0);
+    }
+
+    //- HandleGuildBankLogQuery
+    if (_guildBankLogCallback.IsReady())
+    {
+        uint32 guildId = _guildBankLogCallback.GetFirstParam();
+        uint8 tabId = _guildBankLogCallback.GetSecondParam();
+        _guildBankLogCallback.GetResult(result);
+        HandleGuildBankLogQueryCallback(result, guildId, tabId);
+        _guildBankLogCallback.FreeResult();
+        _guildBankLogCallback.SetFirstParam(0);
+        SendQueuedGuildBankLogs();
+    }
+}
+
 void WorldSession::InitWarden(SessionKey const& k, std::string const& os)
 {
     if (os == "Win")
@@ -20,12 +20,14 @@
 #include "GossipDef.h"
 #include "Opcodes.h"
 #include "SharedDefines.h"
+#include "SharedWorldPacket.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include <utility>
 
 class Creature;
 class GameObject;
+class Guild;
 class InstanceSave;
 class Item;
 class LoginQueryHolder;
@@ -209,6 +211,7 @@ public:
     void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
     void SendPacket(WorldPacket const* packet);
+    void SendPacket(SharedWorldPacket const& packet);         // same packet to many sessions
     void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
     void SendNotification(uint32 string_id, ...);
     void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName* declinedName);
@@ -548,6 +551,7 @@ public:                                                 // opcodes handlers
     void HandleGuildDeclineOpcode(WorldPacket& recvPacket);
     void HandleGuildInfoOpcode(WorldPacket& recvPacket);
     void HandleGuildEventLogQueryOpcode(WorldPacket& recvPacket);
+    void HandleGuildEventLogQueryCallback(PreparedQueryResult result, uint32 guildId);
     void HandleGuildRosterOpcode(WorldPacket& recvPacket);
     void HandleGuildPromoteOpcode(WorldPacket& recvPacket);
     void HandleGuildDemoteOpcode(WorldPacket& recvPacket);
@@ -856,6 +860,9 @@ public:                                                 // opcodes handlers
     void HandleGuildBankerActivate(WorldPacket& recvData);
     void HandleGuildBankQueryTab(WorldPacket& recvData);
     void HandleGuildBankLogQuery(WorldPacket& recvData);
+    void HandleGuildBankLogQueryCallback(PreparedQueryResult result, uint32 guildId, uint8 tabId);
+    void QueryGuildBankLog(Guild* guild, uint8 tabId);
+    void SendQueuedGuildBankLogs();
     void HandleGuildBankDepositMoney(WorldPacket& recvData);
     void HandleGuildBankWithdrawMoney(WorldPacket& recvData);
     void HandleGuildBankSwapItems(WorldPacket& recvData);
@@ -932,6 +939,7 @@ private:
     void ProcessQueryCallbackPlayer();
     void ProcessQueryCallbackPet();
     void ProcessQueryCallbackLogin();
+    void ProcessQueryCallbackGuild();
 
     PreparedQueryResultFuture _charEnumCallback;
     PreparedQueryResultFuture _stablePetCallback;
@@ -945,6 +953,9 @@ private:
 
     QueryResultHolderFuture _loadPetFromDBSecondCallback;
     QueryCallback_3<PreparedQueryResult, uint8, uint8, uint32> _openWrappedItemCallback;
+    QueryCallback<PreparedQueryResult, uint32> _guildEventLogCallback;
+    QueryCallback_2<PreparedQueryResult, uint32, uint8> _guildBankLogCallback;
+    uint8 _guildBankLogQueuedTabs;                          // tabs asked for while another tab is read, one bit per tab
 
     friend class World;
 protected:
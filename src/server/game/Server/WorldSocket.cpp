@@ -17,6 +17,8 @@
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "SharedDefines.h"
+#include "SharedPayloadDataBlock.h"
+#include "SharedWorldPacket.h"
 #include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
@@ -26,11 +28,14 @@
 #include <ace/Message_Block.h>
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
+#include <ace/os_include/os_limits.h>
 #include <ace/os_include/sys/os_socket.h>
 #include <ace/os_include/sys/os_types.h>
 #include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/OS_NS_unistd.h>
 #include <ace/Reactor.h>
+#include <algorithm>
 #include <thread>
 
 #ifdef ELUNA
@@ -90,6 +95,9 @@ struct ClientPktHeader
 #pragma pack(pop)
 #endif
 
+// blocks sent per write, the out buffer and the queued headers and payloads
+static constexpr int WORLD_SOCKET_MAX_IOV = std::min(64, ACE_IOV_MAX);
+
 WorldSocket::WorldSocket(void): WorldHandler(),
     m_LastPingTime(SystemTimePoint::min()), m_OverSpeedPings(0), m_Session(0),
     m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
@@ -148,6 +156,16 @@ const std::string& WorldSocket::GetRemoteAddress(void) const
 }
 
 int WorldSocket::SendPacket(WorldPacket const& pct)
+{
+    return SendPacket(pct, nullptr);
+}
+
+int WorldSocket::SendPacket(SharedWorldPacket const& packet)
+{
+    return SendPacket(packet.GetPacket(), &packet);
+}
+
+int WorldSocket::SendPacket(WorldPacket const& pct, SharedWorldPacket const* shared)
 {
     std::lock_guard<std::mutex> guard(m_OutBufferLock);
 
@@ -163,7 +181,10 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     if (m_Crypt.IsInitialized())
         m_Crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
 
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
+    // payloads of broadcasts are referenced, not copied, only the header is per socket
+    bool bufferHeader = m_OutBuffer->space() >= header.getHeaderLength() && msg_queue()->is_empty();
+
+    if (!shared && bufferHeader && m_OutBuffer->space() >= pct.size() + header.getHeaderLength())
     {
         // Put the packet on the buffer.
         if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
@@ -176,14 +197,44 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     else
     {
         // Enqueue the packet.
-        ACE_Message_Block* mb;
+        ACE_Message_Block* mb = nullptr;
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
+        if (shared)
+        {
+            ACE_Message_Block* payload = SharedPayloadDataBlock::Create(shared->GetPayload());
+            if (!payload)
+                return -1;
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+            // the header goes out with the buffer, the payload follows it in the same write
+            if (bufferHeader)
+            {
+                if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
+                    ABORT();
 
-        if (!pct.empty())
-            mb->copy((const char*)pct.contents(), pct.size());
+                mb = payload;
+            }
+            else
+            {
+                ACE_NEW_NORETURN(mb, ACE_Message_Block(header.getHeaderLength()));
+                if (!mb)
+                {
+                    payload->release();
+                    return -1;
+                }
+
+                mb->copy((char*) header.header, header.getHeaderLength());
+                mb->cont(payload);
+            }
+        }
+        else
+        {
+            ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
+
+            mb->copy((char*) header.header, header.getHeaderLength());
+
+            if (!pct.empty())
+                mb->copy((const char*)pct.contents(), pct.size());
+        }
 
         if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
         {
@@ -316,104 +367,76 @@ int WorldSocket::handle_output(ACE_HANDLE)
 
     std::lock_guard<std::mutex> guard(m_OutBufferLock);
 
-    size_t send_len = m_OutBuffer->length();
-
-    if (send_len == 0)
-        return handle_output_queue();
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
-
-    if (n == 0)
-        return -1;
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-            return schedule_wakeup_output();
-
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
-
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    // the buffer and the queued messages are sent in one gather write
+    iovec iov[WORLD_SOCKET_MAX_IOV];
+    int iovcnt = 0;
 
-        return schedule_wakeup_output();
-    }
-    else //now n == send_len
+    size_t buffer_len = m_OutBuffer->length();
+    if (buffer_len)
     {
-        m_OutBuffer->reset();
-
-        return handle_output_queue();
+        iov[0].iov_base = m_OutBuffer->rd_ptr();
+        iov[0].iov_len = buffer_len;
+        iovcnt = 1;
     }
 
-    ACE_NOTREACHED (return 0);
-}
+    iovcnt += SharedPayloadDataBlock::Gather(*msg_queue(), iov + iovcnt, WORLD_SOCKET_MAX_IOV - iovcnt);
 
-int WorldSocket::handle_output_queue()
-{
-    if (msg_queue()->is_empty())
+    if (iovcnt == 0)
         return cancel_wakeup_output();
 
-    ACE_Message_Block* mblk;
+    size_t send_len = 0;
+    for (int i = 0; i < iovcnt; ++i)
+        send_len += iov[i].iov_len;
 
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        LOG_ERROR("server", "WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
-
-    const size_t send_len = mblk->length();
+    msghdr msg = { };
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len);
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, 0);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
-    {
-        mblk->release();
-
         return -1;
-    }
     else if (n == -1)
     {
         if (errno == EWOULDBLOCK || errno == EAGAIN)
-        {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
             return schedule_wakeup_output();
-        }
 
-        mblk->release();
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t> (n));
 
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
-        {
-            LOG_ERROR("server", "WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
-        }
+    size_t sent = static_cast<size_t>(n);
 
-        return schedule_wakeup_output();
-    }
-    else //now n == send_len
+    if (buffer_len)
     {
-        mblk->release();
+        size_t buffer_sent = std::min(sent, buffer_len);
+        m_OutBuffer->rd_ptr(buffer_sent);
+        sent -= buffer_sent;
+
+        // move the data to the base of the buffer
+        if (m_OutBuffer->length())
+            m_OutBuffer->crunch();
+        else
+            m_OutBuffer->reset();
+    }
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output() : ACE_Event_Handler::WRITE_MASK;
+    if (SharedPayloadDataBlock::ReleaseSent(*msg_queue(), sent) == -1)
+    {
+        LOG_ERROR("server", "WorldSocket::handle_output enqueue_head");
+        return -1;
     }
 
-    return -1;
+    if (n < (ssize_t)send_len)
+        return schedule_wakeup_output();
+
+    // more messages were queued than one write takes
+    if (!msg_queue()->is_empty())
+        return ACE_Event_Handler::WRITE_MASK;
+
+    return cancel_wakeup_output();
 }
 
 int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
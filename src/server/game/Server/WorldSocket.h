@@ -28,6 +28,7 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 class ACE_Message_Block;
+class SharedWorldPacket;
 class WorldPacket;
 class WorldSession;
 
@@ -92,6 +93,11 @@ public:
     /// @return -1 of failure
     int SendPacket(const WorldPacket& pct);
 
+    /// Send a packet of a broadcast on the socket, a large payload is queued without copying it.
+    /// @param packet packet to send
+    /// @return -1 of failure
+    int SendPacket(SharedWorldPacket const& packet);
+
     /// Add reference to this object.
     long AddReference (void);
 
@@ -130,8 +136,8 @@ private:
     int cancel_wakeup_output();
     int schedule_wakeup_output();
 
-    /// Drain the queue if its not empty.
-    int handle_output_queue();
+    /// Encrypt the header and buffer or queue the packet, shared is set for broadcasts.
+    int SendPacket(WorldPacket const& pct, SharedWorldPacket const* shared);
 
     /// process one incoming packet.
     /// @param new_pct received packet, note that you need to delete it.
@@ -2826,3 +2826,22 @@ void SpellInfo::_UnloadImplicitTargetConditionLists()
         delete cur;
     }
 }
+
+SpellHotInfo::SpellHotInfo(SpellInfo const* spellInfo) :
+    Attributes(spellInfo->Attributes), AttributesEx(spellInfo->AttributesEx), AttributesEx2(spellInfo->AttributesEx2),
+    AttributesEx3(spellInfo->AttributesEx3), AttributesCu(spellInfo->AttributesCu), ProcFlags(spellInfo->ProcFlags),
+    SpellFamilyFlags(spellInfo->SpellFamilyFlags), MinRangeHostile(spellInfo->GetMinRange()), MinRangeFriend(spellInfo->GetMinRange(true)),
+    MaxRangeHostile(spellInfo->GetMaxRange()), MaxRangeFriend(spellInfo->GetMaxRange(true)), SchoolMask(uint8(spellInfo->SchoolMask)),
+    DmgClass(uint8(spellInfo->DmgClass)), SpellFamilyName(uint8(spellInfo->SpellFamilyName)), Dispel(uint8(spellInfo->Dispel)),
+    Mechanic(uint8(spellInfo->Mechanic))
+{
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+    {
+        if (!spellInfo->Effects[i].IsEffect())
+            continue;
+
+        EffectMask |= 1 << i;
+        if (spellInfo->Effects[i].IsAura())
+            EffectAuraType[i] = uint16(spellInfo->Effects[i].ApplyAuraName);
+    }
+}
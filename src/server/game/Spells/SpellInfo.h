@@ -513,4 +513,52 @@ public:
     void _UnloadImplicitTargetConditionLists();
 };
 
+// The fields of a SpellInfo read by the cast, immunity and proc checks, packed in one cache line.
+// SpellMgr keeps them in an array indexed by spell id, built after the spell corrections.
+struct alignas(64) SpellHotInfo
+{
+    uint32 Attributes = 0;
+    uint32 AttributesEx = 0;
+    uint32 AttributesEx2 = 0;
+    uint32 AttributesEx3 = 0;
+    uint32 AttributesCu = 0;
+    uint32 ProcFlags = 0;
+    flag96 SpellFamilyFlags;
+    float  MinRangeHostile = 0.0f;
+    float  MinRangeFriend = 0.0f;
+    float  MaxRangeHostile = 0.0f;
+    float  MaxRangeFriend = 0.0f;
+    uint16 EffectAuraType[MAX_SPELL_EFFECTS] = { };     // aura type of aura effects, SPELL_AURA_NONE for other effects
+    uint8  EffectMask = 0;                              // effects set
+    uint8  SchoolMask = 0;
+    uint8  DmgClass = 0;
+    uint8  SpellFamilyName = 0;
+    uint8  Dispel = 0;
+    uint8  Mechanic = 0;
+
+    SpellHotInfo() = default;
+    explicit SpellHotInfo(SpellInfo const* spellInfo);
+
+    inline bool HasAttribute(SpellAttr0 attribute) const { return Attributes & attribute; }
+    inline bool HasAttribute(SpellAttr1 attribute) const { return AttributesEx & attribute; }
+    inline bool HasAttribute(SpellAttr2 attribute) const { return AttributesEx2 & attribute; }
+    inline bool HasAttribute(SpellAttr3 attribute) const { return AttributesEx3 & attribute; }
+    inline bool HasAttribute(SpellCustomAttributes customAttribute) const { return AttributesCu & customAttribute; }
+
+    inline bool HasAura(AuraType aura) const
+    {
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            if (EffectAuraType[i] == aura)
+                return true;
+        return false;
+    }
+
+    inline bool IsEffect(uint8 effIndex) const { return EffectMask & (1 << effIndex); }
+    inline SpellSchoolMask GetSchoolMask() const { return SpellSchoolMask(SchoolMask); }
+    inline float GetMinRange(bool positive = false) const { return positive ? MinRangeFriend : MinRangeHostile; }
+    inline float GetMaxRange(bool positive = false) const { return positive ? MaxRangeFriend : MaxRangeHostile; }
+};
+
+static_assert(sizeof(SpellHotInfo) == 64, "SpellHotInfo must fit one cache line");
+
 #endif // _SPELLINFO_H
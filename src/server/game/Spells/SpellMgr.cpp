@@ -342,7 +342,7 @@ bool IsDiminishingReturnsGroupDurationLimited(DiminishingGroup group)
     }
 }
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : mSpellInfoArena(nullptr), mSpellInfoArenaSize(0)
 {
 }
 
@@ -747,7 +747,7 @@ bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, Spell
             if (EventProcFlag == PROC_FLAG_DONE_PERIODIC)
             {
                 /// no aura with only PROC_FLAG_DONE_PERIODIC and spellFamilyName == 0 can proc from a HOT.
-                if (!spellProto->SpellFamilyName)
+                if (!GetSpellHotInfo(spellProto).SpellFamilyName)
                     return false;
             }
             /// Aura must have positive procflags for a HOT to proc
@@ -795,18 +795,20 @@ bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, Spell
         }
         else // For spells need check school/spell family/family mask
         {
+            SpellHotInfo const& procSpellHotInfo = GetSpellHotInfo(procSpell);
+
             // Check (if set) for school
-            if (spellProcEvent->schoolMask && (spellProcEvent->schoolMask & procSpell->SchoolMask) == 0)
+            if (spellProcEvent->schoolMask && (spellProcEvent->schoolMask & procSpellHotInfo.SchoolMask) == 0)
                 return false;
 
             // Check (if set) for spellFamilyName
-            if (spellProcEvent->spellFamilyName && (spellProcEvent->spellFamilyName != procSpell->SpellFamilyName))
+            if (spellProcEvent->spellFamilyName && (spellProcEvent->spellFamilyName != procSpellHotInfo.SpellFamilyName))
                 return false;
 
             // spellFamilyName is Ok need check for spellFamilyMask if present
             if (spellProcEvent->spellFamilyMask)
             {
-                if (!(spellProcEvent->spellFamilyMask & procSpell->SpellFamilyFlags))
+                if (!(spellProcEvent->spellFamilyMask & procSpellHotInfo.SpellFamilyFlags))
                     return false;
                 hasFamilyMask = true;
                 // Some spells are not considered as active even with have spellfamilyflags
@@ -884,10 +886,12 @@ bool SpellMgr::CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcE
     // check spell family name/flags (if set) for spells
     if (eventInfo.GetTypeMask() & (PERIODIC_PROC_FLAG_MASK | SPELL_PROC_FLAG_MASK | PROC_FLAG_DONE_TRAP_ACTIVATION))
     {
-        if (procEntry.spellFamilyName && (procEntry.spellFamilyName != eventInfo.GetSpellInfo()->SpellFamilyName))
+        SpellHotInfo const& spellHotInfo = GetSpellHotInfo(eventInfo.GetSpellInfo());
+
+        if (procEntry.spellFamilyName && (procEntry.spellFamilyName != spellHotInfo.SpellFamilyName))
             return false;
 
-        if (procEntry.spellFamilyMask && !(procEntry.spellFamilyMask & eventInfo.GetSpellInfo()->SpellFamilyFlags))
+        if (procEntry.spellFamilyMask && !(procEntry.spellFamilyMask & spellHotInfo.SpellFamilyFlags))
             return false;
     }
 
@@ -2477,7 +2481,10 @@ void SpellMgr::LoadSpellAreas()
         if (SpellInfo const* spellInfo = GetSpellInfo(spell))
         {
             if (spellArea.autocast)
+            {
                 const_cast<SpellInfo*>(spellInfo)->Attributes |= SPELL_ATTR0_CANT_CANCEL;
+                RefreshSpellHotInfo(spellInfo);
+            }
         }
         else
         {
@@ -2655,10 +2662,18 @@ void SpellMgr::LoadSpellInfoStore()
     UnloadSpellInfoStore();
     mSpellInfoMap.resize(sSpellStore.GetNumRows(), nullptr);
 
+    uint32 spellCount = 0;
+    for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
+        if (sSpellStore.LookupEntry(i))
+            ++spellCount;
+
+    // One allocation for all spells instead of one each, spells with close ids end up next to each other
+    mSpellInfoArena = static_cast<SpellInfo*>(::operator new(spellCount * sizeof(SpellInfo)));
+
     for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
     {
         if (SpellEntry const* spellEntry = sSpellStore.LookupEntry(i))
-            mSpellInfoMap[i] = new SpellInfo(spellEntry);
+            mSpellInfoMap[i] = new (&mSpellInfoArena[mSpellInfoArenaSize++]) SpellInfo(spellEntry);
     }
 
     LOG_INFO("server", ">> Loaded spell custom attributes in %u ms", GetMSTimeDiffToNow(oldMSTime));
@@ -2667,12 +2682,14 @@ void SpellMgr::LoadSpellInfoStore()
 
 void SpellMgr::UnloadSpellInfoStore()
 {
-    for (uint32 i = 0; i < mSpellInfoMap.size(); ++i)
-    {
-        if (mSpellInfoMap[i])
-            delete mSpellInfoMap[i];
-    }
+    for (uint32 i = 0; i < mSpellInfoArenaSize; ++i)
+        mSpellInfoArena[i].~SpellInfo();
+
+    ::operator delete(mSpellInfoArena);
+    mSpellInfoArena = nullptr;
+    mSpellInfoArenaSize = 0;
     mSpellInfoMap.clear();
+    mSpellHotInfo.clear();
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -3299,6 +3316,27 @@ void SpellMgr::LoadSpellCustomAttr()
     LOG_INFO("server", " ");
 }
 
+void SpellMgr::LoadSpellHotInfo()
+{
+    uint32 oldMSTime = getMSTime();
+
+    mSpellHotInfo.clear();
+    mSpellHotInfo.reserve(mSpellInfoArenaSize);
+
+    for (uint32 i = 0; i < mSpellInfoArenaSize; ++i)
+        mSpellHotInfo.emplace_back(&mSpellInfoArena[i]);
+
+    LOG_INFO("server", ">> Loaded spell hot info in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server", " ");
+}
+
+void SpellMgr::RefreshSpellHotInfo(SpellInfo const* spellInfo)
+{
+    uint32 index = spellInfo - mSpellInfoArena;
+    if (index < mSpellHotInfo.size())
+        mSpellHotInfo[index] = SpellHotInfo(spellInfo);
+}
+
 inline void ApplySpellFix(std::initializer_list<uint32> spellIds, void(*fix)(SpellEntry*))
 {
     for (uint32 spellId : spellIds)
@@ -11,6 +11,7 @@
 
 #include "Common.h"
 #include "SharedDefines.h"
+#include "SpellInfo.h"
 #include "Unit.h"
 
 class SpellInfo;
@@ -570,6 +571,7 @@ typedef std::vector<uint32> SpellCustomAttribute;
 typedef std::vector<bool> EnchantCustomAttribute;
 
 typedef std::vector<SpellInfo*> SpellInfoMap;
+typedef std::vector<SpellHotInfo> SpellHotInfoMap;
 
 typedef std::map<int32, std::vector<int32> > SpellLinkedMap;
 
@@ -685,6 +687,11 @@ public:
     // SpellInfo object management
     [[nodiscard]] SpellInfo const* GetSpellInfo(uint32 spellId) const { return spellId < GetSpellInfoStoreSize() ?  mSpellInfoMap[spellId] : nullptr; }
     [[nodiscard]] uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap.size(); }
+    // Fields of a SpellInfo of the store read by the cast, immunity and proc checks, found from its place in the arena
+    // so the SpellInfo itself is not read
+    [[nodiscard]] SpellHotInfo const& GetSpellHotInfo(SpellInfo const* spellInfo) const { return mSpellHotInfo[spellInfo - mSpellInfoArena]; }
+    // SpellInfo changed after LoadSpellHotInfo
+    void RefreshSpellHotInfo(SpellInfo const* spellInfo);
 
     // Talent Additional Set
     [[nodiscard]] bool IsAdditionalTalentSpell(uint32 spellId) const;
@@ -720,6 +727,7 @@ public:
     void UnloadSpellInfoStore();
     void UnloadSpellInfoImplicitTargetConditionLists();
     void LoadSpellCustomAttr();
+    void LoadSpellHotInfo();
     void LoadDbcDataCorrections();
     void LoadSpellSpecificAndAuraState();
 
@@ -750,6 +758,9 @@ private:
     PetLevelupSpellMap         mPetLevelupSpellMap;
     PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
     SpellInfoMap               mSpellInfoMap;
+    SpellInfo*                 mSpellInfoArena;                // every SpellInfo of mSpellInfoMap, contiguous and in id order
+    uint32                     mSpellInfoArenaSize;
+    SpellHotInfoMap            mSpellHotInfo;                  // same order as mSpellInfoArena
     TalentAdditionalSet        mTalentSpellAdditionalSet;
 };
 
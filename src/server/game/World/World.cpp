@@ -53,6 +53,7 @@
 #include "OutdoorPvPMgr.h"
 #include "PetitionMgr.h"
 #include "Player.h"
+#include "PlayerNameIndex.h"
 #include "PoolMgr.h"
 #include "SavingSystem.h"
 #include "ScriptMgr.h"
@@ -61,6 +62,7 @@
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
+#include "TaskGraph.h"
 #include "TemporarySummon.h"
 #include "TicketMgr.h"
 #include "Transport.h"
@@ -72,7 +74,6 @@
 #include "WardenCheckMgr.h"
 #include "WaypointMovementGenerator.h"
 #include "WeatherMgr.h"
-#include "WhoListCache.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -943,8 +944,10 @@ void World::LoadConfigSettings(bool reload)
     m_float_configs[CONFIG_CHANCE_OF_GM_SURVEY] = sConfigMgr->GetOption<float>("GM.TicketSystem.ChanceOfGMSurvey", 50.0f);
 
     m_int_configs[CONFIG_GROUP_VISIBILITY]      = sConfigMgr->GetOption<int32>("Visibility.GroupMode", 1);
+    m_int_configs[CONFIG_GROUP_STATS_UPDATE_INTERVAL] = sConfigMgr->GetOption<int32>("Group.StatsUpdateInterval", 250);
 
     m_int_configs[CONFIG_MAIL_DELIVERY_DELAY]   = sConfigMgr->GetOption<int32>("MailDeliveryDelay", HOUR);
+    m_int_configs[CONFIG_MAIL_EXPIRY_BATCH_SIZE] = sConfigMgr->GetOption<int32>("MailExpiryBatchSize", 200);
 
     m_int_configs[CONFIG_UPTIME_UPDATE]         = sConfigMgr->GetOption<int32>("UpdateUptimeInterval", 10);
     if (int32(m_int_configs[CONFIG_UPTIME_UPDATE]) <= 0)
@@ -1188,6 +1191,17 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_GUILD_BANK_EVENT_LOG_COUNT] = sConfigMgr->GetOption<int32>("Guild.BankEventLogRecordsCount", GUILD_BANKLOG_MAX_RECORDS);
     if (m_int_configs[CONFIG_GUILD_BANK_EVENT_LOG_COUNT] > GUILD_BANKLOG_MAX_RECORDS)
         m_int_configs[CONFIG_GUILD_BANK_EVENT_LOG_COUNT] = GUILD_BANKLOG_MAX_RECORDS;
+    m_int_configs[CONFIG_GUILD_LOG_SAVE_INTERVAL] = sConfigMgr->GetOption<int32>("Guild.LogSaveInterval", 30);
+    if (int32(m_int_configs[CONFIG_GUILD_LOG_SAVE_INTERVAL]) <= 0)
+    {
+        LOG_ERROR("server", "Guild.LogSaveInterval (%i) must be > 0, set to default 30.", m_int_configs[CONFIG_GUILD_LOG_SAVE_INTERVAL]);
+        m_int_configs[CONFIG_GUILD_LOG_SAVE_INTERVAL] = 30;
+    }
+    if (reload)
+    {
+        m_timers[WUPDATE_GUILD_LOGS].SetInterval(m_int_configs[CONFIG_GUILD_LOG_SAVE_INTERVAL] * IN_MILLISECONDS);
+        m_timers[WUPDATE_GUILD_LOGS].Reset();
+    }
 
     //visibility on continents
     m_MaxVisibleDistanceOnContinents = sConfigMgr->GetOption<float>("Visibility.Distance.Continents", DEFAULT_VISIBILITY_DISTANCE);
@@ -1300,6 +1314,9 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE]         = sConfigMgr->GetOption<int32>("RecordUpdateTimeDiffInterval", 300000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE]              = sConfigMgr->GetOption<int32>("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS]                  = sConfigMgr->GetOption<int32>("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS]      = sConfigMgr->GetOption<int32>("Startup.LoaderThreads", 1);
+    m_int_configs[CONFIG_AUCTION_LISTING_THREADS]     = sConfigMgr->GetOption<int32>("AuctionHouse.ListingThreads", 1);
+    m_int_configs[CONFIG_AUCTION_EXPIRY_BUDGET]       = sConfigMgr->GetOption<int32>("AuctionHouse.ExpiryBudget", 100);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetOption<int32>("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1360,6 +1377,9 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_CALCULATE_CREATURE_ZONE_AREA_DATA]   = sConfigMgr->GetOption<bool>("Calculate.Creature.Zone.Area.Data", false);
     m_bool_configs[CONFIG_CALCULATE_GAMEOBJECT_ZONE_AREA_DATA] = sConfigMgr->GetOption<bool>("Calculate.Gameoject.Zone.Area.Data", false);
 
+    // Binary cache of the spawn tables, rebuilt whenever the source tables change
+    m_bool_configs[CONFIG_WORLD_SNAPSHOT] = sConfigMgr->GetOption<bool>("WorldSnapshot.Enable", false);
+
     // Player can join LFG anywhere
     m_bool_configs[CONFIG_LFG_LOCATION_ALL] = sConfigMgr->GetOption<bool>("LFG.Location.All", false);
 
@@ -1415,6 +1435,18 @@ void World::LoadConfigSettings(bool reload)
 
 extern void LoadGameObjectModelList();
 
+void World::RunStartupTasks(acore::TaskGraph& graph, char const* name)
+{
+    uint32 threads = std::max<uint32>(1, getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    graph.Run(threads);
+
+    LOG_INFO("server", ">> Ran %s loaders in %u ms on %u thread(s), %u ms of serial work", name, graph.GetTotalTime(), threads, graph.GetSerialTime());
+    LOG_INFO("server", ">> Critical path:");
+    for (acore::TaskGraph::TaskTiming const& task : graph.GetCriticalPath())
+        LOG_INFO("server", ">>     %-32s started at %6u ms, took %6u ms", task.Name.c_str(), task.StartTime, task.Duration);
+    LOG_INFO("server", " ");
+}
+
 /// Initialize the World
 void World::SetInitialWorldSettings()
 {
@@ -1522,6 +1554,9 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server", "Loading spell custom attributes...");
     sSpellMgr->LoadSpellCustomAttr();
 
+    LOG_INFO("server", "Loading spell hot info...");
+    sSpellMgr->LoadSpellHotInfo();
+
     LOG_INFO("server", "Loading GameObject models...");
     LoadGameObjectModelList();
 
@@ -1539,111 +1574,199 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server", "Loading instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    LOG_INFO("server", "Loading Broadcast texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
+    ///- Static templates, each loader only reads DBC data, spell data and the stores of the loaders it depends on
+    acore::TaskGraph templateLoaders;
 
-    LOG_INFO("server", "Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    templateLoaders.AddTask("broadcast_texts", {}, []()
+    {
+        LOG_INFO("server", "Loading Broadcast texts...");
+        sObjectMgr->LoadBroadcastTexts();
+        sObjectMgr->LoadBroadcastTextLocales();
+    });
 
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    LOG_INFO("server", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server", " ");
+    templateLoaders.AddTask("creature_locales", {}, []() { sObjectMgr->LoadCreatureLocales(); });
+    templateLoaders.AddTask("gameobject_locales", {}, []() { sObjectMgr->LoadGameObjectLocales(); });
+    templateLoaders.AddTask("item_locales", {}, []() { sObjectMgr->LoadItemLocales(); });
+    templateLoaders.AddTask("item_set_name_locales", {}, []() { sObjectMgr->LoadItemSetNameLocales(); });
+    templateLoaders.AddTask("quest_locales", {}, []() { sObjectMgr->LoadQuestLocales(); });
+    templateLoaders.AddTask("quest_offer_reward_locales", {}, []() { sObjectMgr->LoadQuestOfferRewardLocale(); });
+    templateLoaders.AddTask("quest_request_items_locales", {}, []() { sObjectMgr->LoadQuestRequestItemsLocale(); });
+    templateLoaders.AddTask("npc_text_locales", {}, []() { sObjectMgr->LoadNpcTextLocales(); });
+    templateLoaders.AddTask("page_text_locales", {}, []() { sObjectMgr->LoadPageTextLocales(); });
+    templateLoaders.AddTask("gossip_menu_items_locales", {}, []() { sObjectMgr->LoadGossipMenuItemsLocales(); });
+    templateLoaders.AddTask("point_of_interest_locales", {}, []() { sObjectMgr->LoadPointOfInterestLocales(); });
 
-    LOG_INFO("server", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+    templateLoaders.AddTask("page_texts", {}, []()
+    {
+        LOG_INFO("server", "Loading Page Texts...");
+        sObjectMgr->LoadPageTexts();
+    });
+
+    templateLoaders.AddTask("gameobject_templates", { "page_texts" }, []()
+    {
+        LOG_INFO("server", "Loading Game Object Templates...");
+        sObjectMgr->LoadGameObjectTemplate();
+    });
+
+    templateLoaders.AddTask("gameobject_template_addons", { "gameobject_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Game Object template addons...");
+        sObjectMgr->LoadGameObjectTemplateAddons();
+    });
 
-    LOG_INFO("server", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    templateLoaders.AddTask("transport_templates", { "gameobject_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Transport templates...");
+        sTransportMgr->LoadTransportTemplates();
+    });
 
-    LOG_INFO("server", "Loading Game Object template addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
+    templateLoaders.AddTask("spell_required", {}, []()
+    {
+        LOG_INFO("server", "Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
+    });
 
-    LOG_INFO("server", "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
+    templateLoaders.AddTask("spell_groups", {}, []()
+    {
+        LOG_INFO("server", "Loading Spell Group types...");
+        sSpellMgr->LoadSpellGroups();
+    });
 
-    LOG_INFO("server", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+    templateLoaders.AddTask("spell_learn_skills", {}, []()
+    {
+        LOG_INFO("server", "Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();                       // must be after LoadSpellRanks
+    });
 
-    LOG_INFO("server", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
+    templateLoaders.AddTask("spell_proc_events", {}, []()
+    {
+        LOG_INFO("server", "Loading Spell Proc Event conditions...");
+        sSpellMgr->LoadSpellProcEvents();
+    });
 
-    LOG_INFO("server", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+    templateLoaders.AddTask("spell_procs", {}, []()
+    {
+        LOG_INFO("server", "Loading Spell Proc conditions and data...");
+        sSpellMgr->LoadSpellProcs();
+    });
 
-    LOG_INFO("server", "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+    templateLoaders.AddTask("spell_bonus_data", {}, []()
+    {
+        LOG_INFO("server", "Loading Spell Bonus Data...");
+        sSpellMgr->LoadSpellBonusess();
+    });
 
-    LOG_INFO("server", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+    templateLoaders.AddTask("spell_threats", {}, []()
+    {
+        LOG_INFO("server", "Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
+    });
 
-    LOG_INFO("server", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
+    templateLoaders.AddTask("spell_mixology", {}, []()
+    {
+        LOG_INFO("server", "Loading Mixology bonuses...");
+        sSpellMgr->LoadSpellMixology();
+    });
 
-    LOG_INFO("server", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+    templateLoaders.AddTask("spell_group_stack_rules", { "spell_groups" }, []()
+    {
+        LOG_INFO("server", "Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
+    });
 
-    LOG_INFO("server", "Loading Mixology bonuses...");
-    sSpellMgr->LoadSpellMixology();
+    templateLoaders.AddTask("gossip_texts", { "broadcast_texts" }, []()
+    {
+        LOG_INFO("server", "Loading NPC Texts...");
+        sObjectMgr->LoadGossipText();
+    });
 
-    LOG_INFO("server", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    templateLoaders.AddTask("spell_enchant_proc_data", {}, []()
+    {
+        LOG_INFO("server", "Loading Enchant Spells Proc datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    });
 
-    LOG_INFO("server", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    templateLoaders.AddTask("item_random_enchantments", {}, []()
+    {
+        LOG_INFO("server", "Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    LOG_INFO("server", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    templateLoaders.AddTask("disables", { "gameobject_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Disables");
+        DisableMgr::LoadDisables();                              // must be before loading quests and items
+    });
 
-    LOG_INFO("server", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    templateLoaders.AddTask("item_templates", { "item_random_enchantments", "page_texts", "disables" }, []()
+    {
+        LOG_INFO("server", "Loading Items...");
+        sObjectMgr->LoadItemTemplates();
+    });
 
-    LOG_INFO("server", "Loading Disables");
-    DisableMgr::LoadDisables();                                  // must be before loading quests and items
+    templateLoaders.AddTask("item_set_names", { "item_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Item set names...");
+        sObjectMgr->LoadItemSetNames();
+    });
 
-    LOG_INFO("server", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
+    templateLoaders.AddTask("creature_model_info", {}, []()
+    {
+        LOG_INFO("server", "Loading Creature Model Based Info Data...");
+        sObjectMgr->LoadCreatureModelInfo();
+    });
 
-    LOG_INFO("server", "Loading Item set names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemSetNames();
+    templateLoaders.AddTask("creature_templates", { "creature_model_info" }, []()
+    {
+        LOG_INFO("server", "Loading Creature templates...");
+        sObjectMgr->LoadCreatureTemplates();
+    });
 
-    LOG_INFO("server", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
+    templateLoaders.AddTask("equipment_templates", { "creature_templates", "item_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Equipment templates...");
+        sObjectMgr->LoadEquipmentTemplates();
+    });
 
-    LOG_INFO("server", "Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
+    templateLoaders.AddTask("creature_template_addons", { "creature_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Creature template addons...");
+        sObjectMgr->LoadCreatureTemplateAddons();
+    });
 
-    LOG_INFO("server", "Loading Equipment templates...");           // must be after LoadCreatureTemplates
-    sObjectMgr->LoadEquipmentTemplates();
+    templateLoaders.AddTask("reputation_reward_rates", {}, []()
+    {
+        LOG_INFO("server", "Loading Reputation Reward Rates...");
+        sObjectMgr->LoadReputationRewardRate();
+    });
 
-    LOG_INFO("server", "Loading Creature template addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
+    templateLoaders.AddTask("reputation_on_kill", { "creature_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Creature Reputation OnKill Data...");
+        sObjectMgr->LoadReputationOnKill();
+    });
 
-    LOG_INFO("server", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
+    templateLoaders.AddTask("reputation_spillover", {}, []()
+    {
+        LOG_INFO("server", "Loading Reputation Spillover Data..." );
+        sObjectMgr->LoadReputationSpilloverTemplate();
+    });
 
-    LOG_INFO("server", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
+    templateLoaders.AddTask("points_of_interest", {}, []()
+    {
+        LOG_INFO("server", "Loading Points Of Interest Data...");
+        sObjectMgr->LoadPointsOfInterest();
+    });
 
-    LOG_INFO("server", "Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
+    templateLoaders.AddTask("creature_class_level_stats", { "creature_templates" }, []()
+    {
+        LOG_INFO("server", "Loading Creature Base Stats...");
+        sObjectMgr->LoadCreatureClassLevelStats();
+    });
 
-    LOG_INFO("server", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
+    RunStartupTasks(templateLoaders, "template");
 
-    LOG_INFO("server", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
+    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
 
     LOG_INFO("server", "Loading Creature Data...");
     sObjectMgr->LoadCreatures();
@@ -1774,33 +1897,72 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server", "Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
+    ///- Loot, profession and achievement data only read the templates loaded above
+    acore::TaskGraph rewardLoaders;
 
-    LOG_INFO("server", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    rewardLoaders.AddTask("loot_tables", {}, []() { LoadLootTables(); });
 
-    LOG_INFO("server", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    rewardLoaders.AddTask("skill_discovery", {}, []()
+    {
+        LOG_INFO("server", "Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    });
 
-    LOG_INFO("server", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
+    rewardLoaders.AddTask("skill_extra_items", {}, []()
+    {
+        LOG_INFO("server", "Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
+
+    rewardLoaders.AddTask("skill_perfect_items", {}, []()
+    {
+        LOG_INFO("server", "Loading Skill Perfection Data Table...");
+        LoadSkillPerfectItemTable();
+    });
+
+    rewardLoaders.AddTask("fishing_base_skill", {}, []()
+    {
+        LOG_INFO("server", "Loading Skill Fishing base level requirements...");
+        sObjectMgr->LoadFishingBaseSkillLevel();
+    });
+
+    rewardLoaders.AddTask("achievement_references", {}, []()
+    {
+        LOG_INFO("server", "Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+    });
+
+    rewardLoaders.AddTask("achievement_criteria", { "achievement_references" }, []()
+    {
+        LOG_INFO("server", "Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
+    });
+
+    rewardLoaders.AddTask("achievement_criteria_data", { "achievement_criteria" }, []()
+    {
+        LOG_INFO("server", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+    });
+
+    rewardLoaders.AddTask("achievement_rewards", {}, []()
+    {
+        LOG_INFO("server", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+    });
+
+    rewardLoaders.AddTask("achievement_reward_locales", { "achievement_rewards" }, []()
+    {
+        LOG_INFO("server", "Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+    });
 
-    LOG_INFO("server", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    rewardLoaders.AddTask("completed_achievements", {}, []()
+    {
+        LOG_INFO("server", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
 
-    LOG_INFO("server", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    LOG_INFO("server", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    LOG_INFO("server", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    LOG_INFO("server", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    LOG_INFO("server", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    LOG_INFO("server", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    RunStartupTasks(rewardLoaders, "reward");
 
     ///- Load dynamic data tables from the database
     LOG_INFO("server", "Loading Item Auctions...");
@@ -1938,8 +2100,8 @@ void World::SetInitialWorldSettings()
                            realmID, uint32(m_startTime), GitRevision::GetFullVersion());       // One-time query
 
     m_timers[WUPDATE_WEATHERS].SetInterval(1 * IN_MILLISECONDS);
-    m_timers[WUPDATE_AUCTIONS].SetInterval(MINUTE * IN_MILLISECONDS);
-    m_timers[WUPDATE_AUCTIONS].SetCurrent(MINUTE * IN_MILLISECONDS);
+    m_timers[WUPDATE_AUCTIONS].SetInterval(1 * IN_MILLISECONDS);
+    m_timers[WUPDATE_AUCTIONS].SetCurrent(1 * IN_MILLISECONDS);
     m_timers[WUPDATE_UPTIME].SetInterval(m_int_configs[CONFIG_UPTIME_UPDATE]*MINUTE * IN_MILLISECONDS);
     //Update "uptime" table based on configuration entry in minutes.
 
@@ -1954,6 +2116,9 @@ void World::SetInitialWorldSettings()
     // our speed up
     m_timers[WUPDATE_5_SECS].SetInterval(5 * IN_MILLISECONDS);
 
+    // new guild log events are saved in batches
+    m_timers[WUPDATE_GUILD_LOGS].SetInterval(getIntConfig(CONFIG_GUILD_LOG_SAVE_INTERVAL) * IN_MILLISECONDS);
+
     mail_expire_check_timer = time(nullptr) + 6 * 3600;
 
     ///- Initilize static helper structures
@@ -2205,9 +2370,6 @@ void World::Update(uint32 diff)
         // moved here from HandleCharEnumOpcode
         PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EXPIRED_BANS);
         CharacterDatabase.Execute(stmt);
-
-        // copy players hashmapholder to avoid mutex
-        WhoListCacheMgr::Update();
     }
 
     ///- Update the game time and check for shutdown time
@@ -2234,29 +2396,39 @@ void World::Update(uint32 diff)
     if (m_gameTime > m_NextGuildReset)
         ResetGuildCap();
 
-    // pussywizard:
-    // acquire mutex now, this is kind of waiting for listing thread to finish it's work (since it can't process next packet)
-    // so we don't have to do it in every packet that modifies auctions
-    AsyncAuctionListingMgr::SetAuctionListingAllowed(false);
+    if (m_timers[WUPDATE_GUILD_LOGS].Passed())
     {
-        std::lock_guard<std::mutex> guard(AsyncAuctionListingMgr::GetLock());
+        m_timers[WUPDATE_GUILD_LOGS].Reset();
+        sGuildMgr->SaveGuildLogs();
+    }
 
-        // pussywizard: handle auctions when the timer has passed
-        if (m_timers[WUPDATE_AUCTIONS].Passed())
-        {
-            m_timers[WUPDATE_AUCTIONS].Reset();
+    // pussywizard: handle auctions when the timer has passed
+    // listing threads search published snapshots of the auctions, they don't need to be stopped for this
+    if (m_timers[WUPDATE_AUCTIONS].Passed())
+    {
+        m_timers[WUPDATE_AUCTIONS].Reset();
 
-            // pussywizard: handle expired auctions, auctions expired when realm was offline are also handled here (not during loading when many required things aren't loaded yet)
-            sAuctionMgr->Update();
-        }
+        // pussywizard: handle expired auctions, auctions expired when realm was offline are also handled here (not during loading when many required things aren't loaded yet)
+        sAuctionMgr->Update();
+    }
 
-        AsyncAuctionListingMgr::Update(diff);
+    AsyncAuctionListingMgr::Update(diff);
 
-        if (m_gameTime > mail_expire_check_timer)
-        {
-            sObjectMgr->ReturnOrDeleteOldMails(true);
-            mail_expire_check_timer = m_gameTime + 6 * 3600;
-        }
+    // expired mails are read page by page in the background, one page is handled per update
+    if (m_gameTime > mail_expire_check_timer)
+    {
+        sObjectMgr->StartMailExpiry();
+        mail_expire_check_timer = m_gameTime + 6 * 3600;
+    }
+
+    sObjectMgr->UpdateMailExpiry();
+
+    // pussywizard:
+    // acquire mutex now, this is kind of waiting for listing threads to finish their work (since they can't process next packet)
+    // players may leave the world during the session updates, listing threads must not run meanwhile
+    AsyncAuctionListingMgr::SetAuctionListingAllowed(false);
+    {
+        std::unique_lock<std::shared_mutex> guard(AsyncAuctionListingMgr::GetLock());
 
         UpdateSessions(diff);
     }
@@ -2286,7 +2458,7 @@ void World::Update(uint32 diff)
         }
     }
 
-    sLFGMgr->Update(diff, 0); // pussywizard: remove obsolete stuff before finding compatibility during map update
+    sLFGMgr->Update(diff, 0); // pussywizard: remove obsolete stuff, send queue status
 
     sMapMgr->Update(diff);
 
@@ -2305,7 +2477,7 @@ void World::Update(uint32 diff)
 
     sBattlefieldMgr->Update(diff);
 
-    sLFGMgr->Update(diff, 2); // pussywizard: handle created proposals
+    sLFGMgr->Update(diff, 2); // pussywizard: handle proposals found by the matchmaking thread
 
     // execute callbacks from sql queries that were queued recently
     ProcessQueryCallbacks();
@@ -2378,6 +2550,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, TeamId teamId)
 {
+    SharedWorldPacket shared(*packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2387,7 +2560,7 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, TeamId te
                 itr->second != self &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(shared);
         }
     }
 }
@@ -2395,6 +2568,7 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, TeamId te
 /// Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, TeamId teamId)
 {
+    SharedWorldPacket shared(*packet);
     SessionMap::iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2405,7 +2579,7 @@ void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, TeamId
                 !AccountMgr::IsPlayerAccount(itr->second->GetSecurity()) &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(shared);
         }
     }
 }
@@ -2517,6 +2691,7 @@ void World::SendGlobalText(const char* text, WorldSession* self)
 bool World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self, TeamId teamId)
 {
     bool foundPlayerToSend = false;
+    SharedWorldPacket shared(*packet);
     SessionMap::const_iterator itr;
 
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
@@ -2528,7 +2703,7 @@ bool World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self
                 itr->second != self &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(shared);
             foundPlayerToSend = true;
         }
     }
@@ -3208,6 +3383,8 @@ void World::LoadGlobalPlayerDataStore()
         return;
     }
 
+    sPlayerNameIndex->Reserve(result->GetRowCount());
+
     uint32 count = 0;
 
     // query to load number of mails by receiver
@@ -3270,7 +3447,7 @@ void World::AddGlobalPlayerData(uint32 guid, uint32 accountId, std::string const
     data.arenaTeamId[2] = 0;
 
     _globalPlayerDataStore[guid] = data;
-    _globalPlayerNameStore[name] = guid;
+    sPlayerNameIndex->Insert(name, guid);
 }
 
 void World::UpdateGlobalPlayerData(uint32 guid, uint8 mask, std::string const& name, uint8 level, uint8 gender, uint8 race, uint8 playerClass)
@@ -3341,8 +3518,8 @@ void World::UpdateGlobalPlayerArenaTeam(uint32 guid, uint8 slot, uint32 arenaTea
 
 void World::UpdateGlobalNameData(uint32 guidLow, std::string const& oldName, std::string const& newName)
 {
-    _globalPlayerNameStore.erase(oldName);
-    _globalPlayerNameStore[newName] = guidLow;
+    sPlayerNameIndex->Remove(oldName);
+    sPlayerNameIndex->Insert(newName, guidLow);
 }
 
 void World::DeleteGlobalPlayerData(uint32 guid, std::string const& name)
@@ -3350,7 +3527,7 @@ void World::DeleteGlobalPlayerData(uint32 guid, std::string const& name)
     if (guid)
         _globalPlayerDataStore.erase(guid);
     if (!name.empty())
-        _globalPlayerNameStore.erase(name);
+        sPlayerNameIndex->Remove(name);
 }
 
 GlobalPlayerData const* World::GetGlobalPlayerData(uint32 guid) const
@@ -3404,9 +3581,8 @@ GlobalPlayerData const* World::GetGlobalPlayerData(uint32 guid) const
 uint32 World::GetGlobalPlayerGUID(std::string const& name) const
 {
     // Get data from global storage
-    GlobalPlayerNameMap::const_iterator itr = _globalPlayerNameStore.find(name);
-    if (itr != _globalPlayerNameStore.end())
-        return itr->second;
+    if (uint32 guidLow = sPlayerNameIndex->Find(name))
+        return guidLow;
 
     // Player is not in the global storage, try to get it from the Database
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_DATA_BY_NAME);
@@ -3437,8 +3613,7 @@ uint32 World::GetGlobalPlayerGUID(std::string const& name) const
             0                      /*guild id*/
         );
 
-        itr = _globalPlayerNameStore.find(name);
-        if (itr != _globalPlayerNameStore.end())
+        if (sPlayerNameIndex->Find(name))
         {
             LOG_INFO("server", "Player %s [GUID: %u] added to the global storage.", name.c_str(), guidLow);
 
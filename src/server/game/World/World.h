@@ -27,6 +27,11 @@ class WorldPacket;
 class WorldSocket;
 class SystemMgr;
 
+namespace acore
+{
+    class TaskGraph;
+}
+
 extern uint32 realmID;
 
 enum ShutdownMask
@@ -55,6 +60,7 @@ enum WorldTimers
     WUPDATE_MAILBOXQUEUE,
     WUPDATE_PINGDB,
     WUPDATE_5_SECS,
+    WUPDATE_GUILD_LOGS,
     WUPDATE_COUNT
 };
 
@@ -150,7 +156,6 @@ enum GlobalPlayerUpdateMask
 };
 
 typedef std::map<uint32, GlobalPlayerData> GlobalPlayerDataMap;
-typedef std::map<std::string, uint32> GlobalPlayerNameMap;
 
 // xinef: petitions storage
 struct PetitionData
@@ -399,6 +404,8 @@ protected:
     // callback for UpdateRealmCharacters
     void _UpdateRealmCharCount(PreparedQueryResult resultCharCount);
 
+    void RunStartupTasks(acore::TaskGraph& graph, char const* name);
+
     void InitDailyQuestResetTime();
     void InitWeeklyQuestResetTime();
     void InitMonthlyQuestResetTime();
@@ -460,7 +467,6 @@ private:
 
     // our speed ups
     GlobalPlayerDataMap _globalPlayerDataStore; // xinef
-    GlobalPlayerNameMap _globalPlayerNameStore; // xinef
 
     std::string _realmName;
 
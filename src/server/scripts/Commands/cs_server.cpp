@@ -11,12 +11,15 @@ Comment: All server related commands
 Category: commandscripts
 EndScriptData */
 
+#include "AchievementMgr.h"
 #include "AvgDiffTracker.h"
 #include "Chat.h"
 #include "Config.h"
 #include "GitRevision.h"
+#include "Group.h"
 #include "Language.h"
 #include "ObjectAccessor.h"
+#include "ObjectMgr.h"
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "ServerMotd.h"
@@ -112,7 +115,19 @@ public:
         if (handler->GetSession())
             if (Player* p = handler->GetSession()->GetPlayer())
                 if (p->IsDeveloper())
+                {
                     handler->PSendSysMessage("DEV wavg: %ums, nsmax: %ums, nsavg: %ums. LFG avg: %ums, max: %ums.", avgDiffTracker.getTimeWeightedAverage(), devDiffTracker.getMax(), devDiffTracker.getAverage(), lfgDiffTracker.getAverage(), lfgDiffTracker.getMax());
+                    handler->PSendSysMessage("Party member stats: %u built, %u sent, %u deferred, %u unneeded.", groupMemberStatsCounters.Built.load(), groupMemberStatsCounters.Sent.load(),
+                        groupMemberStatsCounters.Deferred.load(), groupMemberStatsCounters.Unneeded.load());
+
+                    handler->PSendSysMessage("Achievement saves: %u flushes, %u rows in %u statements.", achievementSaveCounters.Flushes.load(),
+                        achievementSaveCounters.Rows.load(), achievementSaveCounters.Statements.load());
+
+                    MailExpiryProgress const& mailExpiry = sObjectMgr->GetMailExpiryProgress();
+                    if (mailExpiry.Running)
+                        handler->PSendSysMessage("Mail expiry: %u pages, %u deleted, %u returned, %u skipped in %ums.", mailExpiry.Pages,
+                            mailExpiry.Deleted, mailExpiry.Returned, mailExpiry.Skipped, GetMSTimeDiffToNow(mailExpiry.StartTime));
+                }
 
         //! Can't use sWorld->ShutdownMsg here in case of console command
         if (sWorld->IsShuttingDown())
@@ -177,8 +177,8 @@ public:
                         //Count alive players
                         uint8 count = 0;
                         Unit* pTarget;
-                        std::list<HostileReference*> t_list = me->getThreatManager().getThreatList();
-                        for (std::list<HostileReference*>::const_iterator itr = t_list.begin(); itr != t_list.end(); ++itr)
+                        ThreatContainer::StorageType t_list = me->getThreatManager().getThreatList();
+                        for (ThreatContainer::StorageType::const_iterator itr = t_list.begin(); itr != t_list.end(); ++itr)
                         {
                             pTarget = ObjectAccessor::GetUnit(*me, (*itr)->getUnitGuid());
                             if (pTarget && pTarget->GetTypeId() == TYPEID_PLAYER && pTarget->IsAlive())
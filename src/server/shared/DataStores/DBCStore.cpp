@@ -6,6 +6,7 @@
 
 #include "DBCDatabaseLoader.h"
 #include "DBCStore.h"
+#include "DBCFileLoader.h"
 
 DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0)
 {
@@ -30,15 +31,21 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
 
     _fieldCount = dbc.GetCols();
 
-    // load raw non-string data
+    // load raw non-string data, or index the file records directly when the format allows it
     _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
-    // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
-
     // error in dbc file at loading if nullptr
-    return indexTable != nullptr;
+    if (!indexTable)
+        return false;
+
+    // string fields point into the file string block
+    dbc.AutoProduceStrings(_fileFormat, _dataTable);
+
+    if (_dataTable)
+        dbc.DiscardRecords();
+
+    _files.push_back(dbc.ReleaseFile());
+    return true;
 }
 
 bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
@@ -54,9 +61,10 @@ bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
         return false;
 
     // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    if (!dbc.AutoProduceStrings(_fileFormat, _dataTable))
+        return false;
 
+    _files.push_back(dbc.ReleaseFile());
     return true;
 }
 
@@ -12,8 +12,11 @@
 #include "Errors.h"
 #include <G3D/AABox.h>
 #include <G3D/Vector3.h>
+#include <memory>
 #include <vector>
 
+class DBCFileData;
+
  // Structures for M4 file. Source: https://wowdev.wiki
 template<typename T>
 struct M2SplineKey
@@ -148,8 +151,9 @@ protected:
 
     uint32 _fieldCount;
     char const* _fileFormat;
-    char* _dataTable;
+    char* _dataTable;                                   // nullptr when the records are used in place
     std::vector<char*> _stringPool;
+    std::vector<std::unique_ptr<DBCFileData>> _files;   // mapped files the records and strings point into
     uint32 _indexTableSize;
 };
 
@@ -169,8 +169,14 @@ int Master::Run()
     acore::Thread rarThread(new RARunnable);
 
     // pussywizard:
-    acore::Thread auctionLising_thread(new AuctionListingRunnable);
-    auctionLising_thread.setPriority(acore::Priority_High);
+    std::vector<acore::Thread*> auctionListingThreads;
+    for (uint32 i = 0; i < std::max<uint32>(1, sWorld->getIntConfig(CONFIG_AUCTION_LISTING_THREADS)); ++i)
+    {
+        auctionListingThreads.push_back(new acore::Thread(new AuctionListingRunnable));
+        auctionListingThreads.back()->setPriority(acore::Priority_High);
+    }
+
+    acore::Thread lfgMatchmakingThread(new LFGMatchmakingRunnable);
 
 #if defined(_WIN32) || defined(__linux__)
 
@@ -277,7 +283,12 @@ int Master::Run()
     // since worldrunnable uses them, it will crash if unloaded after master
     worldThread.wait();
     rarThread.wait();
-    auctionLising_thread.wait();
+    for (acore::Thread* auctionListingThread : auctionListingThreads)
+    {
+        auctionListingThread->wait();
+        delete auctionListingThread;
+    }
+    lfgMatchmakingThread.wait();
 
     if (soapThread)
     {
@@ -13,6 +13,8 @@
 #include "BattlegroundMgr.h"
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "GuildMgr.h"
+#include "LFGMgr.h"
 #include "MapManager.h"
 #include "ObjectAccessor.h"
 #include "OutdoorPvPMgr.h"
@@ -68,6 +70,7 @@ void WorldRunnable::run()
 
     sWorld->KickAll();                                       // save and kick all players
     sWorld->UpdateSessions( 1 );                             // real players unload required UpdateSessions call
+    sGuildMgr->SaveGuildLogs();                              // guild log entries since the last periodic save
 
     // unload battleground templates before different singletons destroyed
     sBattlegroundMgr->DeleteAllBattlegrounds();
@@ -88,40 +91,23 @@ void AuctionListingRunnable::run()
     LOG_INFO("server", "Starting up Auction House Listing thread...");
     while (!World::IsStopped())
     {
-        if (AsyncAuctionListingMgr::IsAuctionListingAllowed())
-        {
-            uint32 diff = AsyncAuctionListingMgr::GetDiff();
-            AsyncAuctionListingMgr::ResetDiff();
-
-            if (AsyncAuctionListingMgr::GetTempList().size() || AsyncAuctionListingMgr::GetList().size())
-            {
-                std::lock_guard<std::mutex> guard(AsyncAuctionListingMgr::GetLock());
-
-                {
-                    std::lock_guard<std::mutex> guard(AsyncAuctionListingMgr::GetTempLock());
-                    for (std::list<AuctionListItemsDelayEvent>::iterator itr = AsyncAuctionListingMgr::GetTempList().begin(); itr != AsyncAuctionListingMgr::GetTempList().end(); ++itr)
-                        AsyncAuctionListingMgr::GetList().push_back( (*itr) );
-                    AsyncAuctionListingMgr::GetTempList().clear();
-                }
-
-                for (std::list<AuctionListItemsDelayEvent>::iterator itr = AsyncAuctionListingMgr::GetList().begin(); itr != AsyncAuctionListingMgr::GetList().end(); ++itr)
-                {
-                    if ((*itr)._msTimer <= diff)
-                        (*itr)._msTimer = 0;
-                    else
-                        (*itr)._msTimer -= diff;
-                }
-
-                for (std::list<AuctionListItemsDelayEvent>::iterator itr = AsyncAuctionListingMgr::GetList().begin(); itr != AsyncAuctionListingMgr::GetList().end(); ++itr)
-                    if ((*itr)._msTimer == 0)
-                    {
-                        if ((*itr).Execute())
-                            AsyncAuctionListingMgr::GetList().erase(itr);
-                        break;
-                    }
-            }
-        }
-        acore::Thread::Sleep(1);
+        // keep going while there is work, several listing threads share the queue
+        if (!AsyncAuctionListingMgr::ExecuteNext())
+            acore::Thread::Sleep(1);
     }
     LOG_INFO("server", "Auction House Listing thread exiting without problems.");
 }
+
+void LFGMatchmakingRunnable::run()
+{
+    LOG_INFO("server", "Starting up LFG Matchmaking thread...");
+    while (!World::IsStopped())
+    {
+        uint32 startTime = getMSTime();
+        if (sLFGMgr->UpdateMatchmaking())
+            lfgDiffTracker.Update(getMSTimeDiff(startTime, getMSTime()));
+        else
+            acore::Thread::Sleep(50);
+    }
+    LOG_INFO("server", "LFG Matchmaking thread exiting without problems.");
+}
@@ -23,5 +23,12 @@ class AuctionListingRunnable : public acore::Runnable
 public:
     void run() override;
 };
+
+/// Dungeon finder matchmaking, proposals are handed to the world thread
+class LFGMatchmakingRunnable : public acore::Runnable
+{
+public:
+    void run() override;
+};
 #endif
 /// @}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "DBCFileLoader.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Writes a WDBC file made of 4 byte fields
+    std::string WriteDBC(char const* name, std::vector<std::vector<uint32>> const& records, std::string const& strings)
+    {
+        std::string fileName = testing::TempDir() + name;
+        FILE* f = fopen(fileName.c_str(), "wb");
+        uint32 header[5] = { 0x43424457, uint32(records.size()), uint32(records[0].size()), uint32(records[0].size() * sizeof(uint32)), uint32(strings.size()) };
+        fwrite(header, sizeof(header), 1, f);
+        for (std::vector<uint32> const& record : records)
+            fwrite(record.data(), sizeof(uint32), record.size(), f);
+        fwrite(strings.data(), strings.size(), 1, f);
+        fclose(f);
+        return fileName;
+    }
+
+    // same packing as the structures of DBCStructure.h
+#if defined(__GNUC__)
+#pragma pack(1)
+#else
+#pragma pack(push, 1)
+#endif
+
+    struct PlainEntry
+    {
+        uint32 ID;
+        uint32 Value;
+        float Multiplier;
+    };
+
+    struct NamedEntry
+    {
+        uint32 ID;
+        char const* Name;
+    };
+
+#if defined(__GNUC__)
+#pragma pack()
+#else
+#pragma pack(pop)
+#endif
+
+    uint32 FloatBits(float value)
+    {
+        uint32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+TEST(DBCFileLoaderTest, PlainRecordsAreUsedInPlace)
+{
+    std::string fileName = WriteDBC("plain.dbc", { { 2, 20, FloatBits(0.5f) }, { 5, 50, FloatBits(1.5f) } }, std::string(1, '\0'));
+
+    DBCFileLoader dbc;
+    ASSERT_TRUE(dbc.Load(fileName.c_str(), "nif"));
+    EXPECT_TRUE(dbc.CanUseRecordsInPlace("nif"));
+
+    uint32 count = 0;
+    char** indexTable = nullptr;
+    EXPECT_EQ(dbc.AutoProduceData("nif", count, indexTable), nullptr);
+    ASSERT_NE(indexTable, nullptr);
+    std::unique_ptr<DBCFileData> file = dbc.ReleaseFile();
+
+    ASSERT_EQ(count, 6u);
+    EXPECT_EQ(indexTable[0], nullptr);
+    EXPECT_EQ(indexTable[3], nullptr);
+
+    PlainEntry const* entry = reinterpret_cast<PlainEntry const*>(indexTable[5]);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->ID, 5u);
+    EXPECT_EQ(entry->Value, 50u);
+    EXPECT_EQ(entry->Multiplier, 1.5f);
+    EXPECT_GE(reinterpret_cast<unsigned char const*>(entry), file->GetData());
+    EXPECT_LT(reinterpret_cast<unsigned char const*>(entry), file->GetData() + file->GetSize());
+
+    delete[] indexTable;
+    std::remove(fileName.c_str());
+}
+
+TEST(DBCFileLoaderTest, StringsPointIntoTheFile)
+{
+    std::string strings("\0First\0Second\0", 14);
+    std::string fileName = WriteDBC("named.dbc", { { 1, 7, 1 }, { 2, 0, 1 } }, strings);
+
+    DBCFileLoader dbc;
+    ASSERT_TRUE(dbc.Load(fileName.c_str(), "nsx"));
+    EXPECT_FALSE(dbc.CanUseRecordsInPlace("nsx"));
+
+    uint32 count = 0;
+    char** indexTable = nullptr;
+    char* dataTable = dbc.AutoProduceData("nsx", count, indexTable);
+    ASSERT_NE(dataTable, nullptr);
+    ASSERT_TRUE(dbc.AutoProduceStrings("nsx", dataTable));
+    std::unique_ptr<DBCFileData> file = dbc.ReleaseFile();
+
+    NamedEntry const* first = reinterpret_cast<NamedEntry const*>(indexTable[1]);
+    NamedEntry const* second = reinterpret_cast<NamedEntry const*>(indexTable[2]);
+    EXPECT_STREQ(first->Name, "Second");
+    EXPECT_STREQ(second->Name, "");
+    EXPECT_GE(reinterpret_cast<unsigned char const*>(first->Name), file->GetData());
+    EXPECT_LT(reinterpret_cast<unsigned char const*>(first->Name), file->GetData() + file->GetSize());
+
+    delete[] dataTable;
+    delete[] indexTable;
+    std::remove(fileName.c_str());
+}
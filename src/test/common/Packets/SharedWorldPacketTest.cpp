@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "SharedWorldPacket.h"
+#include "gtest/gtest.h"
+#include <cstring>
+
+TEST(SharedWorldPacketTest, PayloadIsCopiedOnceOnFirstUse)
+{
+    // a chat message
+    WorldPacket data(0x96, 300);
+    for (uint32 i = 0; i < 300; ++i)
+        data << uint8(i);
+
+    SharedWorldPacket packet(data);
+    EXPECT_EQ(&packet.GetPacket(), &data);
+
+    std::shared_ptr<WorldPacket const> payload = packet.GetPayload();
+    ASSERT_NE(payload.get(), &data);
+    EXPECT_EQ(payload->GetOpcode(), data.GetOpcode());
+    ASSERT_EQ(payload->size(), data.size());
+    EXPECT_EQ(std::memcmp(payload->contents(), data.contents(), data.size()), 0);
+
+    // every socket of the broadcast gets the same payload
+    for (uint32 recipient = 0; recipient < 2000; ++recipient)
+        EXPECT_EQ(packet.GetPayload().get(), payload.get());
+
+    // the sockets keep it alive after the broadcast is over
+    {
+        SharedWorldPacket broadcast(data);
+        payload = broadcast.GetPayload();
+    }
+    EXPECT_EQ(payload.use_count(), 1);
+    EXPECT_EQ(payload->size(), data.size());
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "TaskGraph.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace acore;
+
+TEST(TaskGraphTest, SingleThreadKeepsDeclarationOrder)
+{
+    std::vector<std::string> order;
+    TaskGraph graph;
+    graph.AddTask("spells", {}, [&]() { order.push_back("spells"); });
+    graph.AddTask("locales", {}, [&]() { order.push_back("locales"); });
+    graph.AddTask("items", { "spells" }, [&]() { order.push_back("items"); });
+    graph.AddTask("loot", { "items", "locales" }, [&]() { order.push_back("loot"); });
+
+    graph.Run(1);
+
+    EXPECT_EQ(order, std::vector<std::string>({ "spells", "locales", "items", "loot" }));
+}
+
+TEST(TaskGraphTest, TasksStartAfterTheirDependencies)
+{
+    constexpr uint32 TASK_COUNT = 64;
+    std::atomic<bool> done[TASK_COUNT];
+    std::atomic<uint32> violations(0);
+    for (std::atomic<bool>& flag : done)
+        flag = false;
+
+    TaskGraph graph;
+    for (uint32 i = 0; i < TASK_COUNT; ++i)
+    {
+        // every task depends on the two tasks declared 3 and 7 places before it
+        std::vector<std::string> dependencies;
+        std::vector<uint32> dependencyIndexes;
+        for (uint32 offset : { 3, 7 })
+        {
+            if (i >= offset)
+            {
+                dependencies.push_back(std::to_string(i - offset));
+                dependencyIndexes.push_back(i - offset);
+            }
+        }
+
+        graph.AddTask(std::to_string(i), dependencies, [&, i, dependencyIndexes]()
+        {
+            for (uint32 dependency : dependencyIndexes)
+                if (!done[dependency])
+                    ++violations;
+
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            done[i] = true;
+        });
+    }
+
+    graph.Run(4);
+
+    EXPECT_EQ(violations, 0u);
+    for (std::atomic<bool>& flag : done)
+        EXPECT_TRUE(flag);
+}
+
+// Startup loaders mostly wait on database round trips, sleeping tasks model that
+TEST(TaskGraphTest, IndependentLoadersOverlap)
+{
+    auto wait = [](uint32 ms) { return [ms]() { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }; };
+
+    TaskGraph graph;
+    graph.AddTask("spell_info", {}, wait(20));
+    graph.AddTask("quest_locales", {}, wait(40));
+    graph.AddTask("gossip_text", {}, wait(40));
+    graph.AddTask("items", { "spell_info" }, wait(40));
+    graph.AddTask("item_set_names", { "items" }, wait(10));
+    graph.AddTask("loot", { "items" }, wait(40));
+
+    graph.Run(4);
+
+    std::vector<TaskGraph::TaskTiming> criticalPath = graph.GetCriticalPath();
+    ASSERT_EQ(criticalPath.size(), 3u);
+    EXPECT_EQ(criticalPath[0].Name, "spell_info");
+    EXPECT_EQ(criticalPath[1].Name, "items");
+    EXPECT_EQ(criticalPath[2].Name, "loot");
+
+    EXPECT_GE(graph.GetSerialTime(), 190u);
+    EXPECT_LT(graph.GetTotalTime(), graph.GetSerialTime());
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "ArenaSpectator.h"
+#include "WorldMock.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+// symbols the worldserver defines, shared by all tests that include the world mock
+uint32 realmID;
+void AddScripts() {}
+bool ArenaSpectator::HandleSpectatorSpectateCommand(ChatHandler* handler, char const* args) { return false; }
+
+#pragma GCC diagnostic pop
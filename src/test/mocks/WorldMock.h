@@ -5,17 +5,12 @@
 #ifndef AZEROTHCORE_WORLDMOCK_H
 #define AZEROTHCORE_WORLDMOCK_H
 
-#include "ArenaSpectator.h"
 #include "gmock/gmock.h"
 #include "IWorld.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 
-uint32 realmID;
-void AddScripts() {}
-bool ArenaSpectator::HandleSpectatorSpectateCommand(ChatHandler* handler, char const* args) { return false; }
-
 class WorldMock: public IWorld {
 public:
     ~WorldMock() override {}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "SmartScript.h"
+#include "gtest/gtest.h"
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    SmartScriptHolder MakeEvent(SMART_EVENT type, uint32 phaseMask)
+    {
+        SmartScriptHolder holder;
+        holder.event.type = type;
+        holder.event.event_phase_mask = phaseMask;
+        return holder;
+    }
+
+    std::vector<uint16> GroupEvents(SmartEventDispatchTable const& table, SMART_EVENT type)
+    {
+        SmartEventDispatchTable::Group const* group = table.GetGroup(type);
+        if (!group)
+            return { };
+
+        uint16 const* events = table.GetEvents(*group);
+        return std::vector<uint16>(events, events + group->count);
+    }
+
+    class SmartEventDispatchTableTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _events = {
+                MakeEvent(SMART_EVENT_UPDATE_IC, SMART_EVENT_PHASE_1_BIT),  // 0
+                MakeEvent(SMART_EVENT_LINK, 0),                             // 1
+                MakeEvent(SMART_EVENT_AGGRO, 0),                            // 2
+                MakeEvent(SMART_EVENT_DAMAGED, SMART_EVENT_PHASE_3_BIT),    // 3
+                MakeEvent(SMART_EVENT_UPDATE_IC, SMART_EVENT_PHASE_2_BIT),  // 4
+                MakeEvent(SMART_EVENT_AGGRO, SMART_EVENT_PHASE_2_BIT),      // 5
+                MakeEvent(SMART_EVENT_LINK, SMART_EVENT_PHASE_1_BIT)        // 6
+            };
+            _table.Compile(_events);
+        }
+
+        SmartAIEventList _events;
+        SmartEventDispatchTable _table;
+    };
+}
+
+TEST_F(SmartEventDispatchTableTest, GroupsEventsByTypeInScriptOrder)
+{
+    EXPECT_EQ(GroupEvents(_table, SMART_EVENT_UPDATE_IC), std::vector<uint16>({ 0, 4 }));
+    EXPECT_EQ(GroupEvents(_table, SMART_EVENT_AGGRO), std::vector<uint16>({ 2, 5 }));
+    EXPECT_EQ(GroupEvents(_table, SMART_EVENT_DAMAGED), std::vector<uint16>({ 3 }));
+    EXPECT_EQ(_table.GetGroup(SMART_EVENT_SPELLHIT), nullptr);
+}
+
+TEST_F(SmartEventDispatchTableTest, LinksAreNotDispatched)
+{
+    EXPECT_EQ(_table.GetGroup(SMART_EVENT_LINK), nullptr);
+    EXPECT_EQ(_table.GetUpdateEvents(), std::vector<uint16>({ 0, 2, 3, 4, 5 }));
+}
+
+TEST_F(SmartEventDispatchTableTest, MergesPhaseMasks)
+{
+    SmartEventDispatchTable::Group const* update = _table.GetGroup(SMART_EVENT_UPDATE_IC);
+    ASSERT_NE(update, nullptr);
+    EXPECT_FALSE(update->anyPhase);
+    EXPECT_EQ(update->phaseMask, SMART_EVENT_PHASE_1_BIT | SMART_EVENT_PHASE_2_BIT);
+
+    SmartEventDispatchTable::Group const* aggro = _table.GetGroup(SMART_EVENT_AGGRO);
+    ASSERT_NE(aggro, nullptr);
+    EXPECT_TRUE(aggro->anyPhase);
+}
+
+TEST_F(SmartEventDispatchTableTest, PhaseZeroOnlyRunsEventsWithoutPhase)
+{
+    // IsInPhase is false for every mask in phase 0, only events without a phase mask can fire
+    EXPECT_FALSE(SmartEventDispatchTable::IsInPhase(0, SMART_EVENT_PHASE_ALL));
+    EXPECT_FALSE(_table.GetGroup(SMART_EVENT_UPDATE_IC)->CanFireInPhase(0));
+    EXPECT_FALSE(_table.GetGroup(SMART_EVENT_DAMAGED)->CanFireInPhase(0));
+    EXPECT_TRUE(_table.GetGroup(SMART_EVENT_AGGRO)->CanFireInPhase(0));
+
+    EXPECT_TRUE(_table.GetGroup(SMART_EVENT_UPDATE_IC)->CanFireInPhase(2));
+    EXPECT_FALSE(_table.GetGroup(SMART_EVENT_DAMAGED)->CanFireInPhase(2));
+    EXPECT_TRUE(_table.GetGroup(SMART_EVENT_DAMAGED)->CanFireInPhase(3));
+}
+
+TEST_F(SmartEventDispatchTableTest, EarlyExitNeverSkipsAnEventOfThePhase)
+{
+    // same test as ProcessEvent for each event of the group
+    for (SMART_EVENT type : { SMART_EVENT_UPDATE_IC, SMART_EVENT_AGGRO, SMART_EVENT_DAMAGED })
+    {
+        SmartEventDispatchTable::Group const* group = _table.GetGroup(type);
+        ASSERT_NE(group, nullptr);
+
+        for (uint32 phase = 0; phase < SMART_EVENT_PHASE_MAX; ++phase)
+        {
+            bool eventCanFire = false;
+            for (uint16 index : GroupEvents(_table, type))
+            {
+                uint32 phaseMask = _events[index].event.event_phase_mask;
+                eventCanFire |= !phaseMask || SmartEventDispatchTable::IsInPhase(phase, phaseMask);
+            }
+
+            EXPECT_EQ(group->CanFireInPhase(phase), eventCanFire) << "type " << uint32(type) << " phase " << phase;
+        }
+    }
+}
+
+TEST_F(SmartEventDispatchTableTest, RecompilesInstalledEvents)
+{
+    _events.push_back(MakeEvent(SMART_EVENT_SPELLHIT, 0));
+    _events.push_back(MakeEvent(SMART_EVENT_UPDATE_IC, 0));
+    _table.Compile(_events);
+
+    EXPECT_EQ(GroupEvents(_table, SMART_EVENT_SPELLHIT), std::vector<uint16>({ 7 }));
+    EXPECT_EQ(GroupEvents(_table, SMART_EVENT_UPDATE_IC), std::vector<uint16>({ 0, 4, 8 }));
+    EXPECT_TRUE(_table.GetGroup(SMART_EVENT_UPDATE_IC)->CanFireInPhase(0));
+    EXPECT_EQ(_table.GetUpdateEvents(), std::vector<uint16>({ 0, 2, 3, 4, 5, 7, 8 }));
+}
+
+TEST(SmartScriptTargetListPool, ReusesReleasedLists)
+{
+    ObjectList* first = SmartScript::AcquireTargetList();
+    EXPECT_TRUE(first->empty());
+
+    first->push_back(nullptr);
+    SmartScript::ReleaseTargetList(first);
+
+    ObjectList* second = SmartScript::AcquireTargetList();
+    EXPECT_EQ(second, first);
+    EXPECT_TRUE(second->empty());
+    SmartScript::ReleaseTargetList(second);
+
+    SmartScript::ReleaseTargetList(nullptr);
+}
+
+TEST(SmartScriptTargetListPool, DropsHugeLists)
+{
+    ObjectList* small = SmartScript::AcquireTargetList();
+    ObjectList* huge = SmartScript::AcquireTargetList();
+    huge->resize(4096);
+
+    SmartScript::ReleaseTargetList(small);
+    SmartScript::ReleaseTargetList(huge);
+
+    // the huge list was freed, the small one is handed out again
+    ObjectList* targets = SmartScript::AcquireTargetList();
+    EXPECT_EQ(targets, small);
+    SmartScript::ReleaseTargetList(targets);
+}
+
+TEST(SmartScriptTargetListPool, KeepsABoundedNumberOfLists)
+{
+    // a new thread starts with an empty pool, which keeps up to 32 lists
+    std::thread([]()
+    {
+        std::vector<ObjectList*> lists;
+        for (uint32 i = 0; i < 64; ++i)
+            lists.push_back(SmartScript::AcquireTargetList());
+
+        for (ObjectList* targets : lists)
+            SmartScript::ReleaseTargetList(targets);
+
+        // the lists released once the pool was full were freed, the pool hands out the first ones last in first out
+        std::set<ObjectList*> expected(lists.begin(), lists.begin() + 32);
+        std::set<ObjectList*> pooled;
+        for (uint32 i = 0; i < 32; ++i)
+        {
+            ObjectList* targets = SmartScript::AcquireTargetList();
+            EXPECT_EQ(targets, lists[31 - i]);
+            pooled.insert(targets);
+        }
+
+        EXPECT_EQ(pooled, expected);
+
+        for (ObjectList* targets : pooled)
+            SmartScript::ReleaseTargetList(targets);
+    }).join();
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "AchievementMgr.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+    AchievementCriteriaEntry MakeCriteria(uint32 id, uint32 achievementId, AchievementCriteriaTypes type)
+    {
+        AchievementCriteriaEntry criteria = { };
+        criteria.ID = id;
+        criteria.referredAchievement = achievementId;
+        criteria.requiredType = type;
+        return criteria;
+    }
+
+    AchievementEntry MakeAchievement(uint32 id, uint32 flags, uint32 count)
+    {
+        AchievementEntry achievement = { };
+        achievement.ID = id;
+        achievement.flags = flags;
+        achievement.count = count;
+        return achievement;
+    }
+
+    std::vector<uint32> Ids(AchievementCriteriaEntryList const& criteria)
+    {
+        std::vector<uint32> ids;
+        for (AchievementCriteriaEntry const* entry : criteria)
+            ids.push_back(entry->ID);
+        return ids;
+    }
+
+    class AchievementActiveCriteriaTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            // achievement 1 has criteria 0 and 1, achievement 2 has criteria 2 and 3, of two types
+            _criteria = {
+                MakeCriteria(0, 1, ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL),
+                MakeCriteria(1, 1, ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT),
+                MakeCriteria(2, 2, ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL),
+                MakeCriteria(3, 2, ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT)
+            };
+
+            _levelCriteria = { &_criteria[0], &_criteria[2] };
+            _questCriteria = { &_criteria[1], &_criteria[3] };
+            _firstAchievementCriteria = { &_criteria[0], &_criteria[1] };
+
+            _active.Reset(_criteria.size());
+            _active.Fill(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL, _levelCriteria);
+            _active.Fill(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT, _questCriteria);
+        }
+
+        std::vector<AchievementCriteriaEntry> _criteria;
+        AchievementCriteriaEntryList _levelCriteria;
+        AchievementCriteriaEntryList _questCriteria;
+        AchievementCriteriaEntryList _firstAchievementCriteria;
+        AchievementActiveCriteria _active;
+    };
+}
+
+TEST_F(AchievementActiveCriteriaTest, BuildsListsPerType)
+{
+    EXPECT_TRUE(_active.HasToPrune());
+    _active.Prune();
+    EXPECT_FALSE(_active.HasToPrune());
+
+    EXPECT_EQ(Ids(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL)), std::vector<uint32>({ 0, 2 }));
+    EXPECT_EQ(Ids(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT)), std::vector<uint32>({ 1, 3 }));
+    EXPECT_TRUE(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE).empty());
+}
+
+TEST_F(AchievementActiveCriteriaTest, RetiredBeforeLoadAreNotListed)
+{
+    // completed achievements are retired before the lists are filled at login
+    _active.Reset(_criteria.size());
+    _active.Retire(_firstAchievementCriteria);
+    _active.Fill(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL, _levelCriteria);
+    _active.Fill(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT, _questCriteria);
+    _active.Prune();
+
+    EXPECT_EQ(Ids(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL)), std::vector<uint32>({ 2 }));
+    EXPECT_EQ(Ids(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT)), std::vector<uint32>({ 3 }));
+}
+
+TEST_F(AchievementActiveCriteriaTest, RetiredCriteriaStayListedUntilPruned)
+{
+    _active.Prune();
+
+    // an update iterating the lists completed the achievement
+    _active.Retire(_firstAchievementCriteria);
+    EXPECT_TRUE(_active.HasToPrune());
+    EXPECT_TRUE(_active.IsRetired(&_criteria[0]));
+    EXPECT_TRUE(_active.IsRetired(&_criteria[1]));
+    EXPECT_FALSE(_active.IsRetired(&_criteria[2]));
+    EXPECT_EQ(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL).size(), 2u);
+
+    _active.Prune();
+    EXPECT_FALSE(_active.HasToPrune());
+    EXPECT_EQ(Ids(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL)), std::vector<uint32>({ 2 }));
+    EXPECT_EQ(Ids(_active.GetByType(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT)), std::vector<uint32>({ 3 }));
+
+    // retiring again changes nothing
+    _active.Retire(_firstAchievementCriteria);
+    EXPECT_FALSE(_active.HasToPrune());
+}
+
+TEST_F(AchievementActiveCriteriaTest, UnknownCriteriaAreNeverRetired)
+{
+    AchievementCriteriaEntry unknown = MakeCriteria(uint32(_criteria.size()), 3, ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL);
+    _active.Prune();
+    _active.Retire({ &unknown });
+    EXPECT_FALSE(_active.IsRetired(&unknown));
+    EXPECT_FALSE(_active.HasToPrune());
+}
+
+TEST(AchievementActiveCriteria, OnlyAchievementsNeedingAllCriteriaRetireThem)
+{
+    AchievementEntry allOf = MakeAchievement(1, 0, 0);
+    AchievementEntry allOfCounted = MakeAchievement(2, 0, 4);
+    AchievementEntry someOf = MakeAchievement(3, 0, 3);
+    AchievementEntry summ = MakeAchievement(4, ACHIEVEMENT_FLAG_SUMM, 0);
+
+    EXPECT_TRUE(AchievementActiveCriteria::NeedsAllCriteria(&allOf, 4));
+    EXPECT_TRUE(AchievementActiveCriteria::NeedsAllCriteria(&allOfCounted, 4));
+    EXPECT_FALSE(AchievementActiveCriteria::NeedsAllCriteria(&someOf, 4));
+    EXPECT_FALSE(AchievementActiveCriteria::NeedsAllCriteria(&summ, 4));
+}
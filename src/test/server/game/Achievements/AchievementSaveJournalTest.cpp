@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "AchievementMgr.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+    struct Statements
+    {
+        std::vector<std::vector<uint32>> Batches;
+        std::vector<uint32> Rows;
+    };
+
+    Statements Split(std::vector<uint32> const& rows)
+    {
+        Statements statements;
+        AchievementSaveJournal::ForEachStatement(rows, [&](uint32 const* ids)
+        {
+            statements.Batches.emplace_back(ids, ids + ACHIEVEMENT_SAVE_BATCH_SIZE);
+        }, [&](uint32 id)
+        {
+            statements.Rows.push_back(id);
+        });
+        return statements;
+    }
+
+    std::vector<uint32> Range(uint32 first, uint32 count)
+    {
+        std::vector<uint32> ids;
+        for (uint32 i = 0; i < count; ++i)
+            ids.push_back(first + i);
+        return ids;
+    }
+}
+
+TEST(AchievementSaveJournalTest, CoalescesRepeatedChanges)
+{
+    AchievementSaveJournal journal;
+    // progress changed, removed and changed again before the save
+    journal.Add(40);
+    journal.Add(7);
+    journal.Add(40);
+    journal.Add(12);
+    journal.Add(7);
+    journal.Add(40);
+
+    EXPECT_EQ(journal.Take(), std::vector<uint32>({ 7, 12, 40 }));
+    EXPECT_TRUE(journal.Take().empty());
+
+    journal.Add(3);
+    journal.Clear();
+    EXPECT_TRUE(journal.Take().empty());
+}
+
+TEST(AchievementSaveJournalTest, WritesFullBatchesThenSingleRows)
+{
+    Statements none = Split({});
+    EXPECT_TRUE(none.Batches.empty());
+    EXPECT_TRUE(none.Rows.empty());
+
+    Statements fewer = Split(Range(1, ACHIEVEMENT_SAVE_BATCH_SIZE - 1));
+    EXPECT_TRUE(fewer.Batches.empty());
+    EXPECT_EQ(fewer.Rows, Range(1, ACHIEVEMENT_SAVE_BATCH_SIZE - 1));
+
+    Statements exact = Split(Range(1, ACHIEVEMENT_SAVE_BATCH_SIZE));
+    ASSERT_EQ(exact.Batches.size(), 1u);
+    EXPECT_EQ(exact.Batches[0], Range(1, ACHIEVEMENT_SAVE_BATCH_SIZE));
+    EXPECT_TRUE(exact.Rows.empty());
+
+    Statements more = Split(Range(1, ACHIEVEMENT_SAVE_BATCH_SIZE * 2 + 3));
+    ASSERT_EQ(more.Batches.size(), 2u);
+    EXPECT_EQ(more.Batches[0], Range(1, ACHIEVEMENT_SAVE_BATCH_SIZE));
+    EXPECT_EQ(more.Batches[1], Range(ACHIEVEMENT_SAVE_BATCH_SIZE + 1, ACHIEVEMENT_SAVE_BATCH_SIZE));
+    EXPECT_EQ(more.Rows, Range(ACHIEVEMENT_SAVE_BATCH_SIZE * 2 + 1, 3));
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "AuctionHouseMgr.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    std::vector<uint32> PopAllDue(AuctionExpiryWheel& wheel, time_t now)
+    {
+        std::vector<uint32> ids;
+        uint32 auctionId;
+        while (wheel.PopDue(now, auctionId))
+            ids.push_back(auctionId);
+
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+}
+
+TEST(AuctionExpiryWheelTest, NoAuctionEndsBeforeItsExpireTime)
+{
+    AuctionExpiryWheel wheel;
+    // all of them share the bucket of 1000 to 1009
+    wheel.Add(1, 1000);
+    wheel.Add(2, 1005);
+    wheel.Add(3, 1009);
+
+    for (time_t now = 990; now < 1010; ++now)
+        EXPECT_TRUE(PopAllDue(wheel, now).empty()) << "at " << now;
+
+    EXPECT_EQ(PopAllDue(wheel, 1010), std::vector<uint32>({ 1, 2, 3 }));
+    EXPECT_TRUE(PopAllDue(wheel, 1010).empty());
+}
+
+TEST(AuctionExpiryWheelTest, TakesOnlyDueBuckets)
+{
+    AuctionExpiryWheel wheel;
+    wheel.Add(1, 1009);
+    wheel.Add(2, 1010);
+    wheel.Add(3, 1019);
+    wheel.Add(4, 1020);
+    wheel.Add(5, 500);
+
+    // a late update takes every bucket that became due meanwhile
+    EXPECT_EQ(PopAllDue(wheel, 1010), std::vector<uint32>({ 1, 5 }));
+    EXPECT_EQ(PopAllDue(wheel, 1019), std::vector<uint32>());
+    EXPECT_EQ(PopAllDue(wheel, 1025), std::vector<uint32>({ 2, 3 }));
+    EXPECT_EQ(PopAllDue(wheel, 1030), std::vector<uint32>({ 4 }));
+}
+
+TEST(AuctionExpiryWheelTest, BudgetLeavesTheRestForLater)
+{
+    AuctionExpiryWheel wheel;
+    for (uint32 id = 1; id <= 5; ++id)
+        wheel.Add(id, 1000 + id * AUCTION_EXPIRY_BUCKET);
+
+    std::vector<uint32> ids;
+    uint32 auctionId;
+    for (uint32 i = 0; i < 2 && wheel.PopDue(2000, auctionId); ++i)
+        ids.push_back(auctionId);
+
+    // the oldest buckets go first
+    EXPECT_EQ(ids, std::vector<uint32>({ 1, 2 }));
+    EXPECT_EQ(PopAllDue(wheel, 2000), std::vector<uint32>({ 3, 4, 5 }));
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "AuctionHouseSearch.h"
+#include "ItemTemplate.h"
+#include "Timer.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace
+{
+    std::wstring const Materials[] = { L"linen", L"wool", L"silk", L"mageweave", L"runecloth", L"netherweave", L"frostweave", L"copper", L"bronze", L"iron",
+                                       L"mithril", L"thorium", L"adamantite", L"cobalt", L"saronite", L"titanium", L"eternium", L"felsteel", L"khorium", L"arcanite" };
+    std::wstring const Kinds[] = { L"cloth", L"bar", L"ore", L"bag", L"belt", L"boots", L"gloves", L"helm", L"shirt", L"bracers",
+                                   L"leggings", L"shoulders", L"robe", L"cloak", L"ring", L"dagger", L"sword", L"mace", L"staff", L"shield" };
+    std::wstring const Suffixes[] = { L"", L"", L"", L" of the monkey", L" of the eagle", L" of the bear", L" of the whale", L" of the owl" };
+
+    AuctionSearchEntry MakeEntry(uint32 id, std::mt19937& rng)
+    {
+        AuctionSearchEntry entry;
+        entry.AuctionId = id;
+        entry.Proto = nullptr;
+        entry.Info.AuctionId = id;
+        entry.ItemClass = rng() % 16;
+        entry.ItemSubClass = rng() % 20;
+        entry.InventoryType = rng() % 29;
+        entry.Quality = rng() % 6;
+        entry.RequiredLevel = rng() % 81;
+        entry.Name = Materials[rng() % 20] + L" " + Kinds[rng() % 20] + Suffixes[rng() % 8];
+        return entry;
+    }
+
+    // The former search, every auction checked against every filter
+    void LinearSearch(std::vector<AuctionSearchEntry> const& entries, AuctionSearchFilter const& filter, AuctionHouseSearchIndex::EntryList& result)
+    {
+        for (AuctionSearchEntry const& entry : entries)
+            if (AuctionHouseSearchIndex::Matches(entry, filter))
+                result.push_back(&entry);
+    }
+
+    std::vector<AuctionSearchFilter> MakeFilters()
+    {
+        std::vector<AuctionSearchFilter> filters(8);
+        filters[0].Name = L"saronite bar";
+        filters[1].Name = L"frostweave";
+        filters[2].ItemClass = 7;
+        filters[2].ItemSubClass = 5;
+        filters[3].InventoryType = INVTYPE_CHEST;
+        filters[4].LevelMin = 70;
+        filters[4].LevelMax = 80;
+        filters[4].Quality = 4;
+        filters[5].LevelMin = 10;
+        filters[6].Name = L"ak";
+        filters[6].ItemClass = 2;
+        filters[7].Name = L"of the";
+        filters[7].CheckName = false;
+        filters[7].Quality = 2;
+        return filters;
+    }
+}
+
+TEST(AuctionHouseSearchTest, SameResultsAsLinearSearch)
+{
+    std::mt19937 rng(3);
+    std::vector<AuctionSearchEntry> entries;
+    AuctionHouseSearchIndex index;
+    for (uint32 id = 1; id <= 5000; ++id)
+    {
+        entries.push_back(MakeEntry(id, rng));
+        index.Insert(entries.back());
+    }
+
+    // expired and cancelled auctions leave the index
+    for (uint32 id = 1; id <= 5000; id += 3)
+        index.Remove(id);
+
+    std::vector<AuctionSearchEntry> remaining;
+    for (AuctionSearchEntry const& entry : entries)
+        if (entry.AuctionId % 3 != 1)
+            remaining.push_back(entry);
+
+    EXPECT_EQ(index.GetSize(), remaining.size());
+
+    for (AuctionSearchFilter const& filter : MakeFilters())
+    {
+        AuctionHouseSearchIndex::EntryList expected, found;
+        LinearSearch(remaining, filter, expected);
+        index.Search(filter, found);
+
+        ASSERT_EQ(found.size(), expected.size());
+        for (std::size_t i = 0; i < found.size(); ++i)
+            EXPECT_EQ(found[i]->AuctionId, expected[i]->AuctionId);
+    }
+}
+
+TEST(AuctionHouseSearchTest, SnapshotsOnlyChangeOnPublish)
+{
+    std::mt19937 rng(5);
+    AuctionHouseSearchSnapshots snapshots;
+    for (uint32 id = 1; id <= 100; ++id)
+        snapshots.Insert(MakeEntry(id, rng));
+
+    EXPECT_EQ(snapshots.GetSnapshot()->GetSize(), 0u);
+
+    snapshots.Publish();
+    AuctionHouseSearchSnapshots::Snapshot first = snapshots.GetSnapshot();
+    EXPECT_EQ(first->GetSize(), 100u);
+
+    // a search still holds the first snapshot, it must not change under it
+    for (uint32 id = 1; id <= 10; ++id)
+        snapshots.Remove(id);
+    snapshots.Insert(MakeEntry(101, rng));
+    snapshots.Publish();
+
+    AuctionHouseSearchSnapshots::Snapshot second = snapshots.GetSnapshot();
+    EXPECT_EQ(first->GetSize(), 100u);
+    EXPECT_EQ(second->GetSize(), 91u);
+    EXPECT_EQ(second->GetEntries().front()->AuctionId, 11u);
+
+    // the first index is replayed once nobody reads it any more
+    first.reset();
+    second.reset();
+    snapshots.Insert(MakeEntry(102, rng));
+    snapshots.Publish();
+    EXPECT_EQ(snapshots.GetSnapshot()->GetSize(), 92u);
+
+    snapshots.Remove(102);
+    snapshots.Publish();
+    EXPECT_EQ(snapshots.GetSnapshot()->GetSize(), 91u);
+    EXPECT_EQ(snapshots.GetSnapshot()->GetEntries().back()->AuctionId, 101u);
+}
+
+TEST(AuctionHouseSearchTest, SearchesWhileAuctionsChange)
+{
+    std::mt19937 rng(7);
+    AuctionHouseSearchSnapshots snapshots;
+
+    // listing threads search and publish, each snapshot must stay as published during the search
+    std::atomic<bool> done(false);
+    std::atomic<uint32> wrong(0);
+    std::vector<std::thread> readers;
+    for (uint32 t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]()
+        {
+            while (!done)
+            {
+                snapshots.Publish();
+                AuctionHouseSearchSnapshots::Snapshot snapshot = snapshots.GetSnapshot();
+                uint32 size = snapshot->GetSize();
+                AuctionHouseSearchIndex::EntryList const& entries = snapshot->GetEntries();
+                for (std::size_t i = 1; i < entries.size(); ++i)
+                    if (entries[i - 1]->AuctionId >= entries[i]->AuctionId)
+                        ++wrong;
+                if (entries.size() != size || snapshot->GetSize() != size)
+                    ++wrong;
+            }
+        });
+    }
+
+    // the world thread creates and ends auctions, its update publishes as well
+    for (uint32 id = 1; id <= 20000; ++id)
+    {
+        snapshots.Insert(MakeEntry(id, rng));
+        if (id % 3 == 0)
+            snapshots.Remove(id - 1);
+        if (id % 100 == 0)
+            snapshots.Publish();
+    }
+
+    done = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(wrong, 0u);
+
+    snapshots.Publish();
+    EXPECT_EQ(snapshots.GetSnapshot()->GetSize(), 20000u - 20000u / 3);
+}
+
+// Run it with --gtest_also_run_disabled_tests
+TEST(AuctionHouseSearchTest, DISABLED_SearchBenchmark)
+{
+    constexpr uint32 AUCTION_COUNT = 60000;
+    constexpr uint32 ROUNDS = 50;
+
+    std::mt19937 rng(9);
+    std::vector<AuctionSearchEntry> entries;
+    entries.reserve(AUCTION_COUNT);
+    AuctionHouseSearchIndex index;
+    for (uint32 id = 1; id <= AUCTION_COUNT; ++id)
+    {
+        entries.push_back(MakeEntry(id, rng));
+        index.Insert(entries.back());
+    }
+
+    std::vector<AuctionSearchFilter> filters = MakeFilters();
+    AuctionHouseSearchIndex::EntryList result;
+
+    uint32 linearStart = getMSTime();
+    std::size_t linearCount = 0;
+    for (uint32 round = 0; round < ROUNDS; ++round)
+    {
+        for (AuctionSearchFilter const& filter : filters)
+        {
+            result.clear();
+            LinearSearch(entries, filter, result);
+            linearCount += result.size();
+        }
+    }
+    uint32 linearTime = GetMSTimeDiffToNow(linearStart);
+
+    uint32 indexStart = getMSTime();
+    std::size_t indexCount = 0;
+    for (uint32 round = 0; round < ROUNDS; ++round)
+    {
+        for (AuctionSearchFilter const& filter : filters)
+        {
+            result.clear();
+            index.Search(filter, result);
+            indexCount += result.size();
+        }
+    }
+    uint32 indexTime = GetMSTimeDiffToNow(indexStart);
+
+    EXPECT_EQ(linearCount, indexCount);
+
+    std::cout << "[ BENCHMARK ] " << ROUNDS * filters.size() << " searches over " << AUCTION_COUNT << " auctions: "
+        << "linear scan " << linearTime << " ms, indexed " << indexTime << " ms" << std::endl;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "BattlegroundQueue.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+
+namespace
+{
+    typedef BattlegroundQueue::ArenaTeamsByMMR ArenaTeamsByMMR;
+
+    uint32 const Now = 60 * MINUTE * IN_MILLISECONDS;
+    uint32 const DiscardTime = 3 * MINUTE * IN_MILLISECONDS;
+    uint32 const MaxCountedMMR = 2500;
+
+    struct TestArenaQueue
+    {
+        std::vector<std::unique_ptr<GroupQueueInfo>> Teams;
+        ArenaTeamsByMMR ByMMR;
+
+        GroupQueueInfo* Add(uint32 arenaTeamId, uint32 mmr, uint32 waitTime = 0)
+        {
+            Teams.push_back(std::make_unique<GroupQueueInfo>());
+            GroupQueueInfo* ginfo = Teams.back().get();
+            ginfo->ArenaTeamId = arenaTeamId;
+            ginfo->ArenaMatchmakerRating = mmr;
+            ginfo->JoinTime = Now - waitTime;
+            ByMMR.insert(ArenaTeamsByMMR::value_type(mmr, ginfo));
+            return ginfo;
+        }
+
+        GroupQueueInfo* Find(GroupQueueInfo const* team, uint32 maxDefaultRatingDifference = 200) const
+        {
+            return BattlegroundQueue::FindArenaOpponent(team, ByMMR, maxDefaultRatingDifference, Now, DiscardTime);
+        }
+    };
+
+    uint32 MMRDiff(GroupQueueInfo const* team, GroupQueueInfo const* oponent)
+    {
+        uint32 MMR1 = std::min(team->ArenaMatchmakerRating, MaxCountedMMR);
+        uint32 MMR2 = std::min(oponent->ArenaMatchmakerRating, MaxCountedMMR);
+        return MMR2 >= MMR1 ? MMR2 - MMR1 : MMR1 - MMR2;
+    }
+
+    // looks at every waiting team: after 20 minutes the closest one, then the closest 2000+ team
+    // that waited twice the discard time, then the closest one within the allowed difference
+    GroupQueueInfo const* ScanForOpponent(TestArenaQueue const& queue, GroupQueueInfo const* team, uint32 maxDefaultRatingDifference)
+    {
+        GroupQueueInfo const* best[3] = { nullptr, nullptr, nullptr };
+        uint32 waitTime = Now - team->JoinTime;
+
+        for (auto const& oponent : queue.Teams)
+        {
+            if (oponent->ArenaTeamId == team->ArenaTeamId)
+                continue;
+
+            uint32 oponentWaitTime = Now - oponent->JoinTime;
+            uint32 shorterWaitTime = std::min(waitTime, oponentWaitTime);
+            uint32 longerWaitTime = std::max(waitTime, oponentWaitTime);
+            uint32 maxAllowedDiff = maxDefaultRatingDifference + (longerWaitTime >= DiscardTime ? 150 : 0) + shorterWaitTime / 600;
+            uint32 diff = MMRDiff(team, oponent.get());
+
+            uint8 level;
+            if (waitTime >= 20 * MINUTE * IN_MILLISECONDS)
+                level = 0;
+            else if (std::min(team->ArenaMatchmakerRating, MaxCountedMMR) >= 2000 && std::min(oponent->ArenaMatchmakerRating, MaxCountedMMR) >= 2000 && longerWaitTime >= 2 * DiscardTime)
+                level = 1;
+            else if (diff <= maxAllowedDiff)
+                level = 2;
+            else
+                continue;
+
+            if (!best[level] || diff < MMRDiff(team, best[level]))
+                best[level] = oponent.get();
+        }
+
+        for (GroupQueueInfo const* oponent : best)
+            if (oponent)
+                return oponent;
+        return nullptr;
+    }
+}
+
+TEST(BattlegroundArenaOpponentTest, SkipsItsOwnTeam)
+{
+    TestArenaQueue queue;
+    GroupQueueInfo* team = queue.Add(1, 1500);
+    queue.Add(1, 1500);
+    GroupQueueInfo* oponent = queue.Add(2, 1600);
+
+    EXPECT_EQ(queue.Find(team), oponent);
+
+    TestArenaQueue alone;
+    GroupQueueInfo* lonely = alone.Add(1, 1500, 30 * MINUTE * IN_MILLISECONDS);
+    alone.Add(1, 1500);
+    EXPECT_EQ(alone.Find(lonely), nullptr);
+}
+
+TEST(BattlegroundArenaOpponentTest, DefaultWindow)
+{
+    TestArenaQueue queue;
+    GroupQueueInfo* team = queue.Add(1, 1500);
+    GroupQueueInfo* above = queue.Add(2, 1700);
+    queue.Add(3, 1201);
+
+    EXPECT_EQ(queue.Find(team), above);
+
+    TestArenaQueue tooFar;
+    GroupQueueInfo* other = tooFar.Add(1, 1500);
+    tooFar.Add(2, 1250);
+    GroupQueueInfo* closest = tooFar.Add(3, 1701);
+
+    EXPECT_EQ(tooFar.Find(other), nullptr);
+    EXPECT_EQ(tooFar.Find(other, 300), closest);
+}
+
+TEST(BattlegroundArenaOpponentTest, WidensOverTime)
+{
+    TestArenaQueue queue;
+    GroupQueueInfo* team = queue.Add(1, 1500);
+    GroupQueueInfo* oponent = queue.Add(2, 1850);
+
+    EXPECT_EQ(queue.Find(team), nullptr);
+
+    // 150 more once the longer waiting team waited the discard time
+    oponent->JoinTime = Now - DiscardTime;
+    EXPECT_EQ(queue.Find(team), oponent);
+
+    // and 100 more for each minute the shorter waiting team waited
+    oponent->JoinTime = Now;
+    team->JoinTime = Now - 1 * MINUTE * IN_MILLISECONDS;
+    EXPECT_EQ(queue.Find(team), nullptr);
+    team->JoinTime = Now - 2 * MINUTE * IN_MILLISECONDS;
+    EXPECT_EQ(queue.Find(team), nullptr);
+    oponent->JoinTime = Now - 90 * IN_MILLISECONDS;
+    EXPECT_EQ(queue.Find(team), oponent);
+}
+
+TEST(BattlegroundArenaOpponentTest, HighRatedTeamsAfterTwiceTheDiscardTime)
+{
+    TestArenaQueue queue;
+    GroupQueueInfo* team = queue.Add(1, 2000);
+    GroupQueueInfo* oponent = queue.Add(2, 2600, 2 * DiscardTime - 1);
+
+    EXPECT_EQ(queue.Find(team), nullptr);
+
+    oponent->JoinTime = Now - 2 * DiscardTime;
+    EXPECT_EQ(queue.Find(team), oponent);
+
+    // a team below 2000 does not get paired that way
+    GroupQueueInfo* lower = queue.Add(3, 1999);
+    EXPECT_EQ(queue.Find(lower), team);
+    queue.ByMMR.erase(queue.ByMMR.find(2000));
+    EXPECT_EQ(queue.Find(lower), nullptr);
+
+    // it is preferred over a closer team in the allowed difference
+    TestArenaQueue preferred;
+    GroupQueueInfo* high = preferred.Add(1, 2100);
+    preferred.Add(2, 2050);
+    preferred.Add(3, 1950);
+    GroupQueueInfo* waiting = preferred.Add(4, 2450, 2 * DiscardTime);
+    EXPECT_EQ(preferred.Find(high), waiting);
+}
+
+TEST(BattlegroundArenaOpponentTest, ClosestAfterTwentyMinutes)
+{
+    TestArenaQueue queue;
+    GroupQueueInfo* team = queue.Add(1, 1500, 20 * MINUTE * IN_MILLISECONDS - 1);
+    queue.Add(1, 1510);
+    queue.Add(2, 500);
+    GroupQueueInfo* closest = queue.Add(3, 2400);
+
+    EXPECT_EQ(queue.Find(team), nullptr);
+
+    team->JoinTime = Now - 20 * MINUTE * IN_MILLISECONDS;
+    EXPECT_EQ(queue.Find(team), closest);
+}
+
+TEST(BattlegroundArenaOpponentTest, FindsWhatAFullScanFinds)
+{
+    std::mt19937 rng(45);
+    for (uint32 round = 0; round < 2000; ++round)
+    {
+        TestArenaQueue queue;
+        uint32 count = 1 + rng() % 40;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            // crowd around 2000 so the high rated rules and the early exits meet often
+            uint32 mmr = rng() % 4 ? 1700 + rng() % 700 : rng() % 3000;
+            queue.Add(1 + rng() % 30, mmr, rng() % (25 * MINUTE * IN_MILLISECONDS));
+        }
+
+        uint32 maxDefaultRatingDifference = rng() % 2 ? 300 : 200;
+        for (auto const& team : queue.Teams)
+        {
+            GroupQueueInfo const* found = queue.Find(team.get(), maxDefaultRatingDifference);
+            GroupQueueInfo const* expected = ScanForOpponent(queue, team.get(), maxDefaultRatingDifference);
+
+            ASSERT_EQ(found == nullptr, expected == nullptr) << "round " << round;
+            if (!found)
+                continue;
+
+            EXPECT_NE(found->ArenaTeamId, team->ArenaTeamId);
+            // teams as far away on both sides may be picked either way
+            EXPECT_EQ(MMRDiff(team.get(), found), MMRDiff(team.get(), expected)) << "round " << round;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "BattlegroundQueue.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+
+namespace
+{
+    typedef BattlegroundQueue::QueuedGroups QueuedGroups;
+    typedef BattlegroundQueue::SelectionPool SelectionPool;
+    typedef BattlegroundQueue::GroupsQueueType GroupsQueueType;
+
+    struct TestQueue
+    {
+        std::vector<std::unique_ptr<GroupQueueInfo>> Groups;
+        GroupsQueueType List;                               // the list the queue used to keep
+        QueuedGroups Indexed;
+
+        ~TestQueue()
+        {
+            // groups are owned here
+            for (auto& ginfo : Groups)
+                Indexed.Remove(ginfo.get());
+        }
+
+        GroupQueueInfo* Add(uint32 size, bool invited, bool front = false)
+        {
+            Groups.push_back(std::make_unique<GroupQueueInfo>());
+            GroupQueueInfo* ginfo = Groups.back().get();
+            for (uint32 i = 0; i < size; ++i)
+                ginfo->Players.insert(Groups.size() * 100 + i);
+            ginfo->IsInvitedToBGInstanceGUID = 0;
+
+            if (front)
+                List.push_front(ginfo);
+            else
+                List.push_back(ginfo);
+            Indexed.Add(ginfo, front);
+
+            if (invited)
+            {
+                ginfo->IsInvitedToBGInstanceGUID = 1;
+                Indexed.SetInvited(ginfo);
+            }
+            return ginfo;
+        }
+    };
+
+    void FillTestQueue(TestQueue& queue, uint32 count, std::mt19937& rng)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            // mostly solo players, some parties and invited groups waiting to enter
+            uint32 roll = rng() % 10;
+            uint32 size = roll < 6 ? 1 : 2 + rng() % 4;
+            queue.Add(size, rng() % 4 == 0, rng() % 20 == 0);
+        }
+    }
+
+    // the selection loop BattlegroundQueue::FillPlayersToBG used on the lists
+    GroupsQueueType::const_iterator LegacyFill(SelectionPool& pool, GroupsQueueType const& groups, GroupsQueueType::const_iterator itr, uint32 desiredCount)
+    {
+        for (; itr != groups.end() && pool.AddGroup((*itr), desiredCount); ++itr);
+        return itr;
+    }
+}
+
+TEST(BattlegroundQueueGroupsTest, SelectsLikeTheQueueList)
+{
+    std::mt19937 rng(5);
+    for (uint32 round = 0; round < 200; ++round)
+    {
+        TestQueue queue;
+        FillTestQueue(queue, 1 + rng() % 60, rng);
+
+        // players leaving their groups
+        for (uint32 i = 0; i < 5; ++i)
+        {
+            GroupQueueInfo* ginfo = queue.Groups[rng() % queue.Groups.size()].get();
+            if (ginfo->Players.size() > 1)
+            {
+                ginfo->Players.erase(ginfo->Players.begin());
+                queue.Indexed.UpdateSize(ginfo);
+            }
+        }
+
+        uint32 desired = 1 + rng() % 15;
+        uint32 refill = rng() % 15;
+
+        SelectionPool legacy, indexed;
+        GroupsQueueType::const_iterator itr = LegacyFill(legacy, queue.List, queue.List.begin(), desired);
+        int64 order = indexed.AddGroups(queue.Indexed, QueuedGroups::ORDER_BEGIN, desired);
+        EXPECT_EQ(legacy.SelectedGroups, indexed.SelectedGroups);
+
+        // kick and continue the selection from where it stopped, like the team balancing does
+        legacy.KickGroup(2);
+        indexed.KickGroup(2);
+        LegacyFill(legacy, queue.List, itr, refill);
+        indexed.AddGroups(queue.Indexed, order, refill);
+        EXPECT_EQ(legacy.SelectedGroups, indexed.SelectedGroups);
+
+        uint32 waitingPlayers = 0;
+        for (GroupQueueInfo* ginfo : queue.List)
+            if (!ginfo->IsInvitedToBGInstanceGUID)
+                waitingPlayers += ginfo->Players.size();
+        EXPECT_EQ(queue.Indexed.GetWaitingPlayersCount(), waitingPlayers);
+    }
+}
+
+TEST(BattlegroundQueueGroupsTest, KeepsQueueOrder)
+{
+    TestQueue queue;
+    GroupQueueInfo* first = queue.Add(3, false);
+    GroupQueueInfo* second = queue.Add(1, false);
+    GroupQueueInfo* front = queue.Add(2, false, true);
+
+    EXPECT_EQ(queue.Indexed.GetNextWaiting(QueuedGroups::ORDER_BEGIN, 1, 5), front);
+    EXPECT_EQ(queue.Indexed.GetNextWaiting(QueuedGroups::ORDER_BEGIN, 3, 5), first);
+    EXPECT_EQ(queue.Indexed.GetNextWaiting(first->_queueOrder + 1, 1, 5), second);
+
+    // a group that gets smaller keeps its place
+    first->Players.erase(first->Players.begin());
+    first->Players.erase(first->Players.begin());
+    queue.Indexed.UpdateSize(first);
+    EXPECT_EQ(queue.Indexed.GetNextWaiting(front->_queueOrder + 1, 1, 1), first);
+
+    GroupsQueueType waiting;
+    queue.Indexed.GetWaitingGroups(waiting);
+    EXPECT_EQ(waiting, GroupsQueueType({ front, first, second }));
+
+    front->IsInvitedToBGInstanceGUID = 1;
+    queue.Indexed.SetInvited(front);
+    EXPECT_EQ(queue.Indexed.GetNextWaiting(QueuedGroups::ORDER_BEGIN, 1, 5), first);
+    EXPECT_EQ(queue.Indexed.GetWaitingPlayersCount(), 2u);
+    EXPECT_FALSE(queue.Indexed.IsEmpty());
+}
+
+TEST(BattlegroundQueueGroupsTest, SelectsFromLongQueue)
+{
+    // parties waiting in front of a few solo players
+    std::mt19937 rng(9);
+    TestQueue queue;
+    for (uint32 i = 0; i < 3000; ++i)
+        queue.Add(i % 1000 == 999 ? 1 : 2 + rng() % 4, rng() % 4 == 0);
+
+    // a running battleground with one or two free slots, most waiting groups do not fit
+    for (uint32 freeSlots = 1; freeSlots <= 2; ++freeSlots)
+    {
+        SelectionPool legacy, indexed;
+        LegacyFill(legacy, queue.List, queue.List.begin(), freeSlots);
+        indexed.AddGroups(queue.Indexed, QueuedGroups::ORDER_BEGIN, freeSlots);
+        EXPECT_EQ(legacy.SelectedGroups, indexed.SelectedGroups);
+        EXPECT_EQ(legacy.GetPlayerCount(), indexed.GetPlayerCount());
+    }
+}
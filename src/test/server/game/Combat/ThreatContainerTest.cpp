@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "Creature.h"
+#include "ThreatManager.h"
+#include "Timer.h"
+#include "WorldMock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+    // A creature with values and a guid, enough to be the owner or a target of a hostile reference
+    class TestCreature : public Creature
+    {
+    public:
+        explicit TestCreature(uint32 guidLow)
+        {
+            Object::_Create(guidLow, 1, HIGHGUID_UNIT);
+        }
+    };
+}
+
+// ThreatContainer::update() is private, the fixture is its friend
+class ThreatContainerTest : public Test
+{
+protected:
+    void SetUp() override
+    {
+        sWorld.reset(new NiceMock<WorldMock>());
+
+        _owner = std::make_unique<TestCreature>(1);
+        for (uint32 i = 0; i < 60; ++i)                     // 25 players, their pets and a few totems
+            _victims.push_back(std::make_unique<TestCreature>(100 + i));
+    }
+
+    void TearDown() override
+    {
+        // the references are unlinked from the victims, so the owner goes first
+        _owner.reset();
+        _victims.clear();
+        sWorld.reset();
+    }
+
+    ThreatManager& GetThreatManager() { return _owner->getThreatManager(); }
+
+    void UpdateThreatList() { GetThreatManager().getOnlineContainer().update(); }
+
+    std::vector<uint64> GetThreatListGuids()
+    {
+        std::vector<uint64> guids;
+        for (HostileReference const* ref : GetThreatManager().getThreatList())
+            guids.push_back(ref->getUnitGuid());
+        return guids;
+    }
+
+    // the order the former full stable sort produced from the current order
+    std::vector<uint64> GetStableSortedGuids()
+    {
+        ThreatContainer::StorageType list = GetThreatManager().getThreatList();
+        std::stable_sort(list.begin(), list.end(), acore::ThreatOrderPred());
+
+        std::vector<uint64> guids;
+        for (HostileReference const* ref : list)
+            guids.push_back(ref->getUnitGuid());
+        return guids;
+    }
+
+    std::unique_ptr<TestCreature> _owner;
+    std::vector<std::unique_ptr<TestCreature>> _victims;
+};
+
+TEST_F(ThreatContainerTest, MostHatedFirstAfterUpdate)
+{
+    ThreatManager& manager = GetThreatManager();
+    manager.doAddThreat(_victims[0].get(), 100.0f);
+    manager.doAddThreat(_victims[1].get(), 300.0f);
+    manager.doAddThreat(_victims[2].get(), 200.0f);
+
+    UpdateThreatList();
+
+    EXPECT_EQ(GetThreatListGuids(), std::vector<uint64>({ _victims[1]->GetGUID(), _victims[2]->GetGUID(), _victims[0]->GetGUID() }));
+    EXPECT_EQ(manager.getOnlineContainer().getMostHated()->getUnitGuid(), _victims[1]->GetGUID());
+    EXPECT_FALSE(manager.getOnlineContainer().isDirty());
+
+    // the tank loses the first place
+    manager.doAddThreat(_victims[0].get(), 250.0f);
+    UpdateThreatList();
+
+    EXPECT_EQ(GetThreatListGuids(), std::vector<uint64>({ _victims[0]->GetGUID(), _victims[1]->GetGUID(), _victims[2]->GetGUID() }));
+}
+
+TEST_F(ThreatContainerTest, EqualThreatKeepsListOrder)
+{
+    ThreatManager& manager = GetThreatManager();
+    manager.doAddThreat(_victims[0].get(), 10.0f);
+    manager.doAddThreat(_victims[1].get(), 20.0f);
+    manager.doAddThreat(_victims[2].get(), 10.0f);
+    manager.doAddThreat(_victims[3].get(), 20.0f);
+    manager.doAddThreat(_victims[4].get(), 5.0f);
+
+    UpdateThreatList();
+
+    EXPECT_EQ(GetThreatListGuids(), std::vector<uint64>({ _victims[1]->GetGUID(), _victims[3]->GetGUID(), _victims[0]->GetGUID(), _victims[2]->GetGUID(), _victims[4]->GetGUID() }));
+}
+
+TEST_F(ThreatContainerTest, UpdateMatchesStableSort)
+{
+    ThreatManager& manager = GetThreatManager();
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> initialThreat(1.0f, 100000.0f);
+    for (std::unique_ptr<TestCreature> const& victim : _victims)
+        manager.doAddThreat(victim.get(), initialThreat(rng));
+    UpdateThreatList();
+
+    std::uniform_int_distribution<size_t> who(0, _victims.size() - 1);
+    std::uniform_real_distribution<float> amount(0.0f, 3000.0f);
+    for (uint32 tick = 0; tick < 500; ++tick)
+    {
+        // a few changes reorder incrementally, many changes fall back to the full sort
+        uint32 changes = tick % 10 ? 4 : 40;
+        for (uint32 i = 0; i < changes; ++i)
+            manager.doAddThreat(_victims[who(rng)].get(), amount(rng));
+
+        std::vector<uint64> expected = GetStableSortedGuids();
+        UpdateThreatList();
+
+        ASSERT_EQ(GetThreatListGuids(), expected);
+    }
+}
+
+/*
+ * A 25-man raid with pets and totems: every tick a few players change their threat and the list is reordered.
+ * Compares ThreatContainer::update() with sorting the former std::list storage each tick.
+ * Run it with --gtest_also_run_disabled_tests.
+ */
+TEST_F(ThreatContainerTest, DISABLED_RaidEncounterBenchmark)
+{
+    constexpr uint32 TICKS = 200000;
+
+    ThreatManager& manager = GetThreatManager();
+    std::mt19937 rng(26);
+    std::uniform_real_distribution<float> initialThreat(1.0f, 100000.0f);
+    for (std::unique_ptr<TestCreature> const& victim : _victims)
+        manager.doAddThreat(victim.get(), initialThreat(rng));
+    UpdateThreatList();
+
+    std::uniform_int_distribution<size_t> who(0, _victims.size() - 1);
+    std::uniform_real_distribution<float> amount(0.0f, 3000.0f);
+    auto addRandomThreat = [&](std::mt19937& tickRng)
+    {
+        for (uint32 i = 0; i < 4; ++i)
+            manager.doAddThreat(_victims[who(tickRng)].get(), amount(tickRng));
+    };
+
+    std::mt19937 vectorRng(1);
+    uint64 vectorChecksum = 0;
+    uint32 vectorStart = getMSTime();
+    for (uint32 tick = 0; tick < TICKS; ++tick)
+    {
+        addRandomThreat(vectorRng);
+        UpdateThreatList();
+        vectorChecksum += manager.getOnlineContainer().getMostHated()->getUnitGuid();
+    }
+    uint32 vectorTime = GetMSTimeDiffToNow(vectorStart);
+
+    ThreatContainer::StorageType const& threatList = manager.getThreatList();
+    std::list<HostileReference*> list(threatList.begin(), threatList.end());
+    std::mt19937 listRng(1);
+    uint64 listChecksum = 0;
+    uint32 listStart = getMSTime();
+    for (uint32 tick = 0; tick < TICKS; ++tick)
+    {
+        addRandomThreat(listRng);
+        list.sort(acore::ThreatOrderPred());
+        listChecksum += list.front()->getUnitGuid();
+    }
+    uint32 listTime = GetMSTimeDiffToNow(listStart);
+
+    EXPECT_GT(vectorChecksum, 0u);
+    EXPECT_GT(listChecksum, 0u);
+
+    std::cout << "[ BENCHMARK ] " << TICKS << " updates of " << _victims.size() << " references: "
+        << "std::list sort " << listTime << " ms, incremental vector " << vectorTime << " ms" << std::endl;
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "ConditionMgr.h"
+#include "Creature.h"
+#include "World.h"
+#include "WorldMock.h"
+#include "gtest/gtest.h"
+#include <deque>
+#include <memory>
+#include <random>
+
+using namespace testing;
+
+namespace
+{
+    constexpr uint32 WORLD_STATE_COUNT = 8;
+    constexpr uint32 MISSING_REFERENCE = 99;
+
+    class TestCreature : public Creature
+    {
+    public:
+        TestCreature()
+        {
+            Object::_Create(1, 1, HIGHGUID_UNIT);
+        }
+    };
+
+    // The list walk the programs replaced: every group is checked in list order, the list passes when one group passed
+    bool WalkConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions, ConditionReferenceContainer const& references)
+    {
+        std::map<uint32, bool> elseGroupStore;
+        for (Condition* condition : conditions)
+        {
+            if (!condition->isLoaded())
+                continue;
+
+            auto itr = elseGroupStore.find(condition->ElseGroup);
+            if (itr == elseGroupStore.end())
+                elseGroupStore[condition->ElseGroup] = true;
+            else if (!itr->second)
+                continue;
+
+            if (condition->ReferenceId)
+            {
+                auto ref = references.find(condition->ReferenceId);
+                if (ref != references.end() && !WalkConditionList(sourceInfo, ref->second, references))
+                    elseGroupStore[condition->ElseGroup] = false;
+            }
+            else if (!condition->Meets(sourceInfo))
+                elseGroupStore[condition->ElseGroup] = false;
+        }
+
+        for (auto const& group : elseGroupStore)
+            if (group.second)
+                return true;
+
+        return false;
+    }
+
+    class ConditionProgramTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            WorldMock* world = new NiceMock<WorldMock>();
+            ON_CALL(*world, getWorldState(_)).WillByDefault(Invoke([this](uint32 index) -> uint64 { return _worldStates[index]; }));
+            sWorld.reset(world);
+
+            _target = std::make_unique<TestCreature>();
+        }
+
+        void TearDown() override
+        {
+            _target.reset();
+            sWorld.reset();
+        }
+
+        // Met while the world state is set
+        Condition* AddWorldState(ConditionList& list, uint32 index, uint32 elseGroup, bool negative = false)
+        {
+            Condition& condition = _conditions.emplace_back();
+            condition.ConditionType = CONDITION_WORLD_STATE;
+            condition.ConditionValue1 = index;
+            condition.ConditionValue2 = 1;
+            condition.ElseGroup = elseGroup;
+            condition.NegativeCondition = negative;
+            list.push_back(&condition);
+            return &condition;
+        }
+
+        Condition* AddReference(ConditionList& list, uint32 referenceId, uint32 elseGroup)
+        {
+            Condition& condition = _conditions.emplace_back();
+            condition.ReferenceId = referenceId;
+            condition.ElseGroup = elseGroup;
+            list.push_back(&condition);
+            return &condition;
+        }
+
+        // Compiles the reference templates like ConditionMgr does, the programs are created before any of them is compiled
+        void CompileReferences()
+        {
+            for (auto const& ref : _references)
+                _compiledLists[&ref.second];
+            for (auto const& ref : _references)
+                _compiledLists[&ref.second].Compile(ref.second, _references, _compiledLists);
+        }
+
+        void SetWorldStates(uint32 mask)
+        {
+            for (uint32 i = 0; i < WORLD_STATE_COUNT; ++i)
+                _worldStates[i] = (mask >> i) & 1;
+        }
+
+        bool Run(ConditionList const& conditions, Condition** lastFailed = nullptr)
+        {
+            ConditionProgram program;
+            program.Compile(conditions, _references, _compiledLists);
+
+            ConditionSourceInfo sourceInfo(_target.get());
+            bool meets = program.Run(sourceInfo);
+            if (lastFailed)
+                *lastFailed = sourceInfo.mLastFailedCondition;
+            return meets;
+        }
+
+        // Every world state combination gives the result of the list walk, and the same failed condition when the list fails
+        void ExpectSameAsWalk(ConditionList const& conditions)
+        {
+            for (uint32 mask = 0; mask < (1 << WORLD_STATE_COUNT); ++mask)
+            {
+                SetWorldStates(mask);
+
+                ConditionSourceInfo walkInfo(_target.get());
+                bool walked = WalkConditionList(walkInfo, conditions, _references);
+
+                Condition* lastFailed = nullptr;
+                ASSERT_EQ(Run(conditions, &lastFailed), walked) << "world states " << mask;
+                if (!walked)
+                    ASSERT_EQ(lastFailed, walkInfo.mLastFailedCondition) << "world states " << mask;
+            }
+        }
+
+        std::deque<Condition> _conditions;
+        ConditionReferenceContainer _references;
+        ConditionProgramContainer _compiledLists;
+        uint64 _worldStates[WORLD_STATE_COUNT] = { };
+        std::unique_ptr<TestCreature> _target;
+    };
+}
+
+TEST_F(ConditionProgramTest, ElseGroups)
+{
+    // (0 and 1) or 2, the groups are interleaved in the list
+    ConditionList conditions;
+    AddWorldState(conditions, 0, 1);
+    Condition* second = AddWorldState(conditions, 2, 2);
+    Condition* third = AddWorldState(conditions, 1, 1);
+
+    SetWorldStates(0b011);
+    EXPECT_TRUE(Run(conditions));
+    SetWorldStates(0b100);
+    EXPECT_TRUE(Run(conditions));
+
+    // the failed condition is the last one checked in list order, with 0 failed 1 is not checked anymore
+    Condition* lastFailed = nullptr;
+    SetWorldStates(0b001);
+    EXPECT_FALSE(Run(conditions, &lastFailed));
+    EXPECT_EQ(lastFailed, third);
+    SetWorldStates(0b010);
+    EXPECT_FALSE(Run(conditions, &lastFailed));
+    EXPECT_EQ(lastFailed, second);
+
+    ExpectSameAsWalk(conditions);
+}
+
+TEST_F(ConditionProgramTest, NegativeConditions)
+{
+    // 0 and not 1
+    ConditionList conditions;
+    AddWorldState(conditions, 0, 0);
+    Condition* negative = AddWorldState(conditions, 1, 0, true);
+
+    SetWorldStates(0b01);
+    EXPECT_TRUE(Run(conditions));
+
+    Condition* lastFailed = nullptr;
+    SetWorldStates(0b11);
+    EXPECT_FALSE(Run(conditions, &lastFailed));
+    EXPECT_EQ(lastFailed, negative);
+
+    ExpectSameAsWalk(conditions);
+}
+
+TEST_F(ConditionProgramTest, ReferenceTemplates)
+{
+    // template 1: 0 or not 1, template 2: template 1 and 2
+    AddWorldState(_references[1], 0, 0);
+    AddWorldState(_references[1], 1, 1, true);
+    AddReference(_references[2], 1, 0);
+    AddWorldState(_references[2], 2, 0);
+    CompileReferences();
+
+    // template 2 or 3, a missing template is met
+    ConditionList conditions;
+    AddReference(conditions, 2, 0);
+    AddWorldState(conditions, 3, 1);
+    AddReference(conditions, MISSING_REFERENCE, 1);
+
+    SetWorldStates(0b0100);
+    EXPECT_TRUE(Run(conditions));
+    SetWorldStates(0b0110);
+    EXPECT_FALSE(Run(conditions));
+    SetWorldStates(0b1010);
+    EXPECT_TRUE(Run(conditions));
+
+    ExpectSameAsWalk(conditions);
+}
+
+TEST_F(ConditionProgramTest, RandomListsMatchWalk)
+{
+    std::mt19937 rng(35);
+
+    auto addRandom = [&](ConditionList& list, uint32 maxReference)
+    {
+        uint32 elseGroup = rng() % 4;
+        switch (rng() % 8)
+        {
+            case 0:
+                if (maxReference)
+                {
+                    AddReference(list, 1 + rng() % maxReference, elseGroup);
+                    break;
+                }
+                [[fallthrough]];
+            case 1:
+                AddReference(list, MISSING_REFERENCE, elseGroup);
+                break;
+            case 2:
+                list.push_back(&_conditions.emplace_back()); // not loaded, skipped
+                break;
+            default:
+                AddWorldState(list, rng() % WORLD_STATE_COUNT, elseGroup, rng() % 3 == 0);
+                break;
+        }
+    };
+
+    // templates only reference the ones before them
+    for (uint32 id = 1; id <= 6; ++id)
+        for (uint32 i = 1 + rng() % 4; i > 0; --i)
+            addRandom(_references[id], id - 1);
+    CompileReferences();
+
+    for (uint32 list = 0; list < 200; ++list)
+    {
+        ConditionList conditions;
+        for (uint32 i = 1 + rng() % 8; i > 0; --i)
+            addRandom(conditions, 6);
+
+        ExpectSameAsWalk(conditions);
+    }
+}
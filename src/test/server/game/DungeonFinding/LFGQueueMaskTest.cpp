@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "LFGQueue.h"
+#include "Timer.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+using namespace lfg;
+
+namespace
+{
+    uint8 const RoleChoices[] = { PLAYER_ROLE_DAMAGE, PLAYER_ROLE_DAMAGE, PLAYER_ROLE_DAMAGE, PLAYER_ROLE_TANK, PLAYER_ROLE_HEALER,
+                                  PLAYER_ROLE_TANK | PLAYER_ROLE_DAMAGE, PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE, PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE };
+
+    // tries every slot for every player, like LFGMgr::CheckGroupRoles does
+    bool CanAssignRoles(std::vector<uint8> const& roles, std::size_t index = 0, uint8 tanks = 0, uint8 healers = 0, uint8 dps = 0)
+    {
+        if (index == roles.size())
+            return true;
+
+        uint8 role = roles[index];
+        return ((role & PLAYER_ROLE_TANK) && tanks < LFG_TANKS_NEEDED && CanAssignRoles(roles, index + 1, tanks + 1, healers, dps)) ||
+            ((role & PLAYER_ROLE_HEALER) && healers < LFG_HEALERS_NEEDED && CanAssignRoles(roles, index + 1, tanks, healers + 1, dps)) ||
+            ((role & PLAYER_ROLE_DAMAGE) && dps < LFG_DPS_NEEDED && CanAssignRoles(roles, index + 1, tanks, healers, dps + 1));
+    }
+
+    struct QueuedEntry
+    {
+        LfgDungeonSet Dungeons;
+        LfgRolesMap Roles;
+        std::set<uint64> Ignores;
+        LfgQueueMask Mask;
+    };
+
+    // true if a player of the two entries ignores another one of them, CheckCompatibility checks every pair of the proposal
+    bool HasIgnores(QueuedEntry const& a, QueuedEntry const& b)
+    {
+        for (LfgRolesMap const* roles : { &a.Roles, &b.Roles })
+            for (LfgRolesMap::const_iterator itr = roles->begin(); itr != roles->end(); ++itr)
+                if (a.Ignores.count(itr->first) || b.Ignores.count(itr->first))
+                    return true;
+
+        return false;
+    }
+
+    // what CheckCompatibility compares for two queued entries, through the containers
+    bool LegacyCompatible(QueuedEntry const& a, QueuedEntry const& b)
+    {
+        if (a.Roles.size() + b.Roles.size() > 5)
+            return false;
+
+        if (HasIgnores(a, b))
+            return false;
+
+        LfgRolesMap proposalRoles = a.Roles;
+        proposalRoles.insert(b.Roles.begin(), b.Roles.end());
+
+        std::vector<uint8> roles;
+        for (LfgRolesMap::const_iterator itr = proposalRoles.begin(); itr != proposalRoles.end(); ++itr)
+            roles.push_back(itr->second & ~PLAYER_ROLE_LEADER);
+        if (!CanAssignRoles(roles))
+            return false;
+
+        LfgDungeonSet dungeons;
+        std::set_intersection(a.Dungeons.begin(), a.Dungeons.end(), b.Dungeons.begin(), b.Dungeons.end(), std::inserter(dungeons, dungeons.begin()));
+        return !dungeons.empty();
+    }
+
+    bool MaskCompatible(QueuedEntry const& a, QueuedEntry const& b)
+    {
+        if (!a.Mask.CanMerge(b.Mask))
+            return false;
+
+        return !a.Mask.MayIgnore(b.Mask) || !HasIgnores(a, b);
+    }
+
+    std::vector<QueuedEntry> MakeQueue(uint32 count, std::mt19937& rng)
+    {
+        std::vector<QueuedEntry> queue(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            QueuedEntry& entry = queue[i];
+            uint32 dungeonCount = 1 + rng() % 3;
+            while (entry.Dungeons.size() < dungeonCount)
+                entry.Dungeons.insert(200 + rng() % 20);
+            entry.Roles[i + 1] = RoleChoices[rng() % (sizeof(RoleChoices) / sizeof(RoleChoices[0]))] | (rng() % 2 ? PLAYER_ROLE_LEADER : 0);
+            uint64 ignored = 1 + rng() % count;
+            if (rng() % 10 == 0 && ignored != i + 1)
+                entry.Ignores.insert(ignored);
+
+            entry.Mask = LfgQueueMask(entry.Dungeons, entry.Roles);
+            for (uint64 ignore : entry.Ignores)
+                entry.Mask.AddIgnore(GUID_LOPART(ignore));
+        }
+        return queue;
+    }
+
+    // partial groups of two and three players, as FindNewGroups keeps them in its compatible list
+    std::vector<QueuedEntry> MakeCompatibles(std::vector<QueuedEntry> const& queue, std::mt19937& rng)
+    {
+        std::vector<QueuedEntry> compatibles;
+        while (compatibles.size() < 4000)
+        {
+            QueuedEntry entry = queue[rng() % queue.size()];
+            uint32 size = 2 + rng() % 2;
+            for (uint32 tries = 0; tries < 20 && entry.Roles.size() < size; ++tries)
+            {
+                QueuedEntry const& other = queue[rng() % queue.size()];
+                if (entry.Roles.count(other.Roles.begin()->first) || !LegacyCompatible(entry, other))
+                    continue;
+
+                LfgDungeonSet dungeons;
+                std::set_intersection(entry.Dungeons.begin(), entry.Dungeons.end(), other.Dungeons.begin(), other.Dungeons.end(), std::inserter(dungeons, dungeons.begin()));
+                entry.Dungeons = dungeons;
+                entry.Roles.insert(other.Roles.begin(), other.Roles.end());
+                entry.Ignores.insert(other.Ignores.begin(), other.Ignores.end());
+                entry.Mask.Merge(other.Mask);
+            }
+
+            // a player ignores another one of the partial group after it was stored, as LFGQueue::AddIgnore updates it
+            if (entry.Roles.size() > 1 && rng() % 10 == 0)
+            {
+                uint64 ignored = std::next(entry.Roles.begin())->first;
+                entry.Ignores.insert(ignored);
+                entry.Mask.AddIgnore(GUID_LOPART(ignored));
+            }
+            compatibles.push_back(entry);
+        }
+        return compatibles;
+    }
+}
+
+TEST(LFGQueueMaskTest, RolesMatchExhaustiveAssignment)
+{
+    uint8 const roleMasks[] = { PLAYER_ROLE_NONE, PLAYER_ROLE_TANK, PLAYER_ROLE_HEALER, PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER, PLAYER_ROLE_DAMAGE,
+                                PLAYER_ROLE_TANK | PLAYER_ROLE_DAMAGE, PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE, PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE };
+
+    // every group of one to six players with every combination of roles
+    for (uint32 size = 1; size <= 6; ++size)
+    {
+        uint32 combinations = 1;
+        for (uint32 i = 0; i < size; ++i)
+            combinations *= 8;
+
+        for (uint32 combination = 0; combination < combinations; ++combination)
+        {
+            std::vector<uint8> roles;
+            uint8 counts[8] = { };
+            for (uint32 i = 0, c = combination; i < size; ++i, c /= 8)
+            {
+                roles.push_back(roleMasks[c % 8]);
+                ++counts[c % 8];
+            }
+
+            EXPECT_EQ(LfgQueueMask::HasRoles(counts), CanAssignRoles(roles)) << "combination " << combination << " of " << size << " players";
+        }
+    }
+}
+
+TEST(LFGQueueMaskTest, SameResultsAsContainerChecks)
+{
+    std::mt19937 rng(17);
+    std::vector<QueuedEntry> queue = MakeQueue(1000, rng);
+    std::vector<QueuedEntry> compatibles = MakeCompatibles(queue, rng);
+
+    uint32 compatibleCount = 0;
+    for (uint32 i = 0; i < 200; ++i)
+    {
+        QueuedEntry const& newEntry = queue[rng() % queue.size()];
+        for (QueuedEntry const& compatible : compatibles)
+        {
+            if (compatible.Roles.count(newEntry.Roles.begin()->first))
+                continue;
+
+            bool legacy = LegacyCompatible(compatible, newEntry);
+            EXPECT_EQ(legacy, MaskCompatible(compatible, newEntry));
+            compatibleCount += legacy;
+        }
+    }
+    EXPECT_GT(compatibleCount, 0u);
+}
+
+TEST(LFGQueueMaskTest, MergedMaskKeepsCommonDungeonsOnly)
+{
+    LfgRolesMap tank, healer;
+    tank[1] = PLAYER_ROLE_TANK;
+    healer[2] = PLAYER_ROLE_HEALER;
+
+    LfgQueueMask mask(LfgDungeonSet{ 206, 207 }, tank);
+    EXPECT_TRUE(mask.CanMerge(LfgQueueMask(LfgDungeonSet{ 207 }, healer)));
+    EXPECT_FALSE(mask.CanMerge(LfgQueueMask(LfgDungeonSet{ 208 }, healer)));
+    EXPECT_FALSE(mask.CanMerge(LfgQueueMask(LfgDungeonSet{ 207 }, tank)));
+
+    mask.Merge(LfgQueueMask(LfgDungeonSet{ 207 }, healer));
+    EXPECT_EQ(mask.players, 2);
+    EXPECT_FALSE(mask.dungeons.test(206));
+    EXPECT_TRUE(mask.dungeons.test(207));
+
+    LfgRolesMap damage;
+    damage[3] = PLAYER_ROLE_DAMAGE;
+    LfgQueueMask ignoring(LfgDungeonSet{ 207 }, damage);
+    EXPECT_FALSE(ignoring.MayIgnore(mask));
+    ignoring.AddIgnore(2);
+    EXPECT_TRUE(ignoring.MayIgnore(mask));
+    EXPECT_TRUE(mask.MayIgnore(ignoring));
+}
+
+TEST(LFGQueueMaskTest, IgnoreInsideStoredCompatible)
+{
+    LfgRolesMap tank, healer, damage;
+    tank[1] = PLAYER_ROLE_TANK;
+    healer[2] = PLAYER_ROLE_HEALER;
+    damage[3] = PLAYER_ROLE_DAMAGE;
+
+    LfgQueueMask compatible(LfgDungeonSet{ 207 }, tank);
+    compatible.Merge(LfgQueueMask(LfgDungeonSet{ 207 }, healer));
+    LfgQueueMask newMask(LfgDungeonSet{ 207 }, damage);
+    EXPECT_FALSE(compatible.MayIgnore(newMask));
+
+    // the tank ignores the healer once both are stored together, the newcomer must not bring them into a proposal
+    compatible.AddIgnore(2);
+    EXPECT_TRUE(compatible.MayIgnore(newMask));
+    EXPECT_TRUE(newMask.MayIgnore(compatible));
+}
+
+// 1000 queued players across 20 dungeons, run it with --gtest_also_run_disabled_tests
+TEST(LFGQueueMaskTest, DISABLED_CompatibilityBenchmark)
+{
+    constexpr uint32 ROUNDS = 1000;
+
+    std::mt19937 rng(23);
+    std::vector<QueuedEntry> queue = MakeQueue(1000, rng);
+    std::vector<QueuedEntry> compatibles = MakeCompatibles(queue, rng);
+    std::vector<uint32> newEntries;
+    for (uint32 i = 0; i < ROUNDS; ++i)
+        newEntries.push_back(rng() % queue.size());
+
+    uint32 legacyStart = getMSTime();
+    std::size_t legacyCount = 0;
+    for (uint32 index : newEntries)
+        for (QueuedEntry const& compatible : compatibles)
+            if (!compatible.Roles.count(index + 1))
+                legacyCount += LegacyCompatible(compatible, queue[index]);
+    uint32 legacyTime = GetMSTimeDiffToNow(legacyStart);
+
+    uint32 maskStart = getMSTime();
+    std::size_t maskCount = 0;
+    for (uint32 index : newEntries)
+        for (QueuedEntry const& compatible : compatibles)
+            if (!compatible.Roles.count(index + 1))
+                maskCount += MaskCompatible(compatible, queue[index]);
+    uint32 maskTime = GetMSTimeDiffToNow(maskStart);
+
+    EXPECT_EQ(legacyCount, maskCount);
+
+    std::cout << "[ BENCHMARK ] " << ROUNDS * compatibles.size() << " compatibility checks, " << queue.size() << " players in 20 dungeons: "
+        << "containers " << legacyTime << " ms, bitsets " << maskTime << " ms" << std::endl;
+}
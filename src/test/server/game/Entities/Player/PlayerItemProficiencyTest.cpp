@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "ItemTemplate.h"
+#include "Player.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    ItemTemplate MakeItem(uint32 itemClass, uint32 subClass, uint32 quality = ITEM_QUALITY_NORMAL)
+    {
+        ItemTemplate proto = { };
+        proto.Class = itemClass;
+        proto.SubClass = subClass;
+        proto.Quality = quality;
+        return proto;
+    }
+}
+
+TEST(PlayerItemProficiencyTest, ClothClassCannotUsePlateOrSwords)
+{
+    // a mage has never learned plate mail nor swords
+    ItemTemplate plate = MakeItem(ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_PLATE);
+    ItemTemplate sword = MakeItem(ITEM_CLASS_WEAPON, ITEM_SUBCLASS_WEAPON_SWORD);
+    EXPECT_FALSE(Player::HasItemProficiency(&plate, CLASS_MAGE, false, 0));
+    EXPECT_FALSE(Player::HasItemProficiency(&sword, CLASS_MAGE, false, 0));
+
+    ItemTemplate cloth = MakeItem(ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH);
+    EXPECT_TRUE(Player::HasItemProficiency(&cloth, CLASS_MAGE, true, 1));
+}
+
+TEST(PlayerItemProficiencyTest, ItemsWithoutSkillNeedNoProficiency)
+{
+    ItemTemplate misc = MakeItem(ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_MISC);
+    ItemTemplate potion = MakeItem(ITEM_CLASS_CONSUMABLE, 0);
+    EXPECT_TRUE(Player::HasItemProficiency(&misc, CLASS_MAGE, false, 0));
+    EXPECT_TRUE(Player::HasItemProficiency(&potion, CLASS_MAGE, false, 0));
+}
+
+TEST(PlayerItemProficiencyTest, HeirloomArmorBeforeTheSkillIsLearned)
+{
+    // warriors and paladins learn plate, hunters and shamans mail, later on
+    ItemTemplate plate = MakeItem(ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_PLATE, ITEM_QUALITY_HEIRLOOM);
+    ItemTemplate mail = MakeItem(ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_MAIL, ITEM_QUALITY_HEIRLOOM);
+    EXPECT_TRUE(Player::HasItemProficiency(&plate, CLASS_WARRIOR, false, 0));
+    EXPECT_TRUE(Player::HasItemProficiency(&mail, CLASS_SHAMAN, false, 0));
+    EXPECT_FALSE(Player::HasItemProficiency(&plate, CLASS_SHAMAN, false, 0));
+    EXPECT_FALSE(Player::HasItemProficiency(&plate, CLASS_MAGE, false, 0));
+
+    // a learned skill with no value is not an exception
+    EXPECT_FALSE(Player::HasItemProficiency(&plate, CLASS_WARRIOR, true, 0));
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "PlayerNameIndex.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::string MakeName(std::mt19937& rng)
+    {
+        std::string name(1, char('A' + rng() % 26));
+        uint32 length = 2 + rng() % 10;
+        for (uint32 i = 0; i < length; ++i)
+            name += char('a' + rng() % 26);
+        return name;
+    }
+
+    std::vector<std::string> MakeNames(uint32 count, std::mt19937& rng)
+    {
+        std::vector<std::string> names;
+        std::set<std::string> unique;
+        while (names.size() < count)
+        {
+            std::string name = MakeName(rng);
+            if (unique.insert(name).second)
+                names.push_back(name);
+        }
+        return names;
+    }
+}
+
+TEST(PlayerNameIndexTest, FindsNamesInAnyCase)
+{
+    PlayerNameIndex index;
+    index.Insert("Arthas", 1);
+    index.Insert("Jaina", 2);
+    index.Insert("Ирина", 3);
+
+    EXPECT_EQ(index.Find("Arthas"), 1u);
+    EXPECT_EQ(index.Find("arthas"), 1u);
+    EXPECT_EQ(index.Find("ARTHAS"), 1u);
+    EXPECT_EQ(index.Find("jaina"), 2u);
+    EXPECT_EQ(index.Find("ирина"), 3u);
+    EXPECT_EQ(index.Find("ИРИНА"), 3u);
+    EXPECT_EQ(index.Find("Thrall"), 0u);
+    EXPECT_EQ(index.Find(""), 0u);
+}
+
+TEST(PlayerNameIndexTest, RenamesAndDeletions)
+{
+    PlayerNameIndex index;
+    index.Insert("Arthas", 1);
+
+    // rename
+    index.Remove("Arthas");
+    index.Insert("Lichking", 1);
+    EXPECT_EQ(index.Find("arthas"), 0u);
+    EXPECT_EQ(index.Find("lichking"), 1u);
+
+    // a new character takes the free name
+    index.Insert("Arthas", 7);
+    EXPECT_EQ(index.Find("Arthas"), 7u);
+
+    index.Remove("LICHKING");
+    EXPECT_EQ(index.Find("Lichking"), 0u);
+}
+
+TEST(PlayerNameIndexTest, GrowsWhileReadersLookUp)
+{
+    std::mt19937 rng(21);
+    std::vector<std::string> names = MakeNames(20000, rng);
+
+    PlayerNameIndex index;
+    for (uint32 i = 0; i < 100; ++i)
+        index.Insert(names[i], i + 1);
+
+    // character creations grow the table under the readers
+    std::atomic<bool> done(false);
+    std::atomic<uint32> wrong(0);
+    std::vector<std::thread> readers;
+    for (uint32 t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&, t]()
+        {
+            std::mt19937 readerRng(t);
+            while (!done)
+            {
+                uint32 i = readerRng() % 100;
+                if (index.Find(names[i]) != i + 1)
+                    ++wrong;
+            }
+        });
+    }
+
+    for (uint32 i = 100; i < names.size(); ++i)
+        index.Insert(names[i], i + 1);
+    done = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(wrong, 0u);
+    for (uint32 i = 0; i < names.size(); ++i)
+        EXPECT_EQ(index.Find(names[i]), i + 1);
+}
+
+TEST(PlayerNameIndexTest, SameResultsAsNameStore)
+{
+    std::mt19937 rng(5);
+    std::vector<std::string> names = MakeNames(20000, rng);
+
+    // the global player name store, keyed by the normalized name
+    std::map<std::string, uint32> nameStore;
+    PlayerNameIndex index;
+    index.Reserve(names.size());
+    for (uint32 i = 0; i < names.size(); ++i)
+    {
+        nameStore[names[i]] = i + 1;
+        index.Insert(names[i], i + 1);
+    }
+
+    for (uint32 i = 0; i < 100000; ++i)
+    {
+        std::string name = names[rng() % names.size()];
+        if (i % 10 == 0)
+            name[1] = '#';                                  // a typo
+        else if (i % 10 == 1)
+            std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+
+        std::string key = name;
+        std::transform(key.begin() + 1, key.end(), key.begin() + 1, ::tolower);
+        auto itr = nameStore.find(key);
+        ASSERT_EQ(index.Find(name), itr != nameStore.end() ? itr->second : 0u) << name;
+    }
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "ShardedGuidMap.h"
+#include "Timer.h"
+#include "gtest/gtest.h"
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TestObject
+    {
+        uint64 Guid;
+    };
+
+    // the single locked map HashMapHolder used before
+    class LockedGuidMap
+    {
+    public:
+        void Insert(uint64 guid, TestObject* object)
+        {
+            std::unique_lock<std::shared_mutex> lock(_lock);
+            _objects[guid] = object;
+        }
+
+        void Remove(uint64 guid)
+        {
+            std::unique_lock<std::shared_mutex> lock(_lock);
+            _objects.erase(guid);
+        }
+
+        TestObject* Find(uint64 guid) const
+        {
+            std::shared_lock<std::shared_mutex> lock(_lock);
+            auto itr = _objects.find(guid);
+            return itr != _objects.end() ? itr->second : nullptr;
+        }
+
+    private:
+        mutable std::shared_mutex _lock;
+        std::unordered_map<uint64, TestObject*> _objects;
+    };
+
+    /*
+     * Map threads resolving the guids of the online players while one thread logs players in and out.
+     * Objects are never freed here, so a lookup racing a logout may return either result, but never another object.
+     */
+    template<class Map>
+    uint32 RunLogins(Map& map, std::vector<TestObject>& players, uint32 threadCount, uint32 lookupsPerThread, uint32& wrongObjects)
+    {
+        std::atomic<bool> done(false);
+        std::atomic<uint32> wrong(0);
+        std::atomic<uint32> found(0);
+
+        std::thread logins([&]()
+        {
+            std::mt19937 rng(3);
+            while (!done)
+            {
+                TestObject& player = players[rng() % players.size()];
+                map.Remove(player.Guid);
+                map.Insert(player.Guid, &player);
+            }
+        });
+
+        std::vector<std::thread> mapThreads;
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            mapThreads.emplace_back([&, t]()
+            {
+                std::mt19937 rng(100 + t);
+                uint32 localFound = 0;
+                for (uint32 i = 0; i < lookupsPerThread; ++i)
+                {
+                    // most lookups are for a few players: the own group, the current target
+                    uint32 index = (i % 4) ? rng() % 8 : rng() % players.size();
+                    if (TestObject* object = map.Find(players[index].Guid))
+                    {
+                        ++localFound;
+                        if (object != &players[index])
+                            ++wrong;
+                    }
+                }
+                found += localFound;
+            });
+        }
+
+        for (std::thread& thread : mapThreads)
+            thread.join();
+        done = true;
+        logins.join();
+
+        wrongObjects = wrong;
+        return found;
+    }
+
+    std::vector<TestObject> MakePlayers(uint32 count)
+    {
+        std::vector<TestObject> players(count);
+        for (uint32 i = 0; i < count; ++i)
+            players[i].Guid = i + 1;             // player guids are their low guid
+        return players;
+    }
+}
+
+TEST(ShardedGuidMapTest, FindsInsertedObjects)
+{
+    std::vector<TestObject> players = MakePlayers(1000);
+    ShardedGuidMap<TestObject> map;
+    for (TestObject& player : players)
+        map.Insert(player.Guid, &player);
+
+    for (TestObject& player : players)
+        EXPECT_EQ(map.Find(player.Guid), &player);
+    EXPECT_EQ(map.Find(5001), nullptr);
+
+    for (uint32 i = 0; i < players.size(); i += 2)
+        map.Remove(players[i].Guid);
+
+    for (uint32 i = 0; i < players.size(); ++i)
+        EXPECT_EQ(map.Find(players[i].Guid), i % 2 ? &players[i] : nullptr);
+}
+
+TEST(ShardedGuidMapTest, ThreadCacheSeesRemovalsAndReplacements)
+{
+    TestObject first = { 1 };
+    TestObject second = { 1 };
+    ShardedGuidMap<TestObject> map;
+
+    map.Insert(first.Guid, &first);
+    EXPECT_EQ(map.Find(first.Guid), &first);
+    EXPECT_EQ(map.Find(first.Guid), &first);            // from the cache
+
+    map.Insert(second.Guid, &second);
+    EXPECT_EQ(map.Find(first.Guid), &second);
+
+    map.Remove(second.Guid);
+    EXPECT_EQ(map.Find(first.Guid), nullptr);
+
+    // another map with the same guids does not see the entries of the first one
+    ShardedGuidMap<TestObject> other;
+    map.Insert(first.Guid, &first);
+    EXPECT_EQ(map.Find(first.Guid), &first);
+    EXPECT_EQ(other.Find(first.Guid), nullptr);
+}
+
+TEST(ShardedGuidMapTest, LookupsDuringLogins)
+{
+    std::vector<TestObject> players = MakePlayers(500);
+    ShardedGuidMap<TestObject> map;
+    for (TestObject& player : players)
+        map.Insert(player.Guid, &player);
+
+    uint32 wrong = 0;
+    uint32 found = RunLogins(map, players, 4, 20000, wrong);
+
+    EXPECT_EQ(wrong, 0u);
+    EXPECT_GT(found, 0u);
+
+    // every player is back online
+    for (TestObject& player : players)
+        EXPECT_EQ(map.Find(player.Guid), &player);
+}
+
+// Compares the sharded index with the locked map, run with --gtest_also_run_disabled_tests
+TEST(ShardedGuidMapTest, DISABLED_LookupsDuringLoginsBenchmark)
+{
+    constexpr uint32 THREAD_COUNT = 8;
+    constexpr uint32 LOOKUPS_PER_THREAD = 500000;
+
+    std::vector<TestObject> players = MakePlayers(5000);
+
+    LockedGuidMap locked;
+    ShardedGuidMap<TestObject> sharded;
+    for (TestObject& player : players)
+    {
+        locked.Insert(player.Guid, &player);
+        sharded.Insert(player.Guid, &player);
+    }
+
+    uint32 lockedWrong = 0, shardedWrong = 0;
+
+    uint32 lockedStart = getMSTime();
+    uint32 lockedFound = RunLogins(locked, players, THREAD_COUNT, LOOKUPS_PER_THREAD, lockedWrong);
+    uint32 lockedTime = GetMSTimeDiffToNow(lockedStart);
+
+    uint32 shardedStart = getMSTime();
+    uint32 shardedFound = RunLogins(sharded, players, THREAD_COUNT, LOOKUPS_PER_THREAD, shardedWrong);
+    uint32 shardedTime = GetMSTimeDiffToNow(shardedStart);
+
+    EXPECT_EQ(lockedWrong, 0u);
+    EXPECT_EQ(shardedWrong, 0u);
+
+    std::cout << "[ BENCHMARK ] " << THREAD_COUNT * LOOKUPS_PER_THREAD << " lookups from " << THREAD_COUNT << " threads during logins: "
+        << "locked map " << lockedTime << " ms (" << lockedFound << " found), "
+        << "sharded " << shardedTime << " ms (" << shardedFound << " found)" << std::endl;
+}
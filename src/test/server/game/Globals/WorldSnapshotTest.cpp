@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "WorldSnapshot.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    std::string const FileName = "WorldSnapshotTest.snapshot";
+
+    ByteBuffer MakeSource(uint32 version)
+    {
+        ByteBuffer source;
+        source << uint32(571) << uint32(version);
+        return source;
+    }
+
+    ByteBuffer MakePayload()
+    {
+        ByteBuffer payload;
+        payload << uint32(3);
+        for (uint32 guid = 1; guid <= 3; ++guid)
+            payload << guid << float(guid * 1.5f) << uint8(guid % 2);
+        return payload;
+    }
+
+    void WriteSnapshot(uint32 sourceVersion)
+    {
+        WorldSnapshot snapshot(FileName);
+        snapshot.AddSourceData(MakeSource(sourceVersion));
+        snapshot.Write(MakePayload());
+    }
+
+    bool ReadSnapshot(uint32 sourceVersion, ByteBuffer& payload)
+    {
+        WorldSnapshot snapshot(FileName);
+        snapshot.AddSourceData(MakeSource(sourceVersion));
+        return snapshot.Read(payload);
+    }
+
+    class WorldSnapshotTest : public ::testing::Test
+    {
+    protected:
+        void TearDown() override { std::remove(FileName.c_str()); }
+    };
+}
+
+TEST_F(WorldSnapshotTest, ReadsBackWhatWasWritten)
+{
+    WriteSnapshot(1);
+
+    ByteBuffer payload;
+    ASSERT_TRUE(ReadSnapshot(1, payload));
+    EXPECT_EQ(payload.rpos(), 0u);
+    EXPECT_EQ(payload.size(), MakePayload().size());
+
+    EXPECT_EQ(payload.read<uint32>(), 3u);
+    for (uint32 guid = 1; guid <= 3; ++guid)
+    {
+        EXPECT_EQ(payload.read<uint32>(), guid);
+        EXPECT_EQ(payload.read<float>(), guid * 1.5f);
+        EXPECT_EQ(payload.read<uint8>(), guid % 2);
+    }
+}
+
+TEST_F(WorldSnapshotTest, RejectsChangedSources)
+{
+    WriteSnapshot(1);
+
+    ByteBuffer payload;
+    EXPECT_FALSE(ReadSnapshot(2, payload));
+
+    // a rebuilt snapshot is read again
+    WriteSnapshot(2);
+    EXPECT_TRUE(ReadSnapshot(2, payload));
+}
+
+TEST_F(WorldSnapshotTest, RejectsDamagedFiles)
+{
+    ByteBuffer payload;
+    EXPECT_FALSE(ReadSnapshot(1, payload));
+
+    WriteSnapshot(1);
+    {
+        std::fstream file(FileName, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(WorldSnapshot::HEADER_SIZE + 2);
+        file.put('x');
+    }
+    EXPECT_FALSE(ReadSnapshot(1, payload));
+
+    WriteSnapshot(1);
+    {
+        std::ofstream file(FileName, std::ios::out | std::ios::binary | std::ios::app);
+        file.put('x');
+    }
+    EXPECT_FALSE(ReadSnapshot(1, payload));
+
+    WriteSnapshot(1);
+    {
+        std::fstream file(FileName, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(4);
+        file.put(char(WorldSnapshot::FORMAT_VERSION + 1));
+    }
+    EXPECT_FALSE(ReadSnapshot(1, payload));
+}
+
+TEST_F(WorldSnapshotTest, HeaderIsLittleEndianFields)
+{
+    WriteSnapshot(1);
+
+    std::ifstream file(FileName, std::ios::in | std::ios::binary);
+    char header[WorldSnapshot::HEADER_SIZE];
+    ASSERT_TRUE(file.read(header, sizeof(header)));
+
+    EXPECT_EQ(std::string(header, 4), "ACWS");
+    EXPECT_EQ(uint8(header[4]), WorldSnapshot::FORMAT_VERSION);
+
+    uint64 payloadSize = 0;
+    for (uint32 i = 0; i < 8; ++i)
+        payloadSize |= uint64(uint8(header[4 + 4 + acore::Crypto::SHA1::DIGEST_LENGTH + i])) << (8 * i);
+    EXPECT_EQ(payloadSize, MakePayload().size());
+}
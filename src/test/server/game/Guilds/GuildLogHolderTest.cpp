@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "Guild.h"
+#include "WorldPacket.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+    struct LogCalls
+    {
+        std::vector<uint32> Saved;
+        std::vector<uint32> DeletedOlder;
+        uint32 Destroyed = 0;
+    };
+}
+
+// The log classes are private to Guild, the fixture is its friend
+class GuildLogHolderTest : public testing::Test
+{
+protected:
+    typedef Guild::LogHolder LogHolder;
+
+    class TestLogEntry : public Guild::LogEntry
+    {
+    public:
+        TestLogEntry(uint32 guid, LogCalls& calls) : Guild::LogEntry(1, guid), _calls(calls) { }
+        ~TestLogEntry() override { ++_calls.Destroyed; }
+
+        void SaveToDB(SQLTransaction& /*trans*/) const override { _calls.Saved.push_back(m_guid); }
+        void DeleteOlderFromDB(SQLTransaction& /*trans*/, uint32 guid) const override { _calls.DeletedOlder.push_back(guid); }
+        void WritePacket(WorldPacket& data) const override { data << uint32(m_guid); }
+
+    private:
+        LogCalls& _calls;
+    };
+
+    static std::vector<uint32> WrittenGuids(LogHolder const& log)
+    {
+        WorldPacket data;
+        log.WritePacket(data);
+
+        uint8 size;
+        data >> size;
+        std::vector<uint32> guids(size);
+        for (uint32& guid : guids)
+            data >> guid;
+        return guids;
+    }
+};
+
+TEST_F(GuildLogHolderTest, LoadsOlderEventsInFrontOfNewOnes)
+{
+    LogCalls calls;
+    {
+        LogHolder log(1, 5);
+        log.SetNextGUID(10);
+        log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+        log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+        EXPECT_EQ(log.GetFirstGUID(), 10u);
+        EXPECT_EQ(log.GetFreeRecords(), 3u);
+
+        // rows come from the newest to the oldest
+        for (uint32 guid = 9; log.CanInsert(); --guid)
+            log.LoadEvent(new TestLogEntry(guid, calls));
+
+        EXPECT_EQ(log.GetSize(), 5);
+        EXPECT_EQ(log.GetFirstGUID(), 7u);
+        EXPECT_EQ(WrittenGuids(log), std::vector<uint32>({ 7, 8, 9, 10, 11 }));
+    }
+    EXPECT_EQ(calls.Destroyed, 5u);
+}
+
+TEST_F(GuildLogHolderTest, FullLogTakesNoLoadedEvents)
+{
+    // the log filled up between the query and its result
+    LogCalls calls;
+    {
+        LogHolder log(1, 3);
+        log.SetNextGUID(100);
+        for (uint32 i = 0; i < 4; ++i)
+            log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+
+        EXPECT_FALSE(log.CanInsert());
+        EXPECT_EQ(log.GetFreeRecords(), 0u);
+        EXPECT_EQ(log.GetSize(), 3);
+        EXPECT_EQ(WrittenGuids(log), std::vector<uint32>({ 101, 102, 103 }));
+        EXPECT_EQ(calls.Destroyed, 1u);
+    }
+    EXPECT_EQ(calls.Destroyed, 4u);
+}
+
+TEST_F(GuildLogHolderTest, SavesOnlyEventsStillInLog)
+{
+    LogCalls calls;
+    LogHolder log(1, 3);
+    SQLTransaction trans;
+
+    EXPECT_FALSE(log.SaveToDB(trans));
+
+    // five events before the save, the two oldest were overwritten unsaved
+    for (uint32 i = 0; i < 5; ++i)
+        log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+
+    EXPECT_TRUE(log.SaveToDB(trans));
+    EXPECT_EQ(calls.Saved, std::vector<uint32>({ 2, 3, 4 }));
+    EXPECT_EQ(calls.DeletedOlder, std::vector<uint32>({ 2 }));
+
+    // nothing new, nothing to save
+    EXPECT_FALSE(log.SaveToDB(trans));
+
+    log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+    EXPECT_TRUE(log.SaveToDB(trans));
+    EXPECT_EQ(calls.Saved, std::vector<uint32>({ 2, 3, 4, 5 }));
+    EXPECT_EQ(calls.DeletedOlder, std::vector<uint32>({ 2, 3 }));
+}
+
+TEST_F(GuildLogHolderTest, DeletesOlderRowsOnlyPastTheLogSize)
+{
+    LogCalls calls;
+    LogHolder log(1, 3);
+    SQLTransaction trans;
+
+    log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+    log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+    log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+    EXPECT_TRUE(log.SaveToDB(trans));
+    EXPECT_EQ(calls.Saved, std::vector<uint32>({ 0, 1, 2 }));
+    EXPECT_TRUE(calls.DeletedOlder.empty());
+
+    log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+    EXPECT_TRUE(log.SaveToDB(trans));
+    EXPECT_EQ(calls.DeletedOlder, std::vector<uint32>({ 1 }));
+}
+
+TEST_F(GuildLogHolderTest, DiscardedEventsAreNotSaved)
+{
+    LogCalls calls;
+    LogHolder log(1, 3);
+    SQLTransaction trans;
+
+    log.AddEvent(new TestLogEntry(log.GetNextGUID(), calls));
+    log.DiscardUnsaved();
+    EXPECT_FALSE(log.SaveToDB(trans));
+    EXPECT_TRUE(calls.Saved.empty());
+}
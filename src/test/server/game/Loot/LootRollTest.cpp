@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "ItemTemplate.h"
+#include "LootMgr.h"
+#include "ObjectMgr.h"
+#include "Timer.h"
+#include "gtest/gtest.h"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    typedef LootTemplate::LootGroup LootGroup;
+
+    // Chances are multiples of 1/64 so the running total and the subtractions of the walk are exact
+    void AddEntries(LootGroup& group, uint32 firstItem, std::vector<float> const& chances)
+    {
+        for (float chance : chances)
+            group.AddEntry(new LootStoreItem(firstItem++, 0, chance, false, LOOT_MODE_DEFAULT, 1, 1, 1));
+        group.Compile();
+    }
+
+    // Every roll of the compiled tables picks the entry of the list walk
+    void ExpectSamePicks(LootGroup& group, std::vector<float> const& rolls)
+    {
+        Loot loot;
+        for (float roll : rolls)
+        {
+            LootStoreItem const* walked = LootGroup::PickExplicitlyChanced(*group.GetExplicitlyChancedItemList(), roll, loot, nullptr, LootTemplates_Creature);
+            ASSERT_EQ(group.PickExplicitlyChanced(roll), walked) << "roll " << roll;
+        }
+    }
+
+    // rand_chance() steps, so every chance boundary is rolled exactly
+    std::vector<float> GridRolls()
+    {
+        std::vector<float> rolls;
+        for (uint32 i = 0; i < 6400; ++i)
+            rolls.push_back(i / 64.0f);
+        return rolls;
+    }
+
+    std::vector<float> RandomRolls()
+    {
+        std::mt19937 rng(17);
+        std::uniform_real_distribution<float> roll(0.0f, 100.0f);
+
+        std::vector<float> rolls;
+        for (uint32 i = 0; i < 100000; ++i)
+            rolls.push_back(roll(rng));
+        return rolls;
+    }
+}
+
+// A raid boss group of 15 epics, the rolls past their total drop nothing
+TEST(LootRollTest, BossGroupMatchesListWalk)
+{
+    LootGroup group;
+    AddEntries(group, 3000, std::vector<float>(15, 6.25f));
+
+    EXPECT_EQ(group.PickExplicitlyChanced(0.0f)->itemid, 3000u);
+    EXPECT_EQ(group.PickExplicitlyChanced(6.25f)->itemid, 3001u);
+    EXPECT_EQ(group.PickExplicitlyChanced(93.75f), nullptr);
+
+    ExpectSamePicks(group, GridRolls());
+    ExpectSamePicks(group, RandomRolls());
+}
+
+// The world drop group of trash, many small chances
+TEST(LootRollTest, WorldDropGroupMatchesListWalk)
+{
+    LootGroup group;
+    AddEntries(group, 1000, std::vector<float>(150, 0.0625f));
+
+    ExpectSamePicks(group, GridRolls());
+    ExpectSamePicks(group, RandomRolls());
+}
+
+// An entry of 100% takes every roll its predecessors miss, equal chanced entries are not picked by the roll
+TEST(LootRollTest, GuaranteedEntryMatchesListWalk)
+{
+    LootGroup group;
+    group.AddEntry(new LootStoreItem(4000, 0, 0.0f, false, LOOT_MODE_DEFAULT, 1, 1, 1));
+    AddEntries(group, 4001, { 30.0f, 100.0f, 20.0f });
+
+    EXPECT_EQ(group.PickExplicitlyChanced(29.5f)->itemid, 4001u);
+    EXPECT_EQ(group.PickExplicitlyChanced(99.5f)->itemid, 4002u);
+
+    ExpectSamePicks(group, GridRolls());
+    ExpectSamePicks(group, RandomRolls());
+}
+
+// Chances of all sizes as loaded from the database, in their table order
+TEST(LootRollTest, MixedChancesMatchListWalk)
+{
+    std::mt19937 rng(5);
+    std::vector<float> chances;
+    for (uint32 i = 0; i < 40; ++i)
+        chances.push_back((1 + rng() % 160) / 64.0f);
+
+    LootGroup group;
+    AddEntries(group, 5000, chances);
+
+    ExpectSamePicks(group, GridRolls());
+    ExpectSamePicks(group, RandomRolls());
+}
+
+/*
+ * Rolls through LootTemplate::Process with item templates, so the loot gets the items and the filtered roll
+ * sees them. The tests share the item template store of ObjectMgr, the fixture removes its templates again.
+ */
+class LootProcessTest : public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        ItemTemplateStore().resize(_storeSize);
+        _templates.clear();
+    }
+
+    // Non-equippable items may drop 3 times, equippable ones once
+    void AddItemTemplate(uint32 itemId, bool equippable)
+    {
+        std::vector<ItemTemplate*>& store = ItemTemplateStore();
+        if (_templates.empty())
+            _storeSize = store.size();
+        if (store.size() <= itemId)
+            store.resize(itemId + 1, nullptr);
+
+        _templates.emplace_back(new ItemTemplate());
+        _templates.back()->ItemId = itemId;
+        _templates.back()->InventoryType = equippable ? INVTYPE_CHEST : INVTYPE_NON_EQUIP;
+        _templates.back()->Stackable = 1;
+        store[itemId] = _templates.back().get();
+    }
+
+    // Adds grouped entries to the template, each item gets a template
+    void AddGroupEntries(LootTemplate& tab, uint32 firstItem, std::vector<float> const& chances, uint16 lootMode = LOOT_MODE_DEFAULT, bool equippable = true)
+    {
+        for (float chance : chances)
+        {
+            AddItemTemplate(firstItem, equippable);
+            tab.AddEntry(new LootStoreItem(firstItem++, 0, chance, false, lootMode, 1, 1, 1));
+        }
+    }
+
+    static std::vector<uint32> LootedItems(Loot const& loot)
+    {
+        std::vector<uint32> items;
+        for (LootItem const& item : loot.items)
+            items.push_back(item.itemid);
+        return items;
+    }
+
+private:
+    static std::vector<ItemTemplate*>& ItemTemplateStore() { return *const_cast<std::vector<ItemTemplate*>*>(sObjectMgr->GetItemTemplateStoreFast()); }
+
+    std::vector<std::unique_ptr<ItemTemplate>> _templates;
+    std::size_t _storeSize = 0;
+};
+
+// An entry of another loot mode must not take the roll: the group falls back to the filtered walk
+TEST_F(LootProcessTest, OtherLootModeIsFilteredOut)
+{
+    LootTemplate tab;
+    AddGroupEntries(tab, 100, { 100.0f }, LOOT_MODE_HARD_MODE_1);
+    AddGroupEntries(tab, 101, { 100.0f });
+    tab.Compile();
+
+    Loot normal;
+    tab.Process(normal, LootTemplates_Creature, LOOT_MODE_DEFAULT, nullptr);
+    EXPECT_EQ(LootedItems(normal), std::vector<uint32>({ 101 }));
+
+    Loot hardMode;
+    tab.Process(hardMode, LootTemplates_Creature, LOOT_MODE_HARD_MODE_1, nullptr);
+    EXPECT_EQ(LootedItems(hardMode), std::vector<uint32>({ 100 }));
+
+    // both modes: no entry is filtered out and the first one takes the roll
+    Loot both;
+    tab.Process(both, LootTemplates_Creature, LOOT_MODE_DEFAULT | LOOT_MODE_HARD_MODE_1, nullptr);
+    EXPECT_EQ(LootedItems(both), std::vector<uint32>({ 100 }));
+}
+
+// The same for the equal chanced entries
+TEST_F(LootProcessTest, OtherLootModeIsFilteredOutOfEqualChanced)
+{
+    LootTemplate tab;
+    AddGroupEntries(tab, 200, { 0.0f }, LOOT_MODE_HARD_MODE_1);
+    AddGroupEntries(tab, 201, { 0.0f });
+    tab.Compile();
+
+    for (uint32 i = 0; i < 50; ++i)
+    {
+        Loot loot;
+        tab.Process(loot, LootTemplates_Creature, LOOT_MODE_DEFAULT, nullptr);
+        ASSERT_EQ(LootedItems(loot), std::vector<uint32>({ 201 }));
+    }
+}
+
+// Once an item of the group is in the loot, the group falls back to the filtered walk and drops an equippable item only once
+TEST_F(LootProcessTest, LootedEquippableItemIsFilteredOut)
+{
+    LootTemplate tab;
+    AddGroupEntries(tab, 300, { 100.0f, 100.0f });
+    tab.Compile();
+
+    Loot loot;
+    tab.Process(loot, LootTemplates_Creature, LOOT_MODE_DEFAULT, nullptr);
+    EXPECT_EQ(LootedItems(loot), std::vector<uint32>({ 300 }));
+
+    tab.Process(loot, LootTemplates_Creature, LOOT_MODE_DEFAULT, nullptr);
+    EXPECT_EQ(LootedItems(loot), std::vector<uint32>({ 300, 301 }));
+
+    // nothing left to drop
+    tab.Process(loot, LootTemplates_Creature, LOOT_MODE_DEFAULT, nullptr);
+    EXPECT_EQ(LootedItems(loot), std::vector<uint32>({ 300, 301 }));
+}
+
+// A non-equippable item drops up to 3 times
+TEST_F(LootProcessTest, LootedItemIsFilteredOutAfterThreeDrops)
+{
+    LootTemplate tab;
+    AddGroupEntries(tab, 400, { 100.0f, 100.0f }, LOOT_MODE_DEFAULT, false);
+    tab.Compile();
+
+    Loot loot;
+    for (uint32 i = 0; i < 4; ++i)
+        tab.Process(loot, LootTemplates_Creature, LOOT_MODE_DEFAULT, nullptr);
+
+    EXPECT_EQ(LootedItems(loot), std::vector<uint32>({ 400, 400, 400, 401 }));
+}
+
+/*
+ * Compares the former roll of a group, which every roll took (copy of the entry list, removal of the entries
+ * of other loot modes or already looted, then the walk), with the compiled roll tables over one million kills,
+ * most of them trash with a raid boss now and then. The former roll is RollFiltered, which the groups still
+ * use when an entry is filtered out. The loot stays empty, so its duplicate check is the shortest it gets.
+ * Both draw their rolls from rand_chance(), so the picks are compared by their count only.
+ * Run it with --gtest_also_run_disabled_tests.
+ */
+TEST_F(LootProcessTest, DISABLED_MillionKillsBenchmark)
+{
+    constexpr uint32 KILL_COUNT = 1000000;
+
+    // two trash tables of one world drop group, a raid boss of three groups of epics
+    std::vector<std::vector<std::unique_ptr<LootGroup>>> tables(3);
+    for (uint32 t = 0; t < 2; ++t)
+    {
+        tables[t].emplace_back(new LootGroup());
+        for (uint32 i = 0; i < 150; ++i)
+            AddItemTemplate(1000 * (t + 1) + i, true);
+        AddEntries(*tables[t].back(), 1000 * (t + 1), std::vector<float>(150, 0.0625f));
+    }
+    for (uint32 g = 0; g < 3; ++g)
+    {
+        tables[2].emplace_back(new LootGroup());
+        for (uint32 i = 0; i < 15; ++i)
+            AddItemTemplate(3000 + g * 100 + i, true);
+        AddEntries(*tables[2].back(), 3000 + g * 100, std::vector<float>(15, 6.25f));
+    }
+
+    std::mt19937 killRng(5);
+    std::vector<uint32> kills(KILL_COUNT);
+    for (uint32& kill : kills)
+        kill = killRng() % 50 ? killRng() % 2 : 2;
+
+    Loot loot;
+    uint32 filteredDrops = 0;
+    uint32 filteredStart = getMSTime();
+    for (uint32 kill : kills)
+        for (std::unique_ptr<LootGroup> const& group : tables[kill])
+            if (group->RollFiltered(loot, nullptr, LootTemplates_Creature, LOOT_MODE_DEFAULT))
+                ++filteredDrops;
+    uint32 filteredTime = GetMSTimeDiffToNow(filteredStart);
+
+    uint32 compiledDrops = 0;
+    uint32 compiledStart = getMSTime();
+    for (uint32 kill : kills)
+        for (std::unique_ptr<LootGroup> const& group : tables[kill])
+            if (group->PickExplicitlyChanced((float)rand_chance()))
+                ++compiledDrops;
+    uint32 compiledTime = GetMSTimeDiffToNow(compiledStart);
+
+    // the trash groups drop 9.375% of the time, the boss groups 93.75%
+    EXPECT_NEAR(double(filteredDrops) / compiledDrops, 1.0, 0.02);
+
+    std::cout << "[ BENCHMARK ] " << KILL_COUNT << " kills: filtered list walk " << filteredTime << " ms (" << filteredDrops << " drops), "
+        << "compiled tables " << compiledTime << " ms (" << compiledDrops << " drops)" << std::endl;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "WhoListCache.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    uint32 const Zones[] = { 1, 12, 14, 17, 33, 85, 139, 141, 215, 1519, 1537, 1637, 1638, 1657, 3430, 3487, 3703, 4395 };
+
+    WhoListPlayerInfo MakeInfo(uint32 guidLow, std::mt19937& rng)
+    {
+        WhoListPlayerInfo info;
+        info.guidLow = guidLow;
+        info.player = nullptr;
+        info.teamId = TeamId(rng() % 2);
+        info.level = 1 + rng() % 80;
+        info.clas = 1 + rng() % 11;
+        info.race = 1 + rng() % 11;
+        info.zoneid = Zones[rng() % (sizeof(Zones) / sizeof(Zones[0]))];
+        info.gender = rng() % 2;
+        return info;
+    }
+
+    struct WhoFilter
+    {
+        uint32 TeamMask;
+        uint32 LevelMin;
+        uint32 LevelMax;
+        std::vector<uint32> Zones;
+    };
+
+    std::vector<WhoFilter> MakeFilters()
+    {
+        uint32 const both = (1 << TEAM_ALLIANCE) | (1 << TEAM_HORDE);
+        return
+        {
+            { both, 0, STRONG_MAX_LEVEL, { } },                     // default /who
+            { 1 << TEAM_ALLIANCE, 0, STRONG_MAX_LEVEL, { } },
+            { 1 << TEAM_HORDE, 80, 80, { } },
+            { both, 70, 80, { 4395 } },                             // /who in Dalaran
+            { 1 << TEAM_HORDE, 0, STRONG_MAX_LEVEL, { 1637, 1637 } },
+            { both, 10, 20, { 12, 14, 85, 141 } },
+            { 1 << TEAM_ALLIANCE, 58, 62, { 3430, 3487, 3703 } },
+            { both, 40, 30, { } },
+        };
+    }
+
+    void LinearSearch(std::vector<WhoListPlayerInfo> const& players, WhoFilter const& filter, WhoListIndex::EntryList& result)
+    {
+        for (WhoListPlayerInfo const& info : players)
+        {
+            if (!(filter.TeamMask & (1 << info.teamId)))
+                continue;
+            if (info.level < filter.LevelMin || info.level > filter.LevelMax)
+                continue;
+            if (!filter.Zones.empty() && std::find(filter.Zones.begin(), filter.Zones.end(), info.zoneid) == filter.Zones.end())
+                continue;
+            result.push_back(&info);
+        }
+    }
+
+    std::vector<uint32> Guids(WhoListIndex::EntryList const& entries)
+    {
+        std::vector<uint32> guids;
+        for (WhoListPlayerInfo const* info : entries)
+            guids.push_back(info->guidLow);
+        std::sort(guids.begin(), guids.end());
+        return guids;
+    }
+}
+
+TEST(WhoListIndexTest, SameResultsAsLinearSearchAfterUpdates)
+{
+    std::mt19937 rng(7);
+    std::vector<WhoListPlayerInfo> players;
+    WhoListIndex index;
+    for (uint32 guidLow = 1; guidLow <= 2000; ++guidLow)
+    {
+        players.push_back(MakeInfo(guidLow, rng));
+        index.Insert(players.back());
+    }
+
+    // level ups, zone changes and logouts as they come in from the world
+    for (uint32 i = 0; i < 3000; ++i)
+    {
+        WhoListPlayerInfo& info = players[rng() % players.size()];
+        switch (rng() % 3)
+        {
+            case 0:
+                info.level = std::min<uint32>(info.level + 1, 80);
+                index.UpdateLevel(info.guidLow, info.level);
+                break;
+            case 1:
+                info.zoneid = Zones[rng() % (sizeof(Zones) / sizeof(Zones[0]))];
+                index.UpdateZone(info.guidLow, info.zoneid);
+                break;
+            default:
+                index.UpdateGuild(info.guidLow, "Guild", L"guild");
+                break;
+        }
+    }
+
+    for (uint32 i = 0; i < 300; ++i)
+    {
+        std::size_t pos = rng() % players.size();
+        index.Remove(players[pos].guidLow);
+        players.erase(players.begin() + pos);
+    }
+
+    EXPECT_EQ(index.GetSize(), players.size());
+
+    for (WhoFilter const& filter : MakeFilters())
+    {
+        WhoListIndex::EntryList expected, found;
+        LinearSearch(players, filter, expected);
+        index.Search(filter.TeamMask, filter.LevelMin, filter.LevelMax, filter.Zones, found);
+        EXPECT_EQ(Guids(expected), Guids(found));
+    }
+}
+
+TEST(WhoListIndexTest, EntriesFollowTheirPlayer)
+{
+    std::mt19937 rng(11);
+    WhoListIndex index;
+    WhoListPlayerInfo info = MakeInfo(42, rng);
+    info.teamId = TEAM_HORDE;
+    info.level = 10;
+    info.zoneid = 14;
+    index.Insert(info);
+
+    index.UpdateLevel(42, 11);
+    index.UpdateZone(42, 17);
+    index.UpdateGuild(42, "Horde Guild", L"horde guild");
+
+    WhoListIndex::EntryList result;
+    index.Search(1 << TEAM_HORDE, 11, 11, { 17 }, result);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0]->gname, "Horde Guild");
+
+    result.clear();
+    index.Search(1 << TEAM_HORDE, 10, 10, { }, result);
+    index.Search(1 << TEAM_HORDE, 0, STRONG_MAX_LEVEL, { 14 }, result);
+    index.Search(1 << TEAM_ALLIANCE, 0, STRONG_MAX_LEVEL, { }, result);
+    EXPECT_TRUE(result.empty());
+
+    // a player that logs in again replaces its old entry
+    info.teamId = TEAM_ALLIANCE;
+    index.Insert(info);
+    EXPECT_EQ(index.GetSize(), 1u);
+
+    index.Remove(42);
+    index.Search(1 << TEAM_ALLIANCE | 1 << TEAM_HORDE, 0, STRONG_MAX_LEVEL, { }, result);
+    EXPECT_TRUE(result.empty());
+    EXPECT_EQ(index.GetSize(), 0u);
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "SharedPayloadDataBlock.h"
+#include "gtest/gtest.h"
+#include <cstring>
+
+namespace
+{
+    typedef ACE_Message_Queue<ACE_NULL_SYNCH> MessageQueue;
+
+    std::shared_ptr<WorldPacket const> MakePayload(uint16 opcode, uint32 size)
+    {
+        WorldPacket data(opcode, size);
+        for (uint32 i = 0; i < size; ++i)
+            data << uint8(i);
+        return std::make_shared<WorldPacket const>(data);
+    }
+
+    // a socket queued message, as WorldSocket::SendPacket builds it
+    ACE_Message_Block* MakeMessage(char const* header, std::shared_ptr<WorldPacket const> const& payload)
+    {
+        ACE_Message_Block* mb = new ACE_Message_Block(4);
+        mb->copy(header, 4);
+        if (payload)
+            mb->cont(SharedPayloadDataBlock::Create(payload));
+        return mb;
+    }
+}
+
+TEST(SharedPayloadDataBlockTest, BlockReferencesThePayload)
+{
+    std::shared_ptr<WorldPacket const> payload = MakePayload(0x96, 1024);
+
+    ACE_Message_Block* mb = SharedPayloadDataBlock::Create(payload);
+    ASSERT_NE(mb, nullptr);
+    EXPECT_EQ(mb->rd_ptr(), (char const*)payload->contents());
+    EXPECT_EQ(mb->length(), payload->size());
+    EXPECT_EQ(payload.use_count(), 2);
+
+    // a second socket of the broadcast
+    ACE_Message_Block* other = SharedPayloadDataBlock::Create(payload);
+    EXPECT_EQ(other->rd_ptr(), mb->rd_ptr());
+    EXPECT_EQ(payload.use_count(), 3);
+
+    mb->release();
+    other->release();
+    EXPECT_EQ(payload.use_count(), 1);
+}
+
+TEST(SharedPayloadDataBlockTest, HeaderAndPayloadAreGatheredTogether)
+{
+    std::shared_ptr<WorldPacket const> payload = MakePayload(0x96, 300);
+
+    MessageQueue queue;
+    queue.enqueue_tail(MakeMessage("hdr1", payload), (ACE_Time_Value*) &ACE_Time_Value::zero);
+    queue.enqueue_tail(MakeMessage("hdr2", nullptr), (ACE_Time_Value*) &ACE_Time_Value::zero);
+    EXPECT_EQ(payload.use_count(), 2);
+
+    iovec iov[8];
+    ASSERT_EQ(SharedPayloadDataBlock::Gather(queue, iov, 8), 3);
+    EXPECT_EQ(std::memcmp(iov[0].iov_base, "hdr1", 4), 0);
+    EXPECT_EQ(iov[0].iov_len, 4u);
+    EXPECT_EQ(iov[1].iov_base, (void const*)payload->contents());
+    EXPECT_EQ(iov[1].iov_len, payload->size());
+    EXPECT_EQ(std::memcmp(iov[2].iov_base, "hdr2", 4), 0);
+
+    // as many as the write takes
+    EXPECT_EQ(SharedPayloadDataBlock::Gather(queue, iov, 2), 2);
+
+    // a write ending in the payload, the rest of it goes first in the next one
+    EXPECT_EQ(SharedPayloadDataBlock::ReleaseSent(queue, 4 + 100), 0);
+    EXPECT_EQ(queue.message_count(), 2u);
+    ASSERT_EQ(SharedPayloadDataBlock::Gather(queue, iov, 8), 2);
+    EXPECT_EQ(iov[0].iov_base, (void const*)(payload->contents() + 100));
+    EXPECT_EQ(iov[0].iov_len, payload->size() - 100);
+    EXPECT_EQ(std::memcmp(iov[1].iov_base, "hdr2", 4), 0);
+
+    // a write ending in the middle of the next header
+    EXPECT_EQ(SharedPayloadDataBlock::ReleaseSent(queue, payload->size() - 100 + 2), 0);
+    EXPECT_EQ(payload.use_count(), 1);
+    ASSERT_EQ(SharedPayloadDataBlock::Gather(queue, iov, 8), 1);
+    EXPECT_EQ(std::memcmp(iov[0].iov_base, "r2", 2), 0);
+
+    EXPECT_EQ(SharedPayloadDataBlock::ReleaseSent(queue, 2), 0);
+    EXPECT_TRUE(queue.is_empty());
+    EXPECT_EQ(SharedPayloadDataBlock::Gather(queue, iov, 8), 0);
+}
+
+TEST(SharedPayloadDataBlockTest, PayloadQueuedWithoutHeader)
+{
+    std::shared_ptr<WorldPacket const> payload = MakePayload(0x96, 64);
+
+    // the header went into the out buffer of the socket
+    MessageQueue queue;
+    queue.enqueue_tail(SharedPayloadDataBlock::Create(payload), (ACE_Time_Value*) &ACE_Time_Value::zero);
+
+    iovec iov[8];
+    ASSERT_EQ(SharedPayloadDataBlock::Gather(queue, iov, 8), 1);
+    EXPECT_EQ(iov[0].iov_len, 64u);
+
+    EXPECT_EQ(SharedPayloadDataBlock::ReleaseSent(queue, 64), 0);
+    EXPECT_TRUE(queue.is_empty());
+    EXPECT_EQ(payload.use_count(), 1);
+}
+
+TEST(SharedPayloadDataBlockTest, QueuedPayloadOutlivesTheBroadcast)
+{
+    MessageQueue queue;
+    {
+        std::shared_ptr<WorldPacket const> payload = MakePayload(0x96, 2048);
+        queue.enqueue_tail(MakeMessage("hdr1", payload), (ACE_Time_Value*) &ACE_Time_Value::zero);
+    }
+
+    EXPECT_EQ(SharedPayloadDataBlock::ReleaseSent(queue, 4), 0);
+
+    iovec iov[8];
+    ASSERT_EQ(SharedPayloadDataBlock::Gather(queue, iov, 8), 1);
+    ASSERT_EQ(iov[0].iov_len, 2048u);
+    for (uint32 i = 0; i < 2048; ++i)
+        ASSERT_EQ(uint8(((char const*)iov[0].iov_base)[i]), uint8(i));
+
+    EXPECT_EQ(SharedPayloadDataBlock::ReleaseSent(queue, 2048), 0);
+    EXPECT_TRUE(queue.is_empty());
+}
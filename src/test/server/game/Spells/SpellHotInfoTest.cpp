@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "DBCStructure.h"
+#include "SpellInfo.h"
+#include "Timer.h"
+#include "gtest/gtest.h"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 SPELL_COUNT = 50000;                   // about the rows of the 3.3.5a Spell.dbc
+
+    // Spells without DBC indexes, so SpellInfo is built without the other stores
+    std::vector<SpellEntry> MakeSpellEntries()
+    {
+        std::mt19937 rng(34);
+        std::vector<SpellEntry> entries(SPELL_COUNT);
+        for (uint32 i = 0; i < SPELL_COUNT; ++i)
+        {
+            SpellEntry& entry = entries[i];
+            memset(&entry, 0, sizeof(SpellEntry));
+            entry.Id = i;
+            entry.Attributes = rng() & rng();
+            entry.AttributesEx = rng() & rng();
+            entry.AttributesEx3 = rng() & rng();
+            entry.ProcFlags = rng() & rng();
+            entry.Dispel = rng() % 10;
+            entry.Mechanic = rng() % 32;
+            entry.SchoolMask = 1 << (rng() % MAX_SPELL_SCHOOL);
+            entry.DmgClass = rng() % 4;
+            entry.SpellFamilyName = rng() % 18;
+            entry.SpellFamilyFlags = flag96(rng(), rng(), rng());
+            entry.Effect[0] = SPELL_EFFECT_APPLY_AURA;
+            entry.EffectApplyAuraName[0] = rng() % 2 ? SPELL_AURA_PROC_TRIGGER_SPELL : SPELL_AURA_PERIODIC_DAMAGE;
+            entry.Effect[1] = rng() % 2 ? SPELL_EFFECT_SCHOOL_DAMAGE : 0;
+            entry.EffectApplyAuraName[1] = SPELL_AURA_MOD_STUN;     // not an aura effect
+        }
+        return entries;
+    }
+
+    // What a proc and a cast pass read of the spells they go through, the same on SpellInfo and SpellHotInfo
+    template<class T>
+    uint32 CheckSpell(T const& spell, flag96 const& familyMask)
+    {
+        uint32 result = 0;
+        if (spell.HasAttribute(SPELL_ATTR0_PASSIVE))
+            result += 1;
+        if (spell.HasAttribute(SPELL_ATTR0_CANT_USED_IN_COMBAT))
+            result += 2;
+        if (spell.GetSchoolMask() & SPELL_SCHOOL_MASK_MAGIC)
+            result += 4;
+        if (spell.SpellFamilyName == SPELLFAMILY_MAGE && (spell.SpellFamilyFlags & familyMask))
+            result += 8;
+        if (spell.DmgClass == SPELL_DAMAGE_CLASS_MAGIC && spell.HasAura(SPELL_AURA_PROC_TRIGGER_SPELL))
+            result += 16;
+        return result;
+    }
+
+    // most checks are for the spells of the current fights, spread over the whole table
+    std::vector<uint32> MakeCheckedSpells(uint32 checks)
+    {
+        std::mt19937 rng(7);
+        std::vector<uint32> ids(checks);
+        for (uint32 i = 0; i < checks; ++i)
+            ids[i] = (i % 5) ? (rng() % 2000) * (SPELL_COUNT / 2000) : rng() % SPELL_COUNT;
+        return ids;
+    }
+
+    template<class Check>
+    uint32 RunChecks(std::vector<uint32> const& ids, uint32& checksum, Check check)
+    {
+        flag96 familyMask(0x00000021, 0x00001000, 0);
+
+        uint32 start = getMSTime();
+        checksum = 0;
+        for (uint32 id : ids)
+            checksum += check(id, familyMask);
+        return GetMSTimeDiffToNow(start);
+    }
+}
+
+TEST(SpellHotInfoTest, MirrorsSpellInfo)
+{
+    std::vector<SpellEntry> entries = MakeSpellEntries();
+    flag96 familyMask(0x00000021, 0x00001000, 0);
+
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        SpellInfo spellInfo(&entries[i]);
+        spellInfo.AttributesCu = i;
+        SpellHotInfo hot(&spellInfo);
+
+        EXPECT_EQ(CheckSpell(hot, familyMask), CheckSpell(spellInfo, familyMask));
+        EXPECT_EQ(hot.HasAttribute(SPELL_ATTR1_DISMISS_PET), spellInfo.HasAttribute(SPELL_ATTR1_DISMISS_PET));
+        EXPECT_EQ(hot.HasAttribute(SPELL_ATTR3_BATTLEGROUND), spellInfo.HasAttribute(SPELL_ATTR3_BATTLEGROUND));
+        EXPECT_EQ(hot.HasAttribute(SPELL_ATTR0_CU_DIRECT_DAMAGE), spellInfo.HasAttribute(SPELL_ATTR0_CU_DIRECT_DAMAGE));
+        EXPECT_EQ(hot.ProcFlags, spellInfo.ProcFlags);
+        EXPECT_EQ(hot.Dispel, spellInfo.Dispel);
+        EXPECT_EQ(hot.Mechanic, spellInfo.Mechanic);
+        EXPECT_EQ(hot.GetMaxRange(), 0.0f);
+
+        for (uint8 effIndex = 0; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
+            EXPECT_EQ(hot.IsEffect(effIndex), spellInfo.Effects[effIndex].IsEffect());
+        EXPECT_EQ(hot.HasAura(SPELL_AURA_PERIODIC_DAMAGE), spellInfo.HasAura(SPELL_AURA_PERIODIC_DAMAGE));
+        EXPECT_FALSE(hot.HasAura(SPELL_AURA_MOD_STUN));
+    }
+}
+
+/*
+ * Runs the same check mix on SpellInfo allocated one by one between other load allocations, on SpellInfo placed in
+ * one arena like SpellMgr::LoadSpellInfoStore does, and on the SpellHotInfo array of SpellMgr::LoadSpellHotInfo.
+ * The hot info is found from the place of the SpellInfo in the arena like SpellMgr::GetSpellHotInfo does, and through
+ * the id of the SpellInfo, which reads the SpellInfo again. Run it with --gtest_also_run_disabled_tests.
+ */
+TEST(SpellHotInfoTest, DISABLED_CastAndProcChecksBenchmark)
+{
+    constexpr uint32 CHECKS = 2000000;
+
+    std::vector<SpellEntry> entries = MakeSpellEntries();
+
+    std::mt19937 rng(1);
+    std::vector<std::unique_ptr<char[]>> otherAllocations;
+    std::vector<std::unique_ptr<SpellInfo>> heap;
+    for (SpellEntry const& entry : entries)
+    {
+        heap.emplace_back(new SpellInfo(&entry));
+        otherAllocations.emplace_back(new char[16 + rng() % 240]);
+    }
+
+    SpellInfo* arena = static_cast<SpellInfo*>(::operator new(SPELL_COUNT * sizeof(SpellInfo)));
+    std::vector<SpellInfo const*> arenaSpells;
+    std::vector<SpellHotInfo> hot(SPELL_COUNT);
+    for (uint32 i = 0; i < SPELL_COUNT; ++i)
+    {
+        arenaSpells.push_back(new (&arena[i]) SpellInfo(&entries[i]));
+        hot[i] = SpellHotInfo(arenaSpells[i]);
+    }
+
+    std::vector<uint32> ids = MakeCheckedSpells(CHECKS);
+    uint32 heapChecksum, arenaChecksum, hotChecksum, hotIdChecksum;
+    uint32 heapTime = RunChecks(ids, heapChecksum, [&](uint32 id, flag96 const& familyMask) { return CheckSpell(*heap[id], familyMask); });
+    uint32 arenaTime = RunChecks(ids, arenaChecksum, [&](uint32 id, flag96 const& familyMask) { return CheckSpell(*arenaSpells[id], familyMask); });
+    uint32 hotTime = RunChecks(ids, hotChecksum, [&](uint32 id, flag96 const& familyMask) { return CheckSpell(hot[arenaSpells[id] - arena], familyMask); });
+    uint32 hotIdTime = RunChecks(ids, hotIdChecksum, [&](uint32 id, flag96 const& familyMask) { return CheckSpell(hot[arenaSpells[id]->Id], familyMask); });
+    EXPECT_EQ(heapChecksum, arenaChecksum);
+    EXPECT_EQ(hotChecksum, arenaChecksum);
+    EXPECT_EQ(hotIdChecksum, arenaChecksum);
+
+    std::cout << "[ BENCHMARK ] " << CHECKS << " cast and proc checks over " << SPELL_COUNT << " spells (SpellInfo is " << sizeof(SpellInfo) << " bytes): "
+        << "one allocation each " << heapTime << " ms, arena " << arenaTime << " ms, hot info " << hotTime << " ms, hot info by spell id " << hotIdTime << " ms" << std::endl;
+
+    for (uint32 i = 0; i < SPELL_COUNT; ++i)
+        arena[i].~SpellInfo();
+    ::operator delete(arena);
+}